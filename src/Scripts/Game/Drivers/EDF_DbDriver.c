@@ -22,6 +22,321 @@ class EDF_DbDriver
 
 	//------------------------------------------------------------------------------------------------
 	void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null);
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Goes through FindByIds.
+	EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		if (!entityId)
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindByIds(entityType, {entityId});
+		if (!findResults.IsSuccess() || findResults.GetEntities().IsEmpty())
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(findResults.GetStatusCode());
+
+		return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, findResults.GetEntities().Get(0));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Uses an id condition and restores the input order.
+	EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		if (entityIds.IsEmpty())
+			return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, {});
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindAll(entityType, EDF_DbFind.Id().EqualsAnyOf(entityIds));
+		if (!findResults.IsSuccess())
+			return findResults;
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, EDF_DbEntityUtils.OrderByIds(findResults.GetEntities(), entityIds));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Materializes all matches once to count them.
+	EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindAll(entityType, condition);
+		if (!findResults.IsSuccess())
+			return new EDF_DbCountResult(findResults.GetStatusCode());
+
+		return new EDF_DbCountResult(EDF_EDbOperationStatusCode.SUCCESS, findResults.GetEntities().Count());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Materializes at most one match.
+	EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindAll(entityType, condition, limit: 1);
+		if (!findResults.IsSuccess())
+			return new EDF_DbExistsResult(findResults.GetStatusCode());
+
+		return new EDF_DbExistsResult(EDF_EDbOperationStatusCode.SUCCESS, !findResults.GetEntities().IsEmpty());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Materializes all matches once to aggregate them.
+	EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbAggregator aggregator(aggregation);
+		EDF_EDbOperationStatusCode statusCode = aggregator.Validate(entityType);
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			return new EDF_DbAggregateResult(statusCode);
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindAll(entityType, condition);
+		if (!findResults.IsSuccess())
+			return new EDF_DbAggregateResult(findResults.GetStatusCode());
+
+		foreach (EDF_DbEntity entity : findResults.GetEntities())
+		{
+			aggregator.Accumulate(entity);
+		}
+
+		return new EDF_DbAggregateResult(EDF_EDbOperationStatusCode.SUCCESS, aggregator.GetResults());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		if (!entityId)
+		{
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET, new array<ref EDF_DbEntity>());
+
+			return;
+		}
+
+		FindByIdsAsync(entityType, {entityId}, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		if (entityIds.IsEmpty())
+		{
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, new array<ref EDF_DbEntity>());
+
+			return;
+		}
+
+		FindAllAsync(entityType, EDF_DbFind.Id().EqualsAnyOf(entityIds), callback: new EDF_DbFindByIdsOrderCallback(entityIds, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		EDF_DbCountResult countResult = Count(entityType, condition);
+		if (callback)
+			callback.Invoke(countResult.GetStatusCode(), countResult.GetCount());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		EDF_DbExistsResult existsResult = Exists(entityType, condition);
+		if (callback)
+			callback.Invoke(existsResult.GetStatusCode(), existsResult.Exists());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		EDF_DbAggregateResult aggregateResult = Aggregate(entityType, aggregation, condition);
+		if (callback)
+			callback.Invoke(aggregateResult.GetStatusCode(), aggregateResult.GetGroups());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Saves one by one and reports the first failure.
+	EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+		foreach (EDF_DbEntity entity : entities)
+		{
+			EDF_EDbOperationStatusCode statusCode = AddOrUpdate(entity);
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS && result == EDF_EDbOperationStatusCode.SUCCESS)
+				result = statusCode;
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Removes one by one and reports the first failure.
+	EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+		foreach (string entityId : entityIds)
+		{
+			EDF_EDbOperationStatusCode statusCode = Remove(entityType, entityId);
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS && result == EDF_EDbOperationStatusCode.SUCCESS)
+				result = statusCode;
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Finds the matches once and removes them by id.
+	EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindAll(entityType, condition);
+		if (!findResults.IsSuccess())
+			return findResults.GetStatusCode();
+
+		array<string> entityIds();
+		foreach (EDF_DbEntity entity : findResults.GetEntities())
+		{
+			entityIds.Insert(entity.GetId());
+		}
+
+		return RemoveMany(entityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fallback for drivers without a native implementation. Loads the entity, applies the patch and saves it entirely.
+	//! The patch is only applied if the entity matches the optional condition.
+	//! Best-effort only: nothing in between the load and the save is guarded, writes from other processes to the same entity can be lost.
+	//! All built-in drivers override it, custom drivers backed by a shared database need to as well for Increment and CompareAndSet to be atomic.
+	EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		if (!entityId)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindAll(entityType, EDF_DbFind.Id().Equals(entityId), limit: 1);
+		if (!findResults.IsSuccess())
+			return findResults.GetStatusCode();
+
+		if (findResults.GetEntities().IsEmpty())
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
+
+		EDF_DbEntity entity = findResults.GetEntities().Get(0);
+		if (condition && !EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+			return EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET;
+
+		if (!patch.Apply(entity))
+			return EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED;
+
+		return AddOrUpdate(entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically add the delta to a numeric field of an existing entity
+	EDF_EDbOperationStatusCode Increment(typename entityType, string entityId, string fieldPath, int delta)
+	{
+		return Patch(entityType, entityId, EDF_DbPatch.Create().Increment(fieldPath, delta));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically add the delta to a numeric field of an existing entity
+	EDF_EDbOperationStatusCode Increment(typename entityType, string entityId, string fieldPath, float delta)
+	{
+		return Patch(entityType, entityId, EDF_DbPatch.Create().Increment(fieldPath, delta));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity only if it still has the expected value. Fails with FAILURE_CONDITION_NOT_MET otherwise.
+	EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, int expectedValue, int newValue)
+	{
+		return Patch(entityType, entityId, EDF_DbPatch.Create().Set(fieldPath, newValue), EDF_DbFind.Field(fieldPath).Equals(expectedValue));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity only if it still has the expected value. Fails with FAILURE_CONDITION_NOT_MET otherwise.
+	EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, bool expectedValue, bool newValue)
+	{
+		return Patch(entityType, entityId, EDF_DbPatch.Create().Set(fieldPath, newValue), EDF_DbFind.Field(fieldPath).Equals(expectedValue));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity only if it still has the expected value. Fails with FAILURE_CONDITION_NOT_MET otherwise.
+	EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, string expectedValue, string newValue)
+	{
+		return Patch(entityType, entityId, EDF_DbPatch.Create().Set(fieldPath, newValue), EDF_DbFind.Field(fieldPath).Equals(expectedValue));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_DbOperationStatusMultiCallback multiCallback(entities.Count(), callback);
+		foreach (EDF_DbEntity entity : entities)
+		{
+			AddOrUpdateAsync(entity, multiCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_DbOperationStatusMultiCallback multiCallback(entityIds.Count(), callback);
+		foreach (string entityId : entityIds)
+		{
+			RemoveAsync(entityType, entityId, multiCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = Patch(entityType, entityId, patch, condition);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void IncrementAsync(typename entityType, string entityId, string fieldPath, int delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		PatchAsync(entityType, entityId, EDF_DbPatch.Create().Increment(fieldPath, delta), callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void IncrementAsync(typename entityType, string entityId, string fieldPath, float delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		PatchAsync(entityType, entityId, EDF_DbPatch.Create().Increment(fieldPath, delta), callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, int expectedValue, int newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		PatchAsync(entityType, entityId, EDF_DbPatch.Create().Set(fieldPath, newValue), callback, EDF_DbFind.Field(fieldPath).Equals(expectedValue));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, bool expectedValue, bool newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		PatchAsync(entityType, entityId, EDF_DbPatch.Create().Set(fieldPath, newValue), callback, EDF_DbFind.Field(fieldPath).Equals(expectedValue));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, string expectedValue, string newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		PatchAsync(entityType, entityId, EDF_DbPatch.Create().Set(fieldPath, newValue), callback, EDF_DbFind.Field(fieldPath).Equals(expectedValue));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = RemoveWhere(entityType, condition);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Amount of writes held back by the driver that still need to be drained, see EDF_DbShutdownFlush
+	int GetShutdownPendingCount()
+	{
+		return 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pass on the next held back writes without blocking. Called once per frame during the shutdown flush.
+	//! \param maxConcurrency max. batch requests in flight
+	//! \param batchSize max. entities per batch request
+	void DrainShutdown(int maxConcurrency, int batchSize);
+
+	//------------------------------------------------------------------------------------------------
+	//! Write everything still held back blocking. Called once the shutdown flush deadline passed.
+	void HardFlushShutdown();
 };
 
 class EDF_DbDriverName
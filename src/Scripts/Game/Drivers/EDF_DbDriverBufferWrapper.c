@@ -1,684 +1,1050 @@
-/*
-overall goal:
-				- not query records we have the latest info for or that are deleted
-				- be able to return results for stuff that was not yet flushed to db
+//! Pending changes of one entity type that were not yet confirmed as written by the wrapped driver.
+//! Entries stay in here while a flush is in flight, so reads always see the latest local state.
+class EDF_DbDriverBufferWrapperTypeBuffer
+{
+	protected ref array<ref EDF_DbEntity> m_aUpdates = {}; // Insertion ordered, null for entries that were removed or flushed
+	protected ref map<string, int> m_mUpdateIndices = new map<string, int>();
+	protected ref set<string> m_aRemovals = new set<string>();
+
+	int m_iFlushing;
+
+	//------------------------------------------------------------------------------------------------
+	void SetUpdate(notnull EDF_DbEntity entity)
+	{
+		string entityId = entity.GetId();
+		m_aRemovals.RemoveItem(entityId);
+
+		int updateIdx;
+		if (m_mUpdateIndices.Find(entityId, updateIdx))
+		{
+			m_aUpdates.Set(updateIdx, entity);
+			return;
+		}
+
+		m_mUpdateIndices.Set(entityId, m_aUpdates.Insert(entity));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void SetRemoved(string entityId)
+	{
+		int updateIdx;
+		if (m_mUpdateIndices.Find(entityId, updateIdx))
+		{
+			m_aUpdates.Set(updateIdx, null);
+			m_mUpdateIndices.Remove(entityId);
+		}
+
+		if (!m_aRemovals.Contains(entityId))
+			m_aRemovals.Insert(entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return true if there is a pending update or removal for the id
+	bool Contains(string entityId)
+	{
+		return m_mUpdateIndices.Contains(entityId) || m_aRemovals.Contains(entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Buffered instance of the entity. Do not modify it, use SetUpdate with a copy instead.
+	EDF_DbEntity GetUpdate(string entityId)
+	{
+		int updateIdx;
+		if (m_mUpdateIndices.Find(entityId, updateIdx))
+			return m_aUpdates.Get(updateIdx);
+
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	array<ref EDF_DbEntity> GetUpdates()
+	{
+		array<ref EDF_DbEntity> updates();
+		updates.Reserve(m_mUpdateIndices.Count());
+		foreach (EDF_DbEntity entity : m_aUpdates)
+		{
+			if (entity)
+				updates.Insert(entity);
+		}
+
+		return updates;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	array<string> GetRemovals()
+	{
+		array<string> removals();
+		removals.Reserve(m_aRemovals.Count());
+		foreach (string entityId : m_aRemovals)
+		{
+			removals.Insert(entityId);
+		}
+
+		return removals;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Ids of all pending updates and removals
+	array<string> GetPendingIds()
+	{
+		array<string> pendingIds = GetRemovals();
+		pendingIds.Reserve(pendingIds.Count() + m_mUpdateIndices.Count());
+		foreach (EDF_DbEntity entity : m_aUpdates)
+		{
+			if (entity)
+				pendingIds.Insert(entity.GetId());
+		}
+
+		return pendingIds;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetPendingCount()
+	{
+		return m_mUpdateIndices.Count() + m_aRemovals.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsEmpty()
+	{
+		return m_mUpdateIndices.IsEmpty() && m_aRemovals.IsEmpty();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Drop flushed updates, unless they were replaced by a newer change in the meantime
+	void ReleaseUpdates(notnull array<ref EDF_DbEntity> flushedEntities)
+	{
+		foreach (EDF_DbEntity entity : flushedEntities)
+		{
+			string entityId = entity.GetId();
+			int updateIdx;
+			if (!m_mUpdateIndices.Find(entityId, updateIdx) || m_aUpdates.Get(updateIdx) != entity)
+				continue;
 
-Or(
-				Id().EqualsAnyOf({..., xxxxxx-xxxxx-xxxxx, ...}),
-				And(
-								Field("something").GreaterThan(5),
-								Id().Equals("xxxxx-xxxx-xxxxx")
-				)
-)
+			m_aUpdates.Set(updateIdx, null);
+			m_mUpdateIndices.Remove(entityId);
+		}
 
----
+		if (m_mUpdateIndices.IsEmpty())
+			m_aUpdates.Clear();
+	}
 
->>> Id().EqualsAnyOf({..., xxxxxx-xxxxx-xxxxx, known-id-from-cache}),
+	//------------------------------------------------------------------------------------------------
+	void ReleaseRemovals(notnull array<string> flushedIds)
+	{
+		foreach (string entityId : flushedIds)
+		{
+			m_aRemovals.RemoveItem(entityId);
+		}
+	}
 
-And(
-				Id().EqualsAnyOf({..., xxxxxx-xxxxx-xxxxx, known-id-from-cache}),
-				Id().Not().EqualsAnyOf({xxxxxx-xxxxx-xxxxx, known-id-from-cache}),
-)
+	//------------------------------------------------------------------------------------------------
+	//! Pending updates that match the condition, in the order they were buffered
+	array<ref EDF_DbEntity> GetMatchingUpdates(EDF_DbFindCondition condition)
+	{
+		array<ref EDF_DbEntity> matches();
+		foreach (EDF_DbEntity entity : m_aUpdates)
+		{
+			if (entity && (!condition || EDF_DbFindConditionEvaluator.Evaluate(entity, condition)))
+				matches.Insert(entity);
+		}
+
+		return matches;
+	}
 
-----
+	//------------------------------------------------------------------------------------------------
+	//! Combine the results of a driver query that was requested with GetDriverLimit() and offset 0 with the pending changes.
+	array<ref EDF_DbEntity> MergeFindResults(
+		notnull array<ref EDF_DbEntity> driverResults,
+		EDF_DbFindCondition condition,
+		array<ref TStringArray> orderBy,
+		int limit,
+		int offset)
+	{
+		array<ref EDF_DbEntity> matchingUpdates = GetMatchingUpdates(condition);
 
-not() does not matter, won't affect our cache in any way?
+		array<ref EDF_DbEntity> merged();
+		merged.Reserve(driverResults.Count() + matchingUpdates.Count());
 
-if id equals as part of OR remove the entry. (bonus to reduce or to just the single statement later)
-Or(
-				And(
-								Field("something").GreaterThan(5),
-								Id().Equals("xxxx-xxxx-xxxx")
-				),
-				And(
-								Field("something").GreaterThan(7),
-								Id().EqualsAnyOf("yyyy-yyyy-yyyy", "zzzz-zzzz-zzzz")
-				),
-)
+		// Driver results can be outdated or already removed if there is a pending change for them
+		foreach (EDF_DbEntity entity : driverResults)
+		{
+			if (!Contains(entity.GetId()))
+				merged.Insert(entity);
+		}
 
-if id as part of And
-				1. if that id is removed, delete whole And(), can never return anything.
-				2. id is something we updated, then apply the condition onto the db entity. if success evalute entity directly or just let query pass?!?
-								-> just count it as not id only, and let it run though in memory and then real driver with not(deleted, updated) extra clause.
+		foreach (EDF_DbEntity entity : matchingUpdates)
+		{
+			merged.Insert(EDF_DbEntityUtils.DeepCopy(entity));
+		}
 
-----
+		if (orderBy)
+			merged = EDF_DbEntitySorter.GetSorted(merged, orderBy);
 
-1. remove any id conditions for already removed entries
-				-> recurse, all by id, remove ids that are removed.
-								-> if empty remove condition
+		if (limit == -1 && offset <= 0)
+			return merged;
 
-2. check if id only query
-				-> if yes, grab queried ids and answer all results we know from memory
-								-> if there are any ids we do not know, go to actual driver to retrieve
-				-> if by other field do driver query, then also do memory query for that entitytype
-								-> add condition that the result is none of the removed or yet pending update ids (this way no outdated info we already know will be flushed away is returned from driver)
-								-> replace driver results with any matching ids from memory results
-								-> remove any results that are already deleted
+		array<ref EDF_DbEntity> resultEntities();
+		foreach (int idx, EDF_DbEntity entity : merged)
+		{
+			// Respect output limit is specified
+			if (limit != -1 && resultEntities.Count() >= limit)
+				break;
 
+			// Skip the first n records if offset specified (for paginated loading together with limit)
+			if (offset != -1 && idx < offset)
+				continue;
 
+			resultEntities.Insert(entity);
+		}
 
-ways to still fix this "broken" concept:
+		return resultEntities;
+	}
 
-- if limit or offset, send original condition and post process order and limit and replace and remove entires
-				.... except I still need to add new records ... so how do they know where to go ...
+	//------------------------------------------------------------------------------------------------
+	//! Copy of the pending changes as they are now. The buffered entities are shared, they are never modified.
+	EDF_DbDriverBufferWrapperTypeBuffer Snapshot()
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer snapshot();
+		foreach (EDF_DbEntity entity : m_aUpdates)
+		{
+			if (entity)
+				snapshot.SetUpdate(entity);
+		}
 
-- dumb query everything from memory and then from driver, and then replace and remove results
+		foreach (string entityId : m_aRemovals)
+		{
+			snapshot.m_aRemovals.Insert(entityId);
+		}
 
-- Get all from dB, no sort. Add in memory, then sort and apply limits and offset ... Again I need to know total count of collection. Count could change in dB without game knowing ...
+		return snapshot;
+	}
 
-- Another possibility is to flush all pending changes before a complex query and then just sent to to dB. Can saving there cause inconsistencies? Maybe not if flush all changes and not just current entity type?
+	//------------------------------------------------------------------------------------------------
+	//! Limit to request from the driver so that after dropping all pending ids there are still enough results for offset + limit
+	int GetDriverLimit(int limit, int offset)
+	{
+		if (limit == -1)
+			return -1;
 
-*/
+		return Math.Max(offset, 0) + limit + GetPendingCount();
+	}
+};
 
-/*
+//! Answers all reads with pending changes overlaid, writes are queued until Flush() passes them on to the wrapped driver in batches.
+//! Queries for types with pending changes are sent to the driver with a widened limit and without offset so that pending
+//! updates and removals can be merged in before orderBy, limit and offset are applied to the combined results.
 class EDF_DbDriverBufferWrapper : EDF_DbDriver
 {
 	protected ref EDF_DbDriver m_pDriver;
+	protected ref map<typename, ref EDF_DbDriverBufferWrapperTypeBuffer> m_mBuffers;
+	protected ref EDF_DbFlushScheduler m_pFlushScheduler;
+	protected ref array<ref EDF_DbDriverBufferWrapperFlushJob> m_aFlushJobs;
+	protected bool m_bFlushTickActive;
+	protected bool m_bFlushRequested;
 
-	protected ref map<string, int> m_mRemoveBufferIndices;
-	protected ref map<typename, ref array<string>> m_mRemoveBufferIds;
-	protected ref map<typename, ref array<bool>> m_mRemoveBufferAsync;
-
-	protected ref map<string, int> m_mAddOrUpdateBufferIndices;
-	protected ref map<typename, ref array<string>> m_mAddOrUpdateBufferIds;
-	protected ref map<typename, ref array<bool>> m_mAddOrUpdateBufferAsync;
-	protected ref map<typename, ref array<ref EDF_DbEntity>> m_mAddOrUpdateBufferEntities;
-
-	protected bool m_bFlushActive;
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		return m_pDriver.Initialize(connectionInfo);
+	}
 
 	//------------------------------------------------------------------------------------------------
 	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
 	{
-		return AddOrUpdate(entity, false);
+		if (!entity.HasId())
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		// Keep a copy so changes on the instance after this call are not written implicitly
+		GetOrCreateBuffer(entity.Type()).SetUpdate(EDF_DbEntityUtils.DeepCopy(entity));
+		return EDF_EDbOperationStatusCode.SUCCESS;
 	}
 
 	//------------------------------------------------------------------------------------------------
 	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
 	{
-		return Remove(entityType, entityId, false);
+		if (!entityId)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		GetOrCreateBuffer(entityType).SetRemoved(entityId);
+		return EDF_EDbOperationStatusCode.SUCCESS;
 	}
 
 	//------------------------------------------------------------------------------------------------
 	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
 	{
-		return FindAllFromBuffer(entityType, condition, orderBy, limit, offset, false, null);
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
+			return m_pDriver.FindAll(entityType, condition, orderBy, limit, offset);
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = m_pDriver.FindAll(entityType, condition, orderBy, buffer.GetDriverLimit(limit, offset));
+		if (!findResults.IsSuccess())
+			return findResults;
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(
+			EDF_EDbOperationStatusCode.SUCCESS,
+			buffer.MergeFindResults(findResults.GetEntities(), condition, orderBy, limit, offset));
 	}
 
 	//------------------------------------------------------------------------------------------------
-	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
 	{
-		AddOrUpdate(entity, true);
-		if (callback)
-			callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS);
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer || !buffer.Contains(entityId))
+			return m_pDriver.FindById(entityType, entityId);
+
+		return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, EDF_DbEntityUtils.DeepCopy(buffer.GetUpdate(entityId)));
 	}
 
 	//------------------------------------------------------------------------------------------------
-	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
 	{
-		Remove(entityType, entityId, true);
-		if (callback)
-			callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS);
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
+			return m_pDriver.FindByIds(entityType, entityIds);
+
+		array<string> driverIds();
+		array<ref EDF_DbEntity> bufferedResults = CollectBufferedResults(buffer, entityIds, driverIds);
+		if (driverIds.IsEmpty())
+			return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, EDF_DbEntityUtils.OrderByIds(bufferedResults, entityIds));
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = m_pDriver.FindByIds(entityType, driverIds);
+		if (!findResults.IsSuccess())
+			return findResults;
+
+		foreach (EDF_DbEntity entity : findResults.GetEntities())
+		{
+			bufferedResults.Insert(entity);
+		}
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, EDF_DbEntityUtils.OrderByIds(bufferedResults, entityIds));
 	}
 
 	//------------------------------------------------------------------------------------------------
-	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
 	{
-		FindAllFromBuffer(entityType, condition, orderBy, limit, offset, true, callback);
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
+			return m_pDriver.Count(entityType, condition);
+
+		EDF_DbCountResult countResult = m_pDriver.Count(entityType, ExcludePending(buffer, condition));
+		if (!countResult.IsSuccess())
+			return countResult;
+
+		return new EDF_DbCountResult(EDF_EDbOperationStatusCode.SUCCESS, countResult.GetCount() + buffer.GetMatchingUpdates(condition).Count());
 	}
 
 	//------------------------------------------------------------------------------------------------
-	void Flush(int maxBatchSize = 50, bool forceBlocking = false)
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
 	{
-		if (m_bFlushActive)
-			return;
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
+			return m_pDriver.Exists(entityType, condition);
+
+		if (!buffer.GetMatchingUpdates(condition).IsEmpty())
+			return new EDF_DbExistsResult(EDF_EDbOperationStatusCode.SUCCESS, true);
+
+		return m_pDriver.Exists(entityType, ExcludePending(buffer, condition));
+	}
 
-		m_bFlushActive = true;
-		if (!s_bForceBlocking && !forceBlocking)
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		if (!GetPendingBuffer(entityType))
+			return m_pDriver.Aggregate(entityType, aggregation, condition);
+
+		// Aggregate the merged results locally
+		return super.Aggregate(entityType, aggregation, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		foreach (EDF_DbEntity entity : entities)
 		{
-			thread FlushTick(maxBatchSize);
+			if (!entity.HasId())
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
 		}
-		else
+
+		foreach (EDF_DbEntity entity : entities)
 		{
-			FlushTick(maxBatchSize, true);
+			GetOrCreateBuffer(entity.Type()).SetUpdate(EDF_DbEntityUtils.DeepCopy(entity));
 		}
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	protected void FlushTick(int maxBatchSize, bool forceBlocking = false)
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
 	{
-		int operation;
+		foreach (string entityId : entityIds)
+		{
+			if (!entityId)
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+		}
 
-		foreach (typename entityType, array<string> ids : m_mRemoveBufferIds)
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetOrCreateBuffer(entityType);
+		foreach (string entityId : entityIds)
 		{
-			array<bool> asyncArray = m_mRemoveBufferAsync.Get(entityType);
+			buffer.SetRemoved(entityId);
+		}
 
-			foreach (int idx, string id : ids)
-			{
-				if (!id)
-					continue;
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
 
-				if (asyncArray.Get(idx))
-				{
-					m_pDriver.RemoveAsync(entityType, id);
-				}
-				else
-				{
-					m_pDriver.Remove(entityType, id);
-				}
+	//------------------------------------------------------------------------------------------------
+	//! Not buffered. Pending updates that match are marked as removed and the rest is removed by the driver right away.
+	//! Pending updates that no longer match are written again on the next flush.
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		RemoveMatchingUpdates(entityType, condition);
+		return m_pDriver.RemoveWhere(entityType, condition);
+	}
 
-				if ((++operation % maxBatchSize == 0) && !forceBlocking)
-					Sleep(100);
-			}
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer || !buffer.Contains(entityId))
+			return m_pDriver.Patch(entityType, entityId, patch, condition);
+
+		return PatchBuffered(buffer, entityId, patch, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = AddOrUpdate(entity);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = Remove(entityType, entityId);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
+		{
+			m_pDriver.FindAllAsync(entityType, condition, orderBy, limit, offset, callback);
+			return;
 		}
 
-		m_mRemoveBufferIds.Clear();
-		m_mRemoveBufferAsync.Clear();
-		m_mRemoveBufferIndices.Clear();
+		// Merged with the pending changes the driver limit was widened for. A flush confirmed while the
+		// query is in flight would otherwise drop entities the driver did not have yet when it was queried.
+		EDF_DbDriverBufferWrapperTypeBuffer snapshot = buffer.Snapshot();
+		EDF_DbDriverBufferWrapperFindAllCallback mergeCallback(snapshot, condition, orderBy, limit, offset, callback);
+		m_pDriver.FindAllAsync(entityType, condition, orderBy, snapshot.GetDriverLimit(limit, offset), callback: mergeCallback);
+	}
 
-		foreach (typename entityType, array<ref EDF_DbEntity> entities : m_mAddOrUpdateBufferEntities)
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer || !buffer.Contains(entityId))
 		{
-			array<bool> asyncArray = m_mAddOrUpdateBufferAsync.Get(entityType);
+			m_pDriver.FindByIdAsync(entityType, entityId, callback);
+			return;
+		}
 
-			foreach (int idx, EDF_DbEntity entity : entities)
-			{
-				if (!entity)
-					continue;
+		if (!callback)
+			return;
 
-				if (asyncArray.Get(idx))
-				{
-					m_pDriver.AddOrUpdateAsync(entity);
-				}
-				else
-				{
-					m_pDriver.AddOrUpdate(entity);
-				}
+		array<ref EDF_DbEntity> resultEntities();
+		EDF_DbEntity entity = buffer.GetUpdate(entityId);
+		if (entity)
+			resultEntities.Insert(EDF_DbEntityUtils.DeepCopy(entity));
 
-				if ((++operation % maxBatchSize == 0) && !forceBlocking)
-					Sleep(100);
-			}
+		callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, resultEntities);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
+		{
+			m_pDriver.FindByIdsAsync(entityType, entityIds, callback);
+			return;
 		}
 
-		m_mAddOrUpdateBufferIds.Clear();
-		m_mAddOrUpdateBufferAsync.Clear();
-		m_mAddOrUpdateBufferIndices.Clear();
-		m_mAddOrUpdateBufferEntities.Clear();
+		array<string> driverIds();
+		array<ref EDF_DbEntity> bufferedResults = CollectBufferedResults(buffer, entityIds, driverIds);
+		EDF_DbDriverBufferWrapperFindByIdsCallback mergeCallback(bufferedResults, entityIds, callback);
+		if (driverIds.IsEmpty())
+		{
+			mergeCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, new array<ref EDF_DbEntity>());
+			return;
+		}
 
-		m_bFlushActive = false;
+		m_pDriver.FindByIdsAsync(entityType, driverIds, mergeCallback);
 	}
 
 	//------------------------------------------------------------------------------------------------
-	protected EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity, bool async)
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
 	{
-		string id = entity.GetId();
-		typename entityType = entity.Type();
-
-		int removeIdx;
-		if (m_mRemoveBufferIndices.Find(id, removeIdx))
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
 		{
-			m_mRemoveBufferIds.Get(entityType).Set(removeIdx, string.Empty);
-			m_mRemoveBufferIndices.Remove(id);
+			m_pDriver.CountAsync(entityType, condition, callback);
+			return;
 		}
 
-		int addIdx;
-		if (m_mAddOrUpdateBufferIndices.Find(id, addIdx))
+		int bufferedCount = buffer.GetMatchingUpdates(condition).Count();
+		m_pDriver.CountAsync(entityType, ExcludePending(buffer, condition), new EDF_DbDriverBufferWrapperCountCallback(bufferedCount, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
 		{
-			// Replace existing entry
-			m_mAddOrUpdateBufferEntities.Get(entityType).Set(addIdx, entity);
-			m_mAddOrUpdateBufferAsync.Get(entityType).Set(addIdx, async);
+			m_pDriver.ExistsAsync(entityType, condition, callback);
+			return;
 		}
-		else
+
+		if (!buffer.GetMatchingUpdates(condition).IsEmpty())
 		{
-			array<ref EDF_DbEntity> entities = m_mAddOrUpdateBufferEntities.Get(entityType);
-			if (!entities)
-			{
-				entities = {};
-				m_mAddOrUpdateBufferEntities.Set(entityType, entities);
-			}
-			addIdx = entities.Insert(entity);
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, true);
 
-			array<bool> asyncBuffer = m_mAddOrUpdateBufferAsync.Get(entityType);
-			if (!asyncBuffer)
-			{
-				asyncBuffer = {};
-				m_mAddOrUpdateBufferAsync.Set(entityType, asyncBuffer);
-			}
-			if (addIdx >= asyncBuffer.Count())
-				asyncBuffer.Resize(addIdx + 1);
+			return;
+		}
 
-			asyncBuffer.Set(addIdx, async);
+		m_pDriver.ExistsAsync(entityType, ExcludePending(buffer, condition), callback);
+	}
 
-			array<string> ids = m_mAddOrUpdateBufferIds.Get(entityType);
-			if (!ids)
-			{
-				ids = {};
-				m_mAddOrUpdateBufferIds.Set(entityType, ids);
-			}
-			if (addIdx >= ids.Count())
-				ids.Resize(addIdx + 1);
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		if (!GetPendingBuffer(entityType))
+		{
+			m_pDriver.AggregateAsync(entityType, aggregation, condition, callback);
+			return;
+		}
 
-			ids.Set(addIdx, id);
+		super.AggregateAsync(entityType, aggregation, condition, callback);
+	}
 
-			m_mAddOrUpdateBufferIndices.Set(id, addIdx);
-		}
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = AddOrUpdateMany(entities);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
 
-		return EDF_EDbOperationStatusCode.SUCCESS;
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = RemoveMany(entityType, entityIds);
+		if (callback)
+			callback.Invoke(statusCode);
 	}
 
 	//------------------------------------------------------------------------------------------------
-	protected EDF_EDbOperationStatusCode Remove(typename entityType, string entityId, bool async)
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
 	{
-		int addIdx;
-		if (m_mAddOrUpdateBufferIndices.Find(entityId, addIdx))
+		RemoveMatchingUpdates(entityType, condition);
+		m_pDriver.RemoveWhereAsync(entityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer || !buffer.Contains(entityId))
 		{
-			m_mAddOrUpdateBufferEntities.Get(entityType).Set(addIdx, null);
-			m_mAddOrUpdateBufferIndices.Remove(entityId);
+			m_pDriver.PatchAsync(entityType, entityId, patch, callback, condition);
+			return;
 		}
 
-		int removeIdx;
-		if (!m_mRemoveBufferIndices.Find(entityId, removeIdx))
+		EDF_EDbOperationStatusCode statusCode = PatchBuffered(buffer, entityId, patch, condition);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pass all pending changes on to the wrapped driver. Changes stay visible from the buffer until the driver confirmed them.
+	//! Non-blocking flushes are spread across frames within the time budget of the flush scheduler, see GetFlushScheduler().
+	//! Calling it while a non-blocking flush is running sends the changes made since once that flush was confirmed.
+	//! \param forceBlocking use the sync driver api and return once everything was written
+	void Flush(bool forceBlocking = false)
+	{
+		if (forceBlocking || s_bForceBlocking)
 		{
-			array<string> removals = m_mRemoveBufferIds.Get(entityType);
-			if (!removals)
-			{
-				removals = {};
-				m_mRemoveBufferIds.Set(entityType, removals);
-			}
-			removeIdx = removals.Insert(entityId);
+			// Takes over whatever a running non-blocking flush did not send yet
+			StopFlushTick();
 
-			array<bool> asyncBuffer = m_mRemoveBufferAsync.Get(entityType);
-			if (!asyncBuffer)
+			int maxBatchSize = m_pFlushScheduler.GetMaxBatchSize();
+			foreach (EDF_DbDriverBufferWrapperFlushJob job : CreateFlushJobs())
 			{
-				asyncBuffer = {};
-				m_mRemoveBufferAsync.Set(entityType, asyncBuffer);
+				while (!job.IsDone())
+				{
+					SendFlushBatch(job, maxBatchSize, true);
+				}
 			}
-			if (removeIdx >= asyncBuffer.Count())
-				asyncBuffer.Resize(removeIdx + 1);
 
-			asyncBuffer.Set(removeIdx, async);
+			return;
+		}
 
-			m_mRemoveBufferIndices.Set(entityId, removeIdx);
+		// Sent by the flush tick once the running flush was confirmed, see FlushTick()
+		if (IsFlushing())
+		{
+			m_bFlushRequested = true;
+			StartFlushTick();
+			return;
 		}
 
-		return EDF_EDbOperationStatusCode.SUCCESS;
+		m_aFlushJobs = CreateFlushJobs();
+		if (m_aFlushJobs.IsEmpty())
+			return;
+
+		StartFlushTick();
 	}
 
 	//------------------------------------------------------------------------------------------------
-	protected EDF_DbFindResultMultiple<EDF_DbEntity> FindAllFromBuffer(
-		typename entityType,
-		EDF_DbFindCondition condition,
-		array<ref TStringArray> orderBy,
-		int limit,
-		int offset,
-		bool async,
-		EDF_DbFindCallbackBase callback)
+	//! Frame budget, batch sizes and per type priorities of non-blocking flushes
+	EDF_DbFlushScheduler GetFlushScheduler()
 	{
-		array<string> removedIds = m_mRemoveBufferIds.Get(entityType);
-		array<ref EDF_DbEntity> entities = m_mAddOrUpdateBufferEntities.Get(entityType);
+		return m_pFlushScheduler;
+	}
 
-		array<ref EDF_DbEntity> bufferedResults();
-		EDF_DbFindCondition processedCondition = condition;
+	//------------------------------------------------------------------------------------------------
+	//! \return true while a non-blocking flush is still sending or waiting for driver confirmations
+	bool IsFlushing()
+	{
+		return m_bFlushTickActive || HasBatchesInFlight();
+	}
 
-		array<ref TStringArray> orderByDriver = orderBy;
+	//------------------------------------------------------------------------------------------------
+	//! \return true while sent batches were not yet confirmed by the driver
+	protected bool HasBatchesInFlight()
+	{
+		foreach (typename entityType, EDF_DbDriverBufferWrapperTypeBuffer buffer : m_mBuffers)
+		{
+			if (buffer.m_iFlushing > 0)
+				return true;
+		}
 
-		int driverLimit = limit;
-		int driverOffset = offset;
-		int compenstatedOffset = offset;
+		return false;
+	}
 
-		if (removedIds || entities)
+	//------------------------------------------------------------------------------------------------
+	//! \return amount of buffered updates and removals across all entity types
+	int GetPendingCount()
+	{
+		int pendingCount;
+		foreach (typename entityType, EDF_DbDriverBufferWrapperTypeBuffer buffer : m_mBuffers)
 		{
-			array<string> queriedIds();
-			bool boolComplexCondition;
-			processedCondition = ProcessCondition(entityType, condition, false, queriedIds, boolComplexCondition);
+			pendingCount += buffer.GetPendingCount();
+		}
 
-			if (!boolComplexCondition && condition)
-			{
-				// go to cache and get ids
-				array<string> fromDriver();
-				foreach (string id : queriedIds)
-				{
-					int addIdx
-					if (m_mAddOrUpdateBufferIndices.Find(id, addIdx))
-					{
-						bufferedResults.Insert(entities.Get(addIdx));
-						continue;
-					}
-
-					fromDriver.Insert(id);
-				}
+		return pendingCount;
+	}
 
-				// all missing ids combine into new condition and send to driver
-				if (!fromDriver.IsEmpty())
-					processedCondition = EDF_DbFind.Id().EqualsAnyOf(fromDriver);
+	//------------------------------------------------------------------------------------------------
+	override int GetShutdownPendingCount()
+	{
+		return GetPendingCount();
+	}
 
-				// -> pre results + further query (maybe)
-			}
-			else if (entities)
-			{
-				// do broad in memory search with this condition on add or update
-				if (processedCondition)
-					entities = EDF_DbFindConditionEvaluator.GetFiltered(entities, processedCondition);
+	//------------------------------------------------------------------------------------------------
+	override void DrainShutdown(int maxConcurrency, int batchSize)
+	{
+		// The frame budget of the flush scheduler already limits how much is sent per frame
+		if (!IsFlushing() && GetPendingCount() > 0)
+			Flush();
+	}
 
-				// Add exclusion for known removed and alraedy retrieved results
-				array<string> alreadyKnown();
-				if (removedIds)
-					alreadyKnown.Copy(removedIds);
+	//------------------------------------------------------------------------------------------------
+	override void HardFlushShutdown()
+	{
+		Flush(forceBlocking: true);
+	}
 
-				alreadyKnown.Reserve(alreadyKnown.Count() + entities.Count());
+	//------------------------------------------------------------------------------------------------
+	protected void FlushTick()
+	{
+		// A flush requested while the last one was running waits for its confirmations, as unconfirmed changes are still pending and would be sent twice
+		if (m_aFlushJobs.IsEmpty() && m_bFlushRequested && !HasBatchesInFlight())
+		{
+			m_bFlushRequested = false;
+			m_aFlushJobs = CreateFlushJobs();
+		}
 
-				foreach (EDF_DbEntity entity : entities)
-				{
-					bufferedResults.Insert(entity);
-					alreadyKnown.Insert(entity.GetId());
-				}
+		int tickStart = System.GetTickCount();
+		float frameBudget = m_pFlushScheduler.GetFrameBudget();
 
-				// send query to db with exlude for known update or removed ids
-				if (!alreadyKnown.IsEmpty())
-				{
-					EDF_DbFindCondition exclude = EDF_DbFind.Id().Not().EqualsAnyOf(alreadyKnown);
-
-					if (processedCondition)
-					{
-						processedCondition = EDF_DbFind.And({processedCondition, exclude});
-					}
-					else
-					{
-						processedCondition = exclude;
-					}
-				}
+		// At least one batch per frame so the flush always progresses
+		while (!m_aFlushJobs.IsEmpty())
+		{
+			EDF_DbDriverBufferWrapperFlushJob job = m_aFlushJobs.Get(0);
 
-				// -> pre results + further query
-			}
+			int batchStart = System.GetTickCount();
+			int batchSize = m_pFlushScheduler.GetBatchSize(frameBudget - (batchStart - tickStart));
+			int sent = SendFlushBatch(job, batchSize, false);
+			int batchEnd = System.GetTickCount();
 
-			// no ordering to driver if there are any buffered results
-			// combined results order in memory if there was orderby
-			//if (!bufferedResults.IsEmpty())
-			//	orderByDriver = null;
+			m_pFlushScheduler.ReportBatch(sent, batchEnd - batchStart);
 
+			if (job.IsDone())
+				m_aFlushJobs.RemoveOrdered(0);
 
-			// original search condition fully satisfied by buffered results, return early
-			// ---- Also - If no order by and current results are enough for offset + limit return those first. >>> disabled because it fucks up result processing logic below
-			if ((condition && !processedCondition)/* ||
-				(!orderBy && (limit != -1) && ((Math.Max(offset, 0) + limit) <= bufferedResults.Count()))*//*)
-			{
-				if (orderBy)
-					bufferedResults = EDF_DbEntitySorter.GetSorted(bufferedResults, orderBy);
+			if (batchEnd - tickStart >= frameBudget)
+				break;
+		}
 
-				array<ref EDF_DbEntity> earlyResult();
-				if (offset != -1 || limit != -1)
-				{
-					ApplyLimitOffset(bufferedResults, limit, offset, earlyResult);
-				}
-				else
-				{
-					earlyResult = bufferedResults;
-				}
+		if (m_aFlushJobs.IsEmpty() && !m_bFlushRequested)
+			StopFlushTick();
+	}
 
-				if (async)
-				{
-					if (callback)
-						callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, earlyResult);
+	//------------------------------------------------------------------------------------------------
+	protected void StartFlushTick()
+	{
+		if (m_bFlushTickActive)
+			return;
 
-					return null;
-				}
-				else
-				{
-					return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, earlyResult);
-				}
-			}
+		if (!m_aFlushJobs)
+			m_aFlushJobs = {};
 
-			/*
-			// adjust offset and limit to account for buffered results and removals
-			if (limit != -1)
-				driverLimit += bufferedResults.Count();
+		m_bFlushTickActive = true;
+		GetGame().GetCallqueue().CallLater(FlushTick, 0, true);
+	}
 
-			if (offset > 0)
-			{
-				driverOffset = Math.Max(0, offset - bufferedResults.Count());
+	//------------------------------------------------------------------------------------------------
+	//! Also drops a requested follow-up flush, the only callers are the end of a flush and a blocking flush that writes everything
+	protected void StopFlushTick()
+	{
+		m_bFlushRequested = false;
+		if (!m_bFlushTickActive)
+			return;
 
-				// offset: 3 -5 -> 0 limit:3 +5 -> 8 ---> 3 offset then 3 read
-				// offset: 6 -5 -> 1 limit:3 +5 -> 8 ---> 5 offset then 3 read
-				compenstatedOffset = Math.Min(offset, driverOffset);
-			}
-			*//*
+		GetGame().GetCallqueue().Remove(FlushTick);
+		m_aFlushJobs = null;
+		m_bFlushTickActive = false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Snapshot of all pending changes, ordered by the type priorities of the flush scheduler
+	protected array<ref EDF_DbDriverBufferWrapperFlushJob> CreateFlushJobs()
+	{
+		array<typename> entityTypes();
+		foreach (typename entityType, EDF_DbDriverBufferWrapperTypeBuffer buffer : m_mBuffers)
+		{
+			if (!buffer.IsEmpty())
+				entityTypes.Insert(entityType);
 		}
 
-		if (async)
+		m_pFlushScheduler.SortByPriority(entityTypes);
+
+		array<ref EDF_DbDriverBufferWrapperFlushJob> jobs();
+		jobs.Reserve(entityTypes.Count());
+		foreach (typename entityType : entityTypes)
 		{
-			EDF_DbBufferedFindAllAsyncContext context(this, bufferedResults, orderBy, limit, compenstatedOffset, callback);
-			m_pDriver.FindAllAsync(entityType, processedCondition, orderByDriver, driverLimit, driverOffset, new EDF_DbBufferedFindAllAsyncProcessorCallback(context: context));
-			return null;
+			jobs.Insert(new EDF_DbDriverBufferWrapperFlushJob(entityType, m_mBuffers.Get(entityType)));
 		}
 
-		EDF_DbFindResultMultiple<EDF_DbEntity> result = m_pDriver.FindAll(entityType, processedCondition, orderByDriver, driverLimit, driverOffset);
-		return ProcessResult(result.GetStatusCode(), result.GetEntities(), bufferedResults, orderBy, limit, compenstatedOffset);
+		return jobs;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	static EDF_DbFindResultMultiple<EDF_DbEntity> ProcessResult(
-		EDF_EDbOperationStatusCode code,
-		array<ref EDF_DbEntity> findResults,
-		array<ref EDF_DbEntity> bufferedResults,
-		array<ref TStringArray> orderBy,
-		int limit,
-		int offset)
+	//! Send the next removals or updates of the job to the driver
+	//! \return amount of entities sent
+	protected int SendFlushBatch(notnull EDF_DbDriverBufferWrapperFlushJob job, int batchSize, bool blocking)
 	{
-		//We need some strong ref for this, function argument won't keep it alive
-		array<ref EDF_DbEntity> processedResult = findResults;
-
-		if (limit == -1)
-			limit = int.MAX;
-
-		int dbCount = 5;
-		int bufferCount = bufferedResults.Count();
-		int totalCount = dbCount + bufferCount;
-		limit = Math.Min(totalCount - offset, limit);
-		int needed = limit - findResults.Count();
-		int startIndex = offset + findResults.Count() - dbCount;
-
-		PrintFormat("Needs %1 starting at index %2 of buffer", needed, startIndex);
-		// Problem: We do not know exactly which page an entry might have been ordered into on query.
-		// Remembering for which page it was returned could lead to inaccurate results if the queries or data changes ...
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = job.m_pBuffer;
 
-		// append buffered results at the end to not disturb offset/limit while not using any ordering
-		if (needed > 0)
+		array<string> batchIds = job.TakeRemovals(batchSize);
+		if (batchIds)
 		{
-			processedResult.Reserve(processedResult.Count() + needed);
-			for (int n = 0; n < needed; n++)
+			if (blocking)
 			{
-				processedResult.Insert(bufferedResults.Get(startIndex + n));
+				EDF_EDbOperationStatusCode statusCode = m_pDriver.RemoveMany(job.m_tEntityType, batchIds);
+				if (statusCode == EDF_EDbOperationStatusCode.SUCCESS || statusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND)
+					buffer.ReleaseRemovals(batchIds);
+			}
+			else
+			{
+				buffer.m_iFlushing++;
+				m_pDriver.RemoveManyAsync(job.m_tEntityType, batchIds, new EDF_DbDriverBufferWrapperFlushCallback(buffer, null, batchIds));
 			}
-		}
 
-		if (orderBy)
-			processedResult = EDF_DbEntitySorter.GetSorted(processedResult, orderBy);
+			return batchIds.Count();
+		}
 
-		//if (processedResult.Count() > limit)
-		//	processedResult.Resize(limit);
+		array<ref EDF_DbEntity> batchEntities = job.TakeUpdates(batchSize);
+		if (!batchEntities)
+			return 0;
 
-		/*
-		// apply order + limit/offset
-		if (limit != -1 || offset != -1)
+		if (blocking)
 		{
-			array<ref EDF_DbEntity> limitedResults();
-			ApplyLimitOffset(processedResult, limit, offset, limitedResults);
-			processedResult = limitedResults;
+			if (m_pDriver.AddOrUpdateMany(batchEntities) == EDF_EDbOperationStatusCode.SUCCESS)
+				buffer.ReleaseUpdates(batchEntities);
+		}
+		else
+		{
+			buffer.m_iFlushing++;
+			m_pDriver.AddOrUpdateManyAsync(batchEntities, new EDF_DbDriverBufferWrapperFlushCallback(buffer, batchEntities, null));
 		}
-		*//*
 
-		return new EDF_DbFindResultMultiple<EDF_DbEntity>(code, processedResult);
+		return batchEntities.Count();
 	}
 
 	//------------------------------------------------------------------------------------------------
-	protected static void ApplyLimitOffset(array<ref EDF_DbEntity> entities, int limit, int offset, array<ref EDF_DbEntity> resultEntites)
+	protected EDF_EDbOperationStatusCode PatchBuffered(notnull EDF_DbDriverBufferWrapperTypeBuffer buffer, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition)
 	{
-		foreach (int idx, EDF_DbEntity entity : entities)
-		{
-			// Respect output limit is specified
-			if (limit != -1 && resultEntites.Count() >= limit)
-				break;
+		EDF_DbEntity entity = buffer.GetUpdate(entityId);
+		if (!entity)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
 
-			// Skip the first n records if offset specified (for paginated loading together with limit)
-			if (offset != -1 && idx < offset)
-				continue;
+		if (condition && !EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+			return EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET;
+
+		// Patch a copy, the buffered instance might currently be in flight to the driver
+		EDF_DbEntity patched = EDF_DbEntityUtils.DeepCopy(entity);
+		if (!patch.Apply(patched))
+			return EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED;
+
+		buffer.SetUpdate(patched);
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void RemoveMatchingUpdates(typename entityType, EDF_DbFindCondition condition)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = GetPendingBuffer(entityType);
+		if (!buffer)
+			return;
 
-			resultEntites.Insert(entity);
+		foreach (EDF_DbEntity entity : buffer.GetMatchingUpdates(condition))
+		{
+			buffer.SetRemoved(entity.GetId());
 		}
 	}
 
 	//------------------------------------------------------------------------------------------------
-	protected EDF_DbFindCondition ProcessCondition(
-		typename entityType,
-		EDF_DbFindCondition condition,
-		bool skipAddOrUpdateRemoval,
-		array<string> queriedIds,
-		out bool boolComplexCondition)
+	//! Copies of the buffered entities for the requested ids. Ids without pending changes are collected into driverIds.
+	protected array<ref EDF_DbEntity> CollectBufferedResults(notnull EDF_DbDriverBufferWrapperTypeBuffer buffer, notnull array<string> entityIds, notnull array<string> driverIds)
 	{
-		EDF_DbFindFieldStringMultiple stringMultipleCondition = EDF_DbFindFieldStringMultiple.Cast(condition);
-		if (stringMultipleCondition)
+		array<ref EDF_DbEntity> bufferedResults();
+		foreach (string entityId : entityIds)
 		{
-			if (stringMultipleCondition.m_sFieldPath != EDF_DbEntity.FIELD_ID ||
-				stringMultipleCondition.m_eComparisonOperator != EDF_EDbFindOperator.EQUAL)
+			if (!buffer.Contains(entityId))
 			{
-				boolComplexCondition = true;
-				return condition;
+				driverIds.Insert(entityId);
+				continue;
 			}
 
-			array<string> removedIds = m_mRemoveBufferIds.Get(entityType);
-			array<string> updatedIds = m_mAddOrUpdateBufferIds.Get(entityType);
+			EDF_DbEntity entity = buffer.GetUpdate(entityId);
+			if (entity)
+				bufferedResults.Insert(EDF_DbEntityUtils.DeepCopy(entity));
+		}
 
-			array<int> remove();
-			foreach (int idx, string id : stringMultipleCondition.m_aComparisonValues)
-			{
-				if (removedIds && removedIds.Contains(id))
-				{
-					remove.Insert(idx);
-				}
-				else if (!skipAddOrUpdateRemoval && updatedIds && updatedIds.Contains(id))
-				{
-					remove.Insert(idx);
-					queriedIds.Insert(id);
-				}
-			}
+		return bufferedResults;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static EDF_DbFindCondition ExcludePending(notnull EDF_DbDriverBufferWrapperTypeBuffer buffer, EDF_DbFindCondition condition)
+	{
+		EDF_DbFindCondition exclude = EDF_DbFind.Id().Not().EqualsAnyOf(buffer.GetPendingIds());
+		if (!condition)
+			return exclude;
 
-			if (remove.Count() == stringMultipleCondition.m_aComparisonValues.Count())
-				return null; // No additional conditions, all ids satifies by buffered info
+		return EDF_DbFind.And({condition, exclude});
+	}
 
-			foreach (int removeIdx : remove)
-			{
-				stringMultipleCondition.m_aComparisonValues.RemoveOrdered(removeIdx);
-			}
+	//------------------------------------------------------------------------------------------------
+	//! \return buffer of the type if it has any pending changes, null otherwise
+	protected EDF_DbDriverBufferWrapperTypeBuffer GetPendingBuffer(typename entityType)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = m_mBuffers.Get(entityType);
+		if (buffer && !buffer.IsEmpty())
+			return buffer;
 
-			return stringMultipleCondition;
-		}
+		return null;
+	}
 
-		EDF_DbFindOr orCondition = EDF_DbFindOr.Cast(condition);
-		if (orCondition)
+	//------------------------------------------------------------------------------------------------
+	protected EDF_DbDriverBufferWrapperTypeBuffer GetOrCreateBuffer(typename entityType)
+	{
+		EDF_DbDriverBufferWrapperTypeBuffer buffer = m_mBuffers.Get(entityType);
+		if (!buffer)
 		{
-			array<int> remove();
-			foreach (int idx, EDF_DbFindCondition childCondition : orCondition.m_Conditions)
-			{
-				EDF_DbFindCondition processed = ProcessCondition(entityType, childCondition, skipAddOrUpdateRemoval, queriedIds, boolComplexCondition);
-				if (!processed)
-					remove.Insert(idx); // Condition consumed by pre-processing (e.g. removed/updated ids only)
-			}
+			buffer = new EDF_DbDriverBufferWrapperTypeBuffer();
+			m_mBuffers.Set(entityType, buffer);
+		}
 
-			if (remove.Count() == orCondition.m_Conditions.Count())
-				return null; // all or conditions consumed
+		return buffer;
+	}
 
-			foreach (int removeIdx : remove)
-			{
-				orCondition.m_Conditions.RemoveOrdered(removeIdx);
-			}
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDriverBufferWrapper(notnull EDF_DbDriver driver)
+	{
+		m_pDriver = driver;
+		m_mBuffers = new map<typename, ref EDF_DbDriverBufferWrapperTypeBuffer>();
+		m_pFlushScheduler = new EDF_DbFlushScheduler();
+		EDF_DbShutdownFlush.Register(this);
+	}
 
-			return orCondition;
-		}
+	//------------------------------------------------------------------------------------------------
+	void ~EDF_DbDriverBufferWrapper()
+	{
+		EDF_DbShutdownFlush.Unregister(this);
+
+		if (m_mBuffers)
+			Flush(forceBlocking: true);
+	}
+};
+
+//! Remaining part of a non-blocking flush for one entity type
+class EDF_DbDriverBufferWrapperFlushJob
+{
+	typename m_tEntityType;
+	ref EDF_DbDriverBufferWrapperTypeBuffer m_pBuffer;
+	protected ref array<string> m_aRemovals;
+	protected ref array<ref EDF_DbEntity> m_aUpdates;
+	protected int m_iRemovalsSent;
+	protected int m_iUpdatesSent;
 
-		EDF_DbFindAnd andCondition = EDF_DbFindAnd.Cast(condition);
-		if (andCondition)
+	//------------------------------------------------------------------------------------------------
+	bool IsDone()
+	{
+		return m_iRemovalsSent >= m_aRemovals.Count() && m_iUpdatesSent >= m_aUpdates.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return next up to batchSize ids to remove, null if all were taken
+	array<string> TakeRemovals(int batchSize)
+	{
+		int count = Math.Min(batchSize, m_aRemovals.Count() - m_iRemovalsSent);
+		if (count <= 0)
+			return null;
+
+		array<string> batchIds();
+		batchIds.Reserve(count);
+		for (int nId = 0; nId < count; nId++)
 		{
-			foreach (int idx, EDF_DbFindCondition childCondition : andCondition.m_Conditions)
-			{
-				EDF_DbFindCondition processed = ProcessCondition(entityType, childCondition, true, queriedIds, boolComplexCondition);
-				if (!processed)
-					return null; //Whole condition can not be met due to removed id
-			}
+			batchIds.Insert(m_aRemovals.Get(m_iRemovalsSent++));
 		}
 
-		return condition;
+		return batchIds;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	array<ref EDF_DbEntity> SyncResults(array<ref EDF_DbEntity> entities)
+	//! \return next up to batchSize entities to save, null if all were taken
+	array<ref EDF_DbEntity> TakeUpdates(int batchSize)
 	{
-		array<int> remove();
-		array<ref EDF_DbEntity> updates;
-		foreach (int idx, EDF_DbEntity entity : entities)
+		int count = Math.Min(batchSize, m_aUpdates.Count() - m_iUpdatesSent);
+		if (count <= 0)
+			return null;
+
+		array<ref EDF_DbEntity> batchEntities();
+		batchEntities.Reserve(count);
+		for (int nEntity = 0; nEntity < count; nEntity++)
 		{
-			if (!updates)
-				updates = m_mAddOrUpdateBufferEntities.Get(entity.Type());
+			batchEntities.Insert(m_aUpdates.Get(m_iUpdatesSent++));
+		}
 
-			string id = entity.GetId();
-			if (m_mRemoveBufferIndices.Contains(id))
-			{
-				remove.Insert(idx);
-				continue;
-			}
+		return batchEntities;
+	}
 
-			int updateIdx;
-			if (m_mAddOrUpdateBufferIndices.Find(id, updateIdx))
-				entities.Set(idx, updates.Get(updateIdx));
-		}
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDriverBufferWrapperFlushJob(typename entityType, notnull EDF_DbDriverBufferWrapperTypeBuffer buffer)
+	{
+		m_tEntityType = entityType;
+		m_pBuffer = buffer;
+		m_aRemovals = buffer.GetRemovals();
+		m_aUpdates = buffer.GetUpdates();
+	}
+};
 
-		foreach (int idx : remove)
+class EDF_DbDriverBufferWrapperFlushCallback : EDF_DbOperationStatusOnlyCallback
+{
+	protected ref EDF_DbDriverBufferWrapperTypeBuffer m_pBuffer;
+	protected ref array<ref EDF_DbEntity> m_aEntities;
+	protected ref array<string> m_aEntityIds;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		Release();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		// Removals of ids that never made it into the database are done as well, everything else is retried on the next flush
+		if (m_aEntityIds && statusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND)
 		{
-			entities.RemoveOrdered(idx);
+			Release();
+			return;
 		}
 
-		return entities;
+		m_pBuffer.m_iFlushing--;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	void EDF_DbDriverBufferWrapper(notnull EDF_DbDriver driver)
+	protected void Release()
 	{
-		m_pDriver = driver;
+		if (m_aEntities)
+			m_pBuffer.ReleaseUpdates(m_aEntities);
 
-		m_mRemoveBufferIndices = new map<string, int>();
-		m_mRemoveBufferIds = new map<typename, ref array<string>>();
-		m_mRemoveBufferAsync = new map<typename, ref array<bool>>();
+		if (m_aEntityIds)
+			m_pBuffer.ReleaseRemovals(m_aEntityIds);
 
-		m_mAddOrUpdateBufferIndices = new map<string, int>();
-		m_mAddOrUpdateBufferIds = new map<typename, ref array<string>>();
-		m_mAddOrUpdateBufferAsync = new map<typename, ref array<bool>>();
-		m_mAddOrUpdateBufferEntities = new map<typename, ref array<ref EDF_DbEntity>>();
+		m_pBuffer.m_iFlushing--;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	void ~EDF_DbDriverBufferWrapper()
+	void EDF_DbDriverBufferWrapperFlushCallback(EDF_DbDriverBufferWrapperTypeBuffer buffer, array<ref EDF_DbEntity> entities, array<string> entityIds)
 	{
-		Flush(forceBlocking: true);
+		m_pBuffer = buffer;
+		m_aEntities = entities;
+		m_aEntityIds = entityIds;
 	}
 };
 
-class EDF_DbBufferedFindAllAsyncContext
+class EDF_DbDriverBufferWrapperFindAllCallback : EDF_DbFindCallbackBase
 {
-	EDF_DbDriverBufferWrapper m_pBufferWrapper;
-	ref array<ref EDF_DbEntity> m_aBufferedResults;
-	ref array<ref TStringArray> m_aOrderBy;
-	int m_iLimit;
-	int m_iOffset;
-	ref EDF_DbFindCallbackBase m_pCallback;
+	protected ref EDF_DbDriverBufferWrapperTypeBuffer m_pBuffer;
+	protected ref EDF_DbFindCondition m_pCondition;
+	protected ref array<ref TStringArray> m_aOrderBy;
+	protected int m_iLimit;
+	protected int m_iOffset;
+	protected ref EDF_DbFindCallbackBase m_pCallback;
 
 	//------------------------------------------------------------------------------------------------
-	void EDF_DbBufferedFindAllAsyncContext(
-		EDF_DbDriverBufferWrapper bufferWrapper,
-		array<ref EDF_DbEntity> bufferedResults,
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		if (!m_pCallback)
+			return;
+
+		if (code == EDF_EDbOperationStatusCode.SUCCESS && findResults)
+			findResults = m_pBuffer.MergeFindResults(findResults, m_pCondition, m_aOrderBy, m_iLimit, m_iOffset);
+
+		m_pCallback.Invoke(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDriverBufferWrapperFindAllCallback(
+		EDF_DbDriverBufferWrapperTypeBuffer buffer,
+		EDF_DbFindCondition condition,
 		array<ref TStringArray> orderBy,
 		int limit,
 		int offset,
 		EDF_DbFindCallbackBase callback)
 	{
-		m_pBufferWrapper = bufferWrapper;
-		m_aBufferedResults = bufferedResults;
+		m_pBuffer = buffer;
+		m_pCondition = condition;
 		m_aOrderBy = orderBy;
 		m_iLimit = limit;
 		m_iOffset = offset;
@@ -686,26 +1052,63 @@ class EDF_DbBufferedFindAllAsyncContext
 	}
 };
 
-class EDF_DbBufferedFindAllAsyncProcessorCallback : EDF_DbFindCallbackBase
+class EDF_DbDriverBufferWrapperFindByIdsCallback : EDF_DbFindCallbackBase
 {
+	protected ref array<ref EDF_DbEntity> m_aBufferedResults;
+	protected ref array<string> m_aEntityIds;
+	protected ref EDF_DbFindCallbackBase m_pCallback;
+
 	//------------------------------------------------------------------------------------------------
-	sealed override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
 	{
-		EDF_DbBufferedFindAllAsyncContext context = EDF_DbBufferedFindAllAsyncContext.Cast(m_pContext);
-		EDF_DbFindResultMultiple<EDF_DbEntity> processedResult = context.m_pBufferWrapper.ProcessResult(
-			code,
-			findResults,
-			context.m_aBufferedResults,
-			context.m_aOrderBy,
-			context.m_iLimit,
-			context.m_iOffset);
+		if (!m_pCallback)
+			return;
+
+		if (code == EDF_EDbOperationStatusCode.SUCCESS && findResults)
+		{
+			foreach (EDF_DbEntity entity : findResults)
+			{
+				m_aBufferedResults.Insert(entity);
+			}
 
-		// for each buffered result, check current buffer if we can replace entity with that, to make sure we have the latest info, even if callback is sent, changes happen, callback invokes
-		// check if they were just removed too
-		array<ref EDF_DbEntity> resultEntities = context.m_pBufferWrapper.SyncResults(processedResult.GetEntities());
+			findResults = EDF_DbEntityUtils.OrderByIds(m_aBufferedResults, m_aEntityIds);
+		}
 
-		if (context.m_pCallback)
-			context.m_pCallback.Invoke(processedResult.GetStatusCode(), resultEntities);
+		m_pCallback.Invoke(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDriverBufferWrapperFindByIdsCallback(array<ref EDF_DbEntity> bufferedResults, array<string> entityIds, EDF_DbFindCallbackBase callback)
+	{
+		m_aBufferedResults = bufferedResults;
+		m_aEntityIds = entityIds;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbDriverBufferWrapperCountCallback : EDF_DbCountCallback
+{
+	protected int m_iBufferedCount;
+	protected ref EDF_DbCountCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(int count, Managed context)
+	{
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, count + m_iBufferedCount);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDriverBufferWrapperCountCallback(int bufferedCount, EDF_DbCountCallback callback)
+	{
+		m_iBufferedCount = bufferedCount;
+		m_pCallback = callback;
 	}
 };
-*/
@@ -0,0 +1,350 @@
+//! Lets identical FindAllAsync calls share one driver operation while it is in flight. Callers asking for the same type, condition,
+//! order, limit and offset are attached to the pending operation and every caller receives its own copy of the results.
+//! A write of the entity type detaches its pending finds, later finds do not share results that could be older than the write.
+//! Finds with an EDF_DbFindCallbackChunked are not shared and reach the driver with their own callback.
+//! EDF_DbContext.Create() wraps all drivers with it while s_bEnabled is set.
+class EDF_DbDriverSingleFlightWrapper : EDF_DbDriver
+{
+	static bool s_bEnabled = true;
+
+	protected ref EDF_DbDriver m_pDriver;
+	protected ref map<typename, ref array<ref EDF_DbSingleFlightQuery>> m_mInFlight = new map<typename, ref array<ref EDF_DbSingleFlightQuery>>();
+
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		return m_pDriver.Initialize(connectionInfo);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
+	{
+		Detach(entity.Type());
+		return m_pDriver.AddOrUpdate(entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
+	{
+		Detach(entityType);
+		return m_pDriver.Remove(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		return m_pDriver.FindAll(entityType, condition, orderBy, limit, offset);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		return m_pDriver.FindById(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		return m_pDriver.FindByIds(entityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return m_pDriver.Count(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return m_pDriver.Exists(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		return m_pDriver.Aggregate(entityType, aggregation, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		Detach(entities);
+		return m_pDriver.AddOrUpdateMany(entities);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		Detach(entityType);
+		return m_pDriver.RemoveMany(entityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		Detach(entityType);
+		return m_pDriver.RemoveWhere(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		Detach(entityType);
+		return m_pDriver.Patch(entityType, entityId, patch, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		Detach(entity.Type());
+		m_pDriver.AddOrUpdateAsync(entity, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		Detach(entityType);
+		m_pDriver.RemoveAsync(entityType, entityId, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		// Nobody to share the results with. Chunked callbacks go straight to the driver, so it can still stream the results to them.
+		if (!callback || EDF_DbFindCallbackChunked.Cast(callback))
+		{
+			m_pDriver.FindAllAsync(entityType, condition, orderBy, limit, offset, callback);
+			return;
+		}
+
+		EDF_DbSingleFlightQuery query(condition, orderBy, limit, offset);
+		array<ref EDF_DbSingleFlightQuery> inFlight = m_mInFlight.Get(entityType);
+		if (inFlight)
+		{
+			// Keys are only built once there is something to compare with, finds that complete right away never pay for it
+			string key = query.GetKey();
+			foreach (EDF_DbSingleFlightQuery pending : inFlight)
+			{
+				if (pending.GetKey() == key)
+				{
+					pending.Attach(callback);
+					return;
+				}
+			}
+		}
+		else
+		{
+			inFlight = {};
+			m_mInFlight.Set(entityType, inFlight);
+		}
+
+		query.Attach(callback);
+		inFlight.Insert(query);
+		m_pDriver.FindAllAsync(entityType, condition, orderBy, limit, offset, new EDF_DbSingleFlightCallback(this, entityType, query));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		m_pDriver.FindByIdAsync(entityType, entityId, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		m_pDriver.FindByIdsAsync(entityType, entityIds, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		m_pDriver.CountAsync(entityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		m_pDriver.ExistsAsync(entityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		m_pDriver.AggregateAsync(entityType, aggregation, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		Detach(entities);
+		m_pDriver.AddOrUpdateManyAsync(entities, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		Detach(entityType);
+		m_pDriver.RemoveManyAsync(entityType, entityIds, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		Detach(entityType);
+		m_pDriver.RemoveWhereAsync(entityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		Detach(entityType);
+		m_pDriver.PatchAsync(entityType, entityId, patch, callback, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return finds of the type currently shared with other callers
+	int GetInFlightCount(typename entityType)
+	{
+		array<ref EDF_DbSingleFlightQuery> inFlight = m_mInFlight.Get(entityType);
+		if (!inFlight)
+			return 0;
+
+		return inFlight.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Called by the find callback once the driver answered
+	void OnQueryFinished(typename entityType, notnull EDF_DbSingleFlightQuery query)
+	{
+		array<ref EDF_DbSingleFlightQuery> inFlight = m_mInFlight.Get(entityType);
+		if (!inFlight)
+			return;
+
+		inFlight.RemoveItem(query);
+		if (inFlight.IsEmpty())
+			m_mInFlight.Remove(entityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Detach(typename entityType)
+	{
+		m_mInFlight.Remove(entityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Detach(notnull array<ref EDF_DbEntity> entities)
+	{
+		if (m_mInFlight.IsEmpty())
+			return;
+
+		foreach (EDF_DbEntity entity : entities)
+		{
+			m_mInFlight.Remove(entity.Type());
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDriverSingleFlightWrapper(notnull EDF_DbDriver driver)
+	{
+		m_pDriver = driver;
+	}
+};
+
+//! One find in flight and all callers waiting for its results
+class EDF_DbSingleFlightQuery
+{
+	protected ref EDF_DbFindCondition m_pCondition; // Kept alive for the lazily built key, a freed condition would look like none
+	protected ref array<ref TStringArray> m_aOrderBy;
+	protected int m_iLimit;
+	protected int m_iOffset;
+	protected string m_sKey;
+	protected ref array<ref EDF_DbFindCallbackBase> m_aCallbacks = {};
+
+	//------------------------------------------------------------------------------------------------
+	//! \return serialized find parameters, equal for finds with the same condition, order, limit and offset
+	string GetKey()
+	{
+		if (!m_sKey)
+			m_sKey = EDF_DbEntityUtils.ToJson(this);
+
+		return m_sKey;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Attach(notnull EDF_DbFindCallbackBase callback)
+	{
+		m_aCallbacks.Insert(callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Hand the results to every caller. The first one gets the entities of the driver, the others get copies.
+	void Complete(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		foreach (int idx, EDF_DbFindCallbackBase callback : m_aCallbacks)
+		{
+			if (idx == 0 || !findResults)
+			{
+				callback.Invoke(code, findResults);
+				continue;
+			}
+
+			array<ref EDF_DbEntity> copies();
+			copies.Reserve(findResults.Count());
+			foreach (EDF_DbEntity entity : findResults)
+			{
+				copies.Insert(EDF_DbEntityUtils.DeepCopy(entity));
+			}
+
+			callback.Invoke(code, copies);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		if (m_pCondition)
+			saveContext.WriteValue("condition", m_pCondition);
+
+		if (m_aOrderBy)
+			saveContext.WriteValue("orderBy", m_aOrderBy);
+
+		saveContext.WriteValue("limit", m_iLimit);
+		saveContext.WriteValue("offset", m_iOffset);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbSingleFlightQuery(EDF_DbFindCondition condition, array<ref TStringArray> orderBy, int limit, int offset)
+	{
+		m_pCondition = condition;
+		m_aOrderBy = orderBy;
+		m_iLimit = limit;
+		m_iOffset = offset;
+	}
+};
+
+class EDF_DbSingleFlightCallback : EDF_DbFindCallbackBase
+{
+	protected EDF_DbDriverSingleFlightWrapper m_pWrapper;
+	protected typename m_tEntityType;
+	protected ref EDF_DbSingleFlightQuery m_pQuery;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		// Stop attaching before the callers run, they might issue the same find again
+		if (m_pWrapper)
+			m_pWrapper.OnQueryFinished(m_tEntityType, m_pQuery);
+
+		m_pQuery.Complete(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbSingleFlightCallback(EDF_DbDriverSingleFlightWrapper wrapper, typename entityType, EDF_DbSingleFlightQuery query)
+	{
+		m_pWrapper = wrapper;
+		m_tEntityType = entityType;
+		m_pQuery = query;
+	}
+};
@@ -0,0 +1,113 @@
+//! Decides how much of a buffered flush is sent to the driver per frame.
+//! The batch size adapts to the measured time per entity so each frame stays within the configured budget.
+class EDF_DbFlushScheduler
+{
+	protected float m_fFrameBudgetMs = 2.0;
+	protected int m_iMinBatchSize = 1;
+	protected int m_iMaxBatchSize = 500;
+	protected int m_iBatchSize = 10;
+	protected float m_fMsPerEntity = -1.0; // Moving average, -1 until the first batch was measured
+	protected ref map<typename, int> m_mPriorities = new map<typename, int>();
+
+	protected static const float SMOOTHING = 0.3;
+	protected static const float TICK_RESOLUTION_MS = 0.5; // Assumed duration of batches that completed within the same tick count
+
+	//------------------------------------------------------------------------------------------------
+	//! Time in milliseconds a non-blocking flush may spend per frame. At least one batch is sent each frame.
+	void SetFrameBudget(float budgetMs)
+	{
+		m_fFrameBudgetMs = Math.Max(budgetMs, 0.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetFrameBudget()
+	{
+		return m_fFrameBudgetMs;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Limit the adaptive batch size to the given range of entities per driver call
+	void SetBatchSizeLimits(int minBatchSize, int maxBatchSize)
+	{
+		m_iMinBatchSize = Math.Max(minBatchSize, 1);
+		m_iMaxBatchSize = Math.Max(maxBatchSize, m_iMinBatchSize);
+		m_iBatchSize = Math.ClampInt(m_iBatchSize, m_iMinBatchSize, m_iMaxBatchSize);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetMaxBatchSize()
+	{
+		return m_iMaxBatchSize;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Types with higher priority are flushed first. Defaults to 0.
+	void SetPriority(typename entityType, int priority)
+	{
+		m_mPriorities.Set(entityType, priority);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetPriority(typename entityType)
+	{
+		return m_mPriorities.Get(entityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Sort the types by descending priority. Types of equal priority keep their order.
+	void SortByPriority(notnull array<typename> entityTypes)
+	{
+		for (int nType = 1, count = entityTypes.Count(); nType < count; nType++)
+		{
+			typename entityType = entityTypes.Get(nType);
+			int priority = GetPriority(entityType);
+
+			int insertIdx = nType;
+			while (insertIdx > 0 && GetPriority(entityTypes.Get(insertIdx - 1)) < priority)
+			{
+				entityTypes.Set(insertIdx, entityTypes.Get(insertIdx - 1));
+				insertIdx--;
+			}
+
+			entityTypes.Set(insertIdx, entityType);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Amount of entities to send with the next driver call
+	//! \param remainingMs time left of the current frame budget
+	int GetBatchSize(float remainingMs)
+	{
+		if (m_fMsPerEntity > 0)
+		{
+			int fittingEntities = remainingMs / m_fMsPerEntity;
+			m_iBatchSize = Math.ClampInt(fittingEntities, m_iMinBatchSize, m_iMaxBatchSize);
+		}
+
+		return m_iBatchSize;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Update the time estimate with a measured batch
+	void ReportBatch(int entityCount, int elapsedMs)
+	{
+		if (entityCount <= 0)
+			return;
+
+		float sample = Math.Max(elapsedMs, TICK_RESOLUTION_MS) / entityCount;
+		if (m_fMsPerEntity < 0)
+		{
+			m_fMsPerEntity = sample;
+			return;
+		}
+
+		m_fMsPerEntity += (sample - m_fMsPerEntity) * SMOOTHING;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Average time in milliseconds one entity took to be passed on to the driver, -1 if not yet measured
+	float GetMsPerEntity()
+	{
+		return m_fMsPerEntity;
+	}
+};
@@ -0,0 +1,158 @@
+//! Drains pending async writes after the game ended within a deadline, instead of turning every single operation into a blocking request right away.
+//! Drivers that hold back writes register themselves and pass them on in batches with bounded concurrency each frame.
+//! Whatever is left when the deadline passes is written blocking, after that all drivers are forced to blocking mode as before.
+class EDF_DbShutdownFlush
+{
+	static int s_iDeadlineMs = 30000; //!< Time until everything left is written blocking. 0 skips the drain and blocks right away.
+	static int s_iMaxConcurrency = 8; //!< Max. batch requests in flight per driver
+	static int s_iBatchSize = 100; //!< Max. entities per batch request
+	static ref ScriptInvoker s_OnProgress = new ScriptInvoker(); //!< Invoked with (int completed, int total, bool finished)
+
+	protected static ref array<EDF_DbDriver> s_aDrivers;
+	protected static bool s_bDraining;
+	protected static int s_iStartTime;
+	protected static int s_iLastReportTime;
+	protected static int s_iTotal;
+	protected static int s_iLastPending;
+
+	protected static const int REPORT_INTERVAL_MS = 1000;
+
+	//------------------------------------------------------------------------------------------------
+	//! Called by drivers that hold back writes which need to be drained on shutdown
+	static void Register(notnull EDF_DbDriver driver)
+	{
+		if (!s_aDrivers)
+			s_aDrivers = new array<EDF_DbDriver>();
+
+		if (!s_aDrivers.Contains(driver))
+			s_aDrivers.Insert(driver);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void Unregister(EDF_DbDriver driver)
+	{
+		if (s_aDrivers)
+			s_aDrivers.RemoveItem(driver);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return true while async writes are collected and drained in batches
+	static bool IsDraining()
+	{
+		return s_bDraining;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start draining. Async writes issued from now on are collected and sent in batches over the next frames.
+	static void Begin()
+	{
+		if (s_bDraining || EDF_DbDriver.s_bForceBlocking)
+			return;
+
+		if (s_iDeadlineMs <= 0 || !GetGame())
+		{
+			EDF_DbDriver.s_bForceBlocking = true;
+			return;
+		}
+
+		s_bDraining = true;
+		s_iStartTime = System.GetTickCount();
+		s_iLastReportTime = s_iStartTime;
+		s_iLastPending = GetPendingCount();
+		s_iTotal = s_iLastPending;
+
+		Print(string.Format("Database shutdown flush started with %1 pending writes and a deadline of %2ms.", s_iTotal, s_iDeadlineMs), LogLevel.NORMAL);
+		GetGame().GetCallqueue().CallLater(Tick, 0, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Write everything still pending blocking and switch all drivers to blocking mode.
+	//! Called automatically once drained or when the deadline passed.
+	static void Finish()
+	{
+		if (!s_bDraining)
+			return;
+
+		s_bDraining = false;
+		if (GetGame())
+			GetGame().GetCallqueue().Remove(Tick);
+
+		// Anything issued from completion callbacks of the hard flush must be blocking too
+		EDF_DbDriver.s_bForceBlocking = true;
+
+		int pending = GetPendingCount();
+		if (pending > 0)
+			Print(string.Format("Database shutdown flush writing remaining %1 writes blocking after %2ms.", pending, System.GetTickCount() - s_iStartTime), LogLevel.WARNING);
+
+		// Registration order, so wrapped drivers receive the writes of their wrappers before they are flushed themselves
+		if (s_aDrivers)
+		{
+			foreach (EDF_DbDriver driver : s_aDrivers)
+			{
+				driver.HardFlushShutdown();
+			}
+		}
+
+		s_iLastPending = 0;
+		ReportProgress(true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void Tick()
+	{
+		int pending = GetPendingCount();
+
+		// New writes arrived since the last tick
+		if (pending > s_iLastPending)
+			s_iTotal += pending - s_iLastPending;
+
+		s_iLastPending = pending;
+
+		if (pending == 0 || System.GetTickCount() - s_iStartTime >= s_iDeadlineMs)
+		{
+			Finish();
+			return;
+		}
+
+		foreach (EDF_DbDriver driver : s_aDrivers)
+		{
+			driver.DrainShutdown(s_iMaxConcurrency, s_iBatchSize);
+		}
+
+		if (System.GetTickCount() - s_iLastReportTime >= REPORT_INTERVAL_MS)
+			ReportProgress(false);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void ReportProgress(bool finished)
+	{
+		s_iLastReportTime = System.GetTickCount();
+		int completed = s_iTotal - s_iLastPending;
+
+		if (finished)
+		{
+			Print(string.Format("Database shutdown flush finished %1 writes in %2ms.", s_iTotal, s_iLastReportTime - s_iStartTime), LogLevel.NORMAL);
+		}
+		else
+		{
+			Print(string.Format("Database shutdown flush %1/%2 writes done.", completed, s_iTotal), LogLevel.NORMAL);
+		}
+
+		s_OnProgress.Invoke(completed, s_iTotal, finished);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static int GetPendingCount()
+	{
+		int pending;
+		if (s_aDrivers)
+		{
+			foreach (EDF_DbDriver driver : s_aDrivers)
+			{
+				pending += driver.GetShutdownPendingCount();
+			}
+		}
+
+		return pending;
+	}
+};
@@ -50,6 +50,43 @@ class EDF_InMemoryDatabase
 		return result;
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Count stored entities of a type, optionally only those matching the condition.
+	//! \param limit stop counting once this many matches were found, -1 for no limit.
+	int Count(typename entityType, EDF_DbFindCondition condition = null, int limit = -1)
+	{
+		EDF_InMemoryDatabaseTable table = FindTable(entityType);
+		if (!table)
+			return 0;
+
+		if (!condition)
+		{
+			if (limit != -1)
+				return Math.Min(table.Count(), limit);
+
+			return table.Count();
+		}
+
+		int count;
+		for (int nElement = 0, tableCount = table.Count(); nElement < tableCount; nElement++)
+		{
+			if (!EDF_DbFindConditionEvaluator.Evaluate(table.GetElement(nElement), condition))
+				continue;
+
+			if (++count == limit)
+				break;
+		}
+
+		return count;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Read access to the stored instances without creating the table. Entities must not be changed or kept by the caller!
+	EDF_InMemoryDatabaseTable FindTable(typename entityType)
+	{
+		return m_EntityTables.Get(entityType.ToString());
+	}
+
 	//------------------------------------------------------------------------------------------------
 	protected EDF_InMemoryDatabaseTable GetTable(typename entityType)
 	{
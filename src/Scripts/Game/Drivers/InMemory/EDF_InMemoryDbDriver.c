@@ -56,6 +56,95 @@ class EDF_InMemoryDbDriver : EDF_DbDriver
 		return EDF_EDbOperationStatusCode.SUCCESS;
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		// Validate all first so a bad entry does not leave the batch half applied
+		foreach (EDF_DbEntity entity : entities)
+		{
+			if (!entity.HasId())
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+		}
+
+		foreach (EDF_DbEntity entity : entities)
+		{
+			EDF_DbEntity deepCopy = EDF_DbEntity.Cast(entity.Type().Spawn());
+			EDF_DbEntityUtils.StructAutoCopy(entity, deepCopy);
+			m_pDb.AddOrUpdate(deepCopy);
+		}
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+		foreach (string entityId : entityIds)
+		{
+			if (!entityId)
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+		}
+
+		foreach (string entityId : entityIds)
+		{
+			// Remove what exists, but still report that some of the ids were unknown
+			if (!m_pDb.Get(entityType, entityId))
+			{
+				result = EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
+				continue;
+			}
+
+			m_pDb.Remove(entityType, entityId);
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		EDF_InMemoryDatabaseTable table = m_pDb.FindTable(entityType);
+		if (!table)
+			return EDF_EDbOperationStatusCode.SUCCESS;
+
+		// Collect first, removing while iterating the map would skip elements
+		array<string> matchedIds();
+		for (int nElement = 0, count = table.Count(); nElement < count; nElement++)
+		{
+			if (EDF_DbFindConditionEvaluator.Evaluate(table.GetElement(nElement), condition))
+				matchedIds.Insert(table.GetKey(nElement));
+		}
+
+		foreach (string matchedId : matchedIds)
+		{
+			table.Remove(matchedId);
+		}
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		if (!entityId)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		// Stored instance is owned by the db, so it can be changed in place without any copy
+		EDF_DbEntity entity = m_pDb.Get(entityType, entityId);
+		if (!entity)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
+
+		// Check and change happen in the same call, nothing can modify the entity in between
+		if (condition && !EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+			return EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET;
+
+		if (!patch.Apply(entity))
+			return EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED;
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
 	{
@@ -110,6 +199,75 @@ class EDF_InMemoryDbDriver : EDF_DbDriver
 		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, resultEntites);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		if (!entityId)
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+		EDF_DbEntity entity = m_pDb.Get(entityType, entityId);
+		if (!entity)
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS);
+
+		EDF_DbEntity deepCopy = EDF_DbEntity.Cast(entityType.Spawn());
+		EDF_DbEntityUtils.StructAutoCopy(entity, deepCopy);
+		return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, deepCopy);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		array<ref EDF_DbEntity> resultEntites();
+		resultEntites.Reserve(entityIds.Count());
+
+		foreach (string entityId : entityIds)
+		{
+			EDF_DbEntity entity = m_pDb.Get(entityType, entityId);
+			if (!entity)
+				continue;
+
+			EDF_DbEntity deepCopy = EDF_DbEntity.Cast(entityType.Spawn());
+			EDF_DbEntityUtils.StructAutoCopy(entity, deepCopy);
+			resultEntites.Insert(deepCopy);
+		}
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, resultEntites);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return new EDF_DbCountResult(EDF_EDbOperationStatusCode.SUCCESS, CountMatches(entityType, condition, -1));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return new EDF_DbExistsResult(EDF_EDbOperationStatusCode.SUCCESS, CountMatches(entityType, condition, 1) > 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbAggregator aggregator(aggregation);
+		EDF_EDbOperationStatusCode statusCode = aggregator.Validate(entityType);
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			return new EDF_DbAggregateResult(statusCode);
+
+		EDF_InMemoryDatabaseTable table = m_pDb.FindTable(entityType);
+		if (table)
+		{
+			for (int nElement = 0, count = table.Count(); nElement < count; nElement++)
+			{
+				EDF_DbEntity entity = table.GetElement(nElement);
+				if (!condition || EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+					aggregator.Accumulate(entity);
+			}
+		}
+
+		return new EDF_DbAggregateResult(EDF_EDbOperationStatusCode.SUCCESS, aggregator.GetResults());
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
 	{
@@ -128,6 +286,42 @@ class EDF_InMemoryDbDriver : EDF_DbDriver
 			callback.Invoke(statusCode);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = AddOrUpdateMany(entities);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = RemoveMany(entityType, entityIds);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		// In memory is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = Patch(entityType, entityId, patch, condition);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = RemoveWhere(entityType, condition);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
 	{
@@ -137,6 +331,95 @@ class EDF_InMemoryDbDriver : EDF_DbDriver
 			callback.Invoke(findResults.GetStatusCode(), findResults.GetEntities());
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		EDF_DbFindResultSingle<EDF_DbEntity> findResult = FindById(entityType, entityId);
+		if (!callback)
+			return;
+
+		array<ref EDF_DbEntity> resultEntities();
+		if (findResult.GetEntity())
+			resultEntities.Insert(findResult.GetEntity());
+
+		callback.Invoke(findResult.GetStatusCode(), resultEntities);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindByIds(entityType, entityIds);
+		if (callback)
+			callback.Invoke(findResults.GetStatusCode(), findResults.GetEntities());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		int count = CountMatches(entityType, condition, -1);
+		if (callback)
+			callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, count);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		bool exists = CountMatches(entityType, condition, 1) > 0;
+		if (callback)
+			callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, exists);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		// In memory is blocking, re-use sync api
+		EDF_DbAggregateResult aggregateResult = Aggregate(entityType, aggregation, condition);
+		if (callback)
+			callback.Invoke(aggregateResult.GetStatusCode(), aggregateResult.GetGroups());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count without copying any entity. Pure id conditions are answered by lookup only.
+	protected int CountMatches(typename entityType, EDF_DbFindCondition condition, int limit)
+	{
+		int count;
+		set<string> loadIds();
+		if (EDF_DbFindConditionEvaluator.CollectEqualIds(condition, loadIds))
+		{
+			foreach (string loadId : loadIds)
+			{
+				if (!m_pDb.Get(entityType, loadId))
+					continue;
+
+				if (++count == limit)
+					break;
+			}
+
+			return count;
+		}
+
+		set<string> skipIds();
+		if (!condition || !EDF_DbFindConditionEvaluator.CollectSkipIds(condition, skipIds))
+			return m_pDb.Count(entityType, condition, limit);
+
+		// Only "not these ids" so everything else in the table matches
+		count = m_pDb.Count(entityType);
+		foreach (string skipId : skipIds)
+		{
+			if (m_pDb.Get(entityType, skipId))
+				count--;
+		}
+
+		if (limit != -1)
+			return Math.Min(count, limit);
+
+		return count;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	void ~EDF_InMemoryDbDriver()
 	{
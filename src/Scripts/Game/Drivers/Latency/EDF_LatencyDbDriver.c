@@ -0,0 +1,792 @@
+enum EDF_EDbLatencyDistribution
+{
+	CONSTANT,	//!< Always the base latency
+	UNIFORM,	//!< Base latency +/- jitter
+	NORMAL,		//!< Base latency as mean, jitter as standard deviation
+	EXPONENTIAL	//!< Base latency as mean, many fast and few slow calls
+};
+
+[EDF_DbConnectionInfoDriverType(EDF_LatencyDbDriver), BaseContainerProps()]
+class EDF_LatencyDbConnectionInfo : EDF_DbConnectionInfoBase
+{
+	[Attribute(desc: "Driver that actually stores the data. Uses the database name of the latency connection if it has none set.")]
+	ref EDF_DbConnectionInfoBase m_pInner;
+
+	[Attribute(defvalue: "50", desc: "Base latency in milliseconds of async calls.")]
+	int m_iLatencyMs = 50;
+
+	[Attribute(defvalue: "0", desc: "Spread of the latency in milliseconds. Meaning depends on the distribution.")]
+	int m_iJitterMs;
+
+	[Attribute(defvalue: "1", uiwidget: UIWidgets.ComboBox, desc: "How the latency of a call is sampled.", enums: ParamEnumArray.FromEnum(EDF_EDbLatencyDistribution))]
+	EDF_EDbLatencyDistribution m_eDistribution = EDF_EDbLatencyDistribution.UNIFORM;
+
+	[Attribute(defvalue: "0", desc: "Chance between 0 and 1 that a call takes the spike latency instead, to simulate a long tail.")]
+	float m_fSpikeRate;
+
+	[Attribute(defvalue: "1000", desc: "Latency in milliseconds of spiking calls.")]
+	int m_iSpikeLatencyMs = 1000;
+
+	[Attribute(defvalue: "0", desc: "Chance between 0 and 1 that a call fails without being applied.")]
+	float m_fErrorRate;
+
+	[Attribute(defvalue: "0", desc: "Chance between 0 and 1 that a call times out. It is still applied, only the answer gets lost.")]
+	float m_fTimeoutRate;
+
+	[Attribute(defvalue: "10000", desc: "Milliseconds until a timed out call reports its failure.")]
+	int m_iTimeoutMs = 10000;
+
+	[Attribute(defvalue: "0", desc: "Max. calls in flight at the same time, the others wait in order. 0 for no limit.")]
+	int m_iMaxConcurrent;
+
+	[Attribute(defvalue: "0", desc: "Seed for latencies and faults to get the same sequence every run. 0 for a random one.")]
+	int m_iSeed;
+
+	//------------------------------------------------------------------------------------------------
+	override void ReadOptions(string connectionString)
+	{
+		super.ReadOptions(connectionString);
+
+		// All options not meant for the simulation are passed on to the inner driver
+		string innerDriverName;
+		string innerOptions;
+
+		if (m_sDatabaseName.Length() < connectionString.Length())
+		{
+			array<string> keyValuePairs();
+			int paramsStart = m_sDatabaseName.Length() + 1;
+			connectionString.Substring(paramsStart, connectionString.Length() - paramsStart).Split("&", keyValuePairs, true);
+			foreach (string keyValuePair : keyValuePairs)
+			{
+				string keyLower, value;
+				int keyIdx = keyValuePair.IndexOf("=");
+				if (keyIdx != -1)
+				{
+					keyLower = keyValuePair.Substring(0, keyIdx).Trim();
+					keyLower.ToLower();
+
+					int valueFrom = keyIdx + 1;
+					value = keyValuePair.Substring(valueFrom, keyValuePair.Length() - valueFrom).Trim();
+				}
+
+				string valueLower = value;
+				valueLower.ToLower();
+
+				switch (keyLower)
+				{
+					case "inner":
+					{
+						innerDriverName = value;
+						break;
+					}
+
+					case "latency":
+					{
+						m_iLatencyMs = value.ToInt(m_iLatencyMs);
+						break;
+					}
+
+					case "jitter":
+					{
+						m_iJitterMs = value.ToInt(m_iJitterMs);
+						break;
+					}
+
+					case "distribution":
+					{
+						switch (valueLower)
+						{
+							case "constant":
+							{
+								m_eDistribution = EDF_EDbLatencyDistribution.CONSTANT;
+								break;
+							}
+
+							case "normal":
+							{
+								m_eDistribution = EDF_EDbLatencyDistribution.NORMAL;
+								break;
+							}
+
+							case "exponential":
+							{
+								m_eDistribution = EDF_EDbLatencyDistribution.EXPONENTIAL;
+								break;
+							}
+
+							default:
+							{
+								m_eDistribution = EDF_EDbLatencyDistribution.UNIFORM;
+								break;
+							}
+						}
+						break;
+					}
+
+					case "spikes":
+					{
+						m_fSpikeRate = value.ToFloat(m_fSpikeRate);
+						break;
+					}
+
+					case "spikelatency":
+					{
+						m_iSpikeLatencyMs = value.ToInt(m_iSpikeLatencyMs);
+						break;
+					}
+
+					case "errors":
+					{
+						m_fErrorRate = value.ToFloat(m_fErrorRate);
+						break;
+					}
+
+					case "timeouts":
+					{
+						m_fTimeoutRate = value.ToFloat(m_fTimeoutRate);
+						break;
+					}
+
+					case "timeout":
+					{
+						m_iTimeoutMs = value.ToInt(m_iTimeoutMs);
+						break;
+					}
+
+					case "concurrency":
+					{
+						m_iMaxConcurrent = value.ToInt(m_iMaxConcurrent);
+						break;
+					}
+
+					case "seed":
+					{
+						m_iSeed = value.ToInt(m_iSeed);
+						break;
+					}
+
+					default:
+					{
+						if (innerOptions)
+							innerOptions += "&";
+
+						innerOptions += keyValuePair;
+					}
+				}
+			}
+		}
+
+		if (!innerDriverName)
+		{
+			Debug.Error("Latency database connection requires an inner=<driver-name> option.");
+			return;
+		}
+
+		string innerConnectionString = string.Format("%1://%2", innerDriverName, m_sDatabaseName);
+		if (innerOptions)
+			innerConnectionString += "?" + innerOptions;
+
+		m_pInner = EDF_DbConnectionInfoBase.Parse(innerConnectionString);
+	}
+};
+
+//! Simulates a remote database in front of any other driver, e.g. Latency://Test?inner=InMemory&latency=40&jitter=20&errors=0.01
+//! Async calls are held back by a sampled latency before they are passed on, can fail or time out and are limited in how many are in flight.
+//! Sync calls are passed through unchanged, they can not be delayed without blocking the game.
+[EDF_DbDriverName({"Latency"})]
+class EDF_LatencyDbDriver : EDF_DbDriver
+{
+	protected ref EDF_DbDriver m_pDriver;
+	protected ref EDF_LatencyDbConnectionInfo m_pSettings;
+	protected ref RandomGenerator m_pRandom;
+	protected ref array<ref EDF_LatencyDbCall> m_aQueued;
+	protected ref array<ref EDF_LatencyDbCall> m_aInFlight;
+
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		EDF_LatencyDbConnectionInfo latencyConnectInfo = EDF_LatencyDbConnectionInfo.Cast(connectionInfo);
+		if (!latencyConnectInfo || !latencyConnectInfo.m_pInner)
+		{
+			Debug.Error("Latency database driver requires inner connection info.");
+			return false;
+		}
+
+		EDF_DbConnectionInfoBase innerConnectInfo = latencyConnectInfo.m_pInner;
+		if (!innerConnectInfo.m_sDatabaseName)
+			innerConnectInfo.m_sDatabaseName = latencyConnectInfo.m_sDatabaseName;
+
+		typename innerDriverType = EDF_DbConnectionInfoDriverType.GetDriverType(innerConnectInfo.Type());
+		EDF_DbDriver innerDriver = EDF_DbDriver.Cast(innerDriverType.Spawn());
+		if (!innerDriver || !innerDriver.Initialize(innerConnectInfo))
+		{
+			Debug.Error(string.Format("Unable to initialize inner database driver of type '%1'.", innerDriverType));
+			return false;
+		}
+
+		m_pDriver = innerDriver;
+		m_pSettings = latencyConnectInfo;
+		m_pRandom = new RandomGenerator();
+		if (latencyConnectInfo.m_iSeed != 0)
+			m_pRandom.SetSeed(latencyConnectInfo.m_iSeed);
+
+		m_aQueued = {};
+		m_aInFlight = {};
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Calls not yet completed, including the ones waiting for a free slot
+	int GetPendingCount()
+	{
+		return m_aQueued.Count() + m_aInFlight.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
+	{
+		return m_pDriver.AddOrUpdate(entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
+	{
+		return m_pDriver.Remove(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		return m_pDriver.FindAll(entityType, condition, orderBy, limit, offset);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		return m_pDriver.FindById(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		return m_pDriver.FindByIds(entityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return m_pDriver.Count(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return m_pDriver.Exists(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		return m_pDriver.Aggregate(entityType, aggregation, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		return m_pDriver.AddOrUpdateMany(entities);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		return m_pDriver.RemoveMany(entityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		return m_pDriver.RemoveWhere(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		return m_pDriver.Patch(entityType, entityId, patch, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_LatencyDbCall call("AddOrUpdate", entity.Type());
+		call.m_pEntity = EDF_DbEntityUtils.DeepCopy(entity);
+		call.m_pStatusCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_LatencyDbCall call("Remove", entityType);
+		call.m_sEntityId = entityId;
+		call.m_pStatusCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_LatencyDbCall call("FindAll", entityType);
+		call.m_pCondition = CopyCondition(condition);
+		call.m_aOrderBy = CopyOrderBy(orderBy);
+		call.m_iLimit = limit;
+		call.m_iOffset = offset;
+		call.m_pFindCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_LatencyDbCall call("FindById", entityType);
+		call.m_sEntityId = entityId;
+		call.m_pFindCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_LatencyDbCall call("FindByIds", entityType);
+		call.m_aEntityIds = {};
+		call.m_aEntityIds.Copy(entityIds);
+		call.m_pFindCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		EDF_LatencyDbCall call("Count", entityType);
+		call.m_pCondition = CopyCondition(condition);
+		call.m_pCountCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		EDF_LatencyDbCall call("Exists", entityType);
+		call.m_pCondition = CopyCondition(condition);
+		call.m_pExistsCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		EDF_LatencyDbCall call("Aggregate", entityType);
+		call.m_pAggregation = aggregation.Copy();
+		call.m_pCondition = CopyCondition(condition);
+		call.m_pAggregateCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_LatencyDbCall call("AddOrUpdateMany", EDF_DbEntity);
+		call.m_aEntities = {};
+		call.m_aEntities.Reserve(entities.Count());
+		foreach (EDF_DbEntity entity : entities)
+		{
+			call.m_aEntities.Insert(EDF_DbEntityUtils.DeepCopy(entity));
+		}
+
+		call.m_pStatusCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_LatencyDbCall call("RemoveMany", entityType);
+		call.m_aEntityIds = {};
+		call.m_aEntityIds.Copy(entityIds);
+		call.m_pStatusCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_LatencyDbCall call("RemoveWhere", entityType);
+		call.m_pCondition = CopyCondition(condition);
+		call.m_pStatusCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		EDF_LatencyDbCall call("Patch", entityType);
+		call.m_sEntityId = entityId;
+		call.m_pPatch = patch.Copy();
+		call.m_pCondition = CopyCondition(condition);
+		call.m_pStatusCallback = callback;
+		Enqueue(call);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Only the own held back calls, an inner driver that holds back writes registers itself
+	override int GetShutdownPendingCount()
+	{
+		if (!m_aQueued)
+			return 0;
+
+		return GetPendingCount();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void DrainShutdown(int maxConcurrency, int batchSize)
+	{
+		// Held back calls are passed on by their own timers
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void HardFlushShutdown()
+	{
+		if (m_aQueued)
+			CompleteAll();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pass on all held back calls right away without faults
+	void CompleteAll()
+	{
+		if (GetGame())
+			GetGame().GetCallqueue().Remove(Execute);
+
+		array<ref EDF_LatencyDbCall> calls();
+		calls.InsertAll(m_aInFlight);
+		calls.InsertAll(m_aQueued);
+		m_aInFlight.Clear();
+		m_aQueued.Clear();
+
+		foreach (EDF_LatencyDbCall call : calls)
+		{
+			call.Execute(m_pDriver);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Enqueue(EDF_LatencyDbCall call)
+	{
+		// Nothing can be waited on without a running game or during teardown
+		if (s_bForceBlocking || !GetGame())
+		{
+			call.Execute(m_pDriver);
+			return;
+		}
+
+		m_aQueued.Insert(call);
+		StartQueued();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void StartQueued()
+	{
+		while (!m_aQueued.IsEmpty() && (m_pSettings.m_iMaxConcurrent <= 0 || m_aInFlight.Count() < m_pSettings.m_iMaxConcurrent))
+		{
+			EDF_LatencyDbCall call = m_aQueued.Get(0);
+			m_aInFlight.Insert(call);
+			m_aQueued.RemoveOrdered(0);
+
+			int delay = SampleLatency();
+			float roll = m_pRandom.RandFloat01();
+			if (roll < m_pSettings.m_fErrorRate)
+			{
+				call.m_eFault = EDF_EDbOperationStatusCode.FAILURE_UNKNOWN;
+			}
+			else if (roll < m_pSettings.m_fErrorRate + m_pSettings.m_fTimeoutRate)
+			{
+				call.m_eFault = EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE;
+				delay = Math.Max(delay, m_pSettings.m_iTimeoutMs);
+			}
+
+			GetGame().GetCallqueue().CallLater(Execute, delay, false, call);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Execute(EDF_LatencyDbCall call)
+	{
+		// Keep it alive until the callback went out, the slot is freed first so callbacks can queue follow up calls
+		EDF_LatencyDbCall keepAlive = call;
+		m_aInFlight.RemoveItem(call);
+
+		// Errors never reach the database, timed out calls do but their answer is lost
+		if (call.m_eFault != EDF_EDbOperationStatusCode.FAILURE_UNKNOWN)
+		{
+			EDF_DbOperationCallback callback = call.DetachCallback();
+			call.Execute(m_pDriver);
+			call.AttachCallback(callback);
+		}
+
+		if (call.m_eFault != EDF_EDbOperationStatusCode.SUCCESS)
+			call.Fail(call.m_eFault);
+
+		StartQueued();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! A real database receives the arguments at call time, changes made by the caller while the call is held back must not reach it.
+	protected static EDF_DbFindCondition CopyCondition(EDF_DbFindCondition condition)
+	{
+		if (!condition)
+			return null;
+
+		return condition.Copy();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static array<ref TStringArray> CopyOrderBy(array<ref TStringArray> orderBy)
+	{
+		if (!orderBy)
+			return null;
+
+		array<ref TStringArray> copy();
+		copy.Reserve(orderBy.Count());
+		foreach (TStringArray orderByField : orderBy)
+		{
+			TStringArray fieldCopy();
+			fieldCopy.Copy(orderByField);
+			copy.Insert(fieldCopy);
+		}
+
+		return copy;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected int SampleLatency()
+	{
+		if (m_pSettings.m_fSpikeRate > 0 && m_pRandom.RandFloat01() < m_pSettings.m_fSpikeRate)
+			return m_pSettings.m_iSpikeLatencyMs;
+
+		float latency = m_pSettings.m_iLatencyMs;
+		switch (m_pSettings.m_eDistribution)
+		{
+			case EDF_EDbLatencyDistribution.UNIFORM:
+			{
+				latency += m_pRandom.RandFloatXY(-m_pSettings.m_iJitterMs, m_pSettings.m_iJitterMs);
+				break;
+			}
+
+			case EDF_EDbLatencyDistribution.NORMAL:
+			{
+				// Box-Muller transform
+				float u1 = Math.Max(m_pRandom.RandFloat01(), 0.000001);
+				float u2 = m_pRandom.RandFloat01();
+				latency += Math.Sqrt(-2 * Math.Log(u1)) * Math.Cos(Math.PI2 * u2) * m_pSettings.m_iJitterMs;
+				break;
+			}
+
+			case EDF_EDbLatencyDistribution.EXPONENTIAL:
+			{
+				latency = -Math.Log(Math.Max(1 - m_pRandom.RandFloat01(), 0.000001)) * m_pSettings.m_iLatencyMs;
+				break;
+			}
+		}
+
+		int latencyMs = Math.Round(latency);
+		return Math.Max(latencyMs, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_LatencyDbDriver()
+	{
+		// Before the inner driver registers, so held back calls reach it before it is flushed itself
+		EDF_DbShutdownFlush.Register(this);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ~EDF_LatencyDbDriver()
+	{
+		EDF_DbShutdownFlush.Unregister(this);
+
+		if (m_aQueued && GetGame())
+			GetGame().GetCallqueue().Remove(Execute);
+	}
+};
+
+//! A held back async call together with everything needed to pass it on later
+class EDF_LatencyDbCall
+{
+	string m_sOperation;
+	typename m_tEntityType;
+	EDF_EDbOperationStatusCode m_eFault; //!< SUCCESS if the call goes through
+
+	ref EDF_DbEntity m_pEntity;
+	ref array<ref EDF_DbEntity> m_aEntities;
+	string m_sEntityId;
+	ref array<string> m_aEntityIds;
+	ref EDF_DbFindCondition m_pCondition;
+	ref array<ref TStringArray> m_aOrderBy;
+	int m_iLimit = -1;
+	int m_iOffset = -1;
+	ref EDF_DbAggregation m_pAggregation;
+	ref EDF_DbPatch m_pPatch;
+
+	ref EDF_DbOperationStatusOnlyCallback m_pStatusCallback;
+	ref EDF_DbFindCallbackBase m_pFindCallback;
+	ref EDF_DbCountCallback m_pCountCallback;
+	ref EDF_DbExistsCallback m_pExistsCallback;
+	ref EDF_DbAggregateCallback m_pAggregateCallback;
+
+	//------------------------------------------------------------------------------------------------
+	//! Pass the call on to the driver with the original callback
+	void Execute(notnull EDF_DbDriver driver)
+	{
+		switch (m_sOperation)
+		{
+			case "AddOrUpdate":
+			{
+				driver.AddOrUpdateAsync(m_pEntity, m_pStatusCallback);
+				break;
+			}
+
+			case "Remove":
+			{
+				driver.RemoveAsync(m_tEntityType, m_sEntityId, m_pStatusCallback);
+				break;
+			}
+
+			case "FindAll":
+			{
+				driver.FindAllAsync(m_tEntityType, m_pCondition, m_aOrderBy, m_iLimit, m_iOffset, m_pFindCallback);
+				break;
+			}
+
+			case "FindById":
+			{
+				driver.FindByIdAsync(m_tEntityType, m_sEntityId, m_pFindCallback);
+				break;
+			}
+
+			case "FindByIds":
+			{
+				driver.FindByIdsAsync(m_tEntityType, m_aEntityIds, m_pFindCallback);
+				break;
+			}
+
+			case "Count":
+			{
+				driver.CountAsync(m_tEntityType, m_pCondition, m_pCountCallback);
+				break;
+			}
+
+			case "Exists":
+			{
+				driver.ExistsAsync(m_tEntityType, m_pCondition, m_pExistsCallback);
+				break;
+			}
+
+			case "Aggregate":
+			{
+				driver.AggregateAsync(m_tEntityType, m_pAggregation, m_pCondition, m_pAggregateCallback);
+				break;
+			}
+
+			case "AddOrUpdateMany":
+			{
+				driver.AddOrUpdateManyAsync(m_aEntities, m_pStatusCallback);
+				break;
+			}
+
+			case "RemoveMany":
+			{
+				driver.RemoveManyAsync(m_tEntityType, m_aEntityIds, m_pStatusCallback);
+				break;
+			}
+
+			case "RemoveWhere":
+			{
+				driver.RemoveWhereAsync(m_tEntityType, m_pCondition, m_pStatusCallback);
+				break;
+			}
+
+			case "Patch":
+			{
+				driver.PatchAsync(m_tEntityType, m_sEntityId, m_pPatch, m_pStatusCallback, m_pCondition);
+				break;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Report a failure to the original callback
+	void Fail(EDF_EDbOperationStatusCode statusCode)
+	{
+		if (m_pStatusCallback)
+			m_pStatusCallback.Invoke(statusCode);
+
+		if (m_pFindCallback)
+			m_pFindCallback.Invoke(statusCode, {});
+
+		if (m_pCountCallback)
+			m_pCountCallback.Invoke(statusCode, 0);
+
+		if (m_pExistsCallback)
+			m_pExistsCallback.Invoke(statusCode, false);
+
+		if (m_pAggregateCallback)
+			m_pAggregateCallback.Invoke(statusCode, null);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Take the callback away, so a timed out call is applied without answering
+	EDF_DbOperationCallback DetachCallback()
+	{
+		if (m_eFault == EDF_EDbOperationStatusCode.SUCCESS)
+			return null;
+
+		EDF_DbOperationCallback callback = m_pStatusCallback;
+		if (!callback)
+			callback = m_pFindCallback;
+
+		if (!callback)
+			callback = m_pCountCallback;
+
+		if (!callback)
+			callback = m_pExistsCallback;
+
+		if (!callback)
+			callback = m_pAggregateCallback;
+
+		m_pStatusCallback = null;
+		m_pFindCallback = null;
+		m_pCountCallback = null;
+		m_pExistsCallback = null;
+		m_pAggregateCallback = null;
+		return callback;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AttachCallback(EDF_DbOperationCallback callback)
+	{
+		if (!callback)
+			return;
+
+		m_pStatusCallback = EDF_DbOperationStatusOnlyCallback.Cast(callback);
+		m_pFindCallback = EDF_DbFindCallbackBase.Cast(callback);
+		m_pCountCallback = EDF_DbCountCallback.Cast(callback);
+		m_pExistsCallback = EDF_DbExistsCallback.Cast(callback);
+		m_pAggregateCallback = EDF_DbAggregateCallback.Cast(callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_LatencyDbCall(string operation, typename entityType)
+	{
+		m_sOperation = operation;
+		m_tEntityType = entityType;
+	}
+};
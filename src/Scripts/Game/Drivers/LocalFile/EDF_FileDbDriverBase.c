@@ -21,6 +21,7 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 	// Static props that can be shared across all driver instances
 	protected ref EDF_DbEntityCache m_pEntityCache;
 	protected ref map<typename, ref set<string>> m_mEntityIdsyCache;
+	protected ref map<typename, string> m_mTypeDirectories;
 
 	protected string m_sDbDir;
 	protected bool m_bUseCache;
@@ -34,6 +35,8 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 		if (!m_mEntityIdsyCache)
 			m_mEntityIdsyCache = new map<typename, ref set<string>>();
 
+		m_mTypeDirectories = new map<typename, string>();
+
 		auto fileConnectInfo = EDF_FileDbDriverInfoBase.Cast(connectionInfo);
 		m_bUseCache = fileConnectInfo.m_bUseCache;
 
@@ -89,6 +92,183 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 		return EDF_EDbOperationStatusCode.SUCCESS;
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		foreach (EDF_DbEntity entity : entities)
+		{
+			if (!entity.HasId())
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+		}
+
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+
+		// Directory and id pool are resolved once per type instead of once per entity
+		map<typename, ref array<ref EDF_DbEntity>> entitiesByType = EDF_DbEntityUtils.GroupByType(entities);
+		foreach (typename entityType, array<ref EDF_DbEntity> typeEntities : entitiesByType)
+		{
+			FileIO.MakeDirectory(_GetTypeDirectory(entityType));
+			set<string> ids = GetIdsByType(entityType);
+
+			// Save contexts keep everything written into them and can not be reset, so WriteToDisk needs a fresh one per file
+			foreach (EDF_DbEntity entity : typeEntities)
+			{
+				EDF_EDbOperationStatusCode statusCode = WriteToDisk(entity);
+				if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+				{
+					if (result == EDF_EDbOperationStatusCode.SUCCESS)
+						result = statusCode;
+
+					continue;
+				}
+
+				if (m_bUseCache)
+					m_pEntityCache.Add(entity);
+
+				ids.Insert(entity.GetId());
+			}
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Write entities straight into the storage files, e.g. to seed large test datasets.
+	//! Skips the entity cache and only invalidates the known ids, so they are read from disk again when needed.
+	EDF_EDbOperationStatusCode Import(notnull array<ref EDF_DbEntity> entities)
+	{
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+
+		map<typename, ref array<ref EDF_DbEntity>> entitiesByType = EDF_DbEntityUtils.GroupByType(entities);
+		foreach (typename entityType, array<ref EDF_DbEntity> typeEntities : entitiesByType)
+		{
+			FileIO.MakeDirectory(_GetTypeDirectory(entityType));
+			m_mEntityIdsyCache.Remove(entityType);
+
+			foreach (EDF_DbEntity entity : typeEntities)
+			{
+				if (!entity.HasId())
+				{
+					result = EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+					continue;
+				}
+
+				if (m_bUseCache)
+					m_pEntityCache.Remove(entity.GetId());
+
+				EDF_EDbOperationStatusCode statusCode = WriteToDisk(entity);
+				if (statusCode != EDF_EDbOperationStatusCode.SUCCESS && result == EDF_EDbOperationStatusCode.SUCCESS)
+					result = statusCode;
+			}
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		foreach (string entityId : entityIds)
+		{
+			if (!entityId)
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+		}
+
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+		set<string> ids = GetIdsByType(entityType);
+
+		foreach (string entityId : entityIds)
+		{
+			EDF_EDbOperationStatusCode statusCode = DeleteFromDisk(entityType, entityId);
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			{
+				if (result == EDF_EDbOperationStatusCode.SUCCESS)
+					result = statusCode;
+
+				continue;
+			}
+
+			if (m_bUseCache)
+				m_pEntityCache.Remove(entityId);
+
+			ids.RemoveItem(entityId);
+		}
+
+		// Directory cleanup only once for the whole batch
+		if (ids.IsEmpty())
+			FileIO.DeleteFile(_GetTypeDirectory(entityType));
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		set<string> knownIds = GetIdsByType(entityType);
+		array<string> matchedIds();
+
+		set<string> loadIds();
+		if (EDF_DbFindConditionEvaluator.CollectEqualIds(condition, loadIds))
+		{
+			// Lone id condition, no need to read any entity
+			foreach (string loadId : loadIds)
+			{
+				if (knownIds.Contains(loadId))
+					matchedIds.Insert(loadId);
+			}
+		}
+		else
+		{
+			foreach (string knownId : knownIds)
+			{
+				EDF_DbEntity entity = ReadEntity(entityType, knownId);
+				if (entity && EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+					matchedIds.Insert(knownId);
+			}
+		}
+
+		if (matchedIds.IsEmpty())
+			return EDF_EDbOperationStatusCode.SUCCESS;
+
+		return RemoveMany(entityType, matchedIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		if (!entityId)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		if (!GetIdsByType(entityType).Contains(entityId))
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
+
+		EDF_DbEntity entity = ReadEntity(entityType, entityId);
+		if (!entity)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
+
+		if (condition && !EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+			return EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET;
+
+		// Nothing would change on disk
+		if (patch.m_aFields.IsEmpty())
+			return EDF_EDbOperationStatusCode.SUCCESS;
+
+		// The cached instance has to keep the disk state until the write succeeded
+		EDF_DbEntity patched = entity;
+		if (m_bUseCache)
+			patched = EDF_DbEntityUtils.DeepCopy(entity);
+
+		if (!patch.Apply(patched))
+			return EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED;
+
+		// One file per entity, so the file itself is still rewritten entirely
+		EDF_EDbOperationStatusCode statusCode = WriteToDisk(patched);
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS && m_bUseCache)
+			m_pEntityCache.Add(patched);
+
+		return statusCode;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
 	{
@@ -106,23 +286,9 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 
 		foreach (string entityId : loadIds)
 		{
-			EDF_DbEntity entity;
-
-			if (m_bUseCache)
-				entity = m_pEntityCache.Get(entityId);
-
-			if (!entity)
-			{
-				EDF_EDbOperationStatusCode statusCode = ReadFromDisk(entityType, entityId, entity);
-
-				if (statusCode != EDF_EDbOperationStatusCode.SUCCESS || !entity)
-					continue;
-
-				if (m_bUseCache)
-					m_pEntityCache.Add(entity);
-			}
-
-			entities.Insert(entity);
+			EDF_DbEntity entity = ReadEntity(entityType, entityId);
+			if (entity)
+				entities.Insert(entity);
 		}
 
 		if (needsFilter && condition)
@@ -149,6 +315,81 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, resultEntites);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		if (!entityId)
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+		// Unknown ids are answered from the id pool without touching the disk
+		if (!GetIdsByType(entityType).Contains(entityId))
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS);
+
+		return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, ReadEntity(entityType, entityId));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		set<string> knownIds = GetIdsByType(entityType);
+
+		array<ref EDF_DbEntity> resultEntites();
+		resultEntites.Reserve(entityIds.Count());
+
+		foreach (string entityId : entityIds)
+		{
+			if (!knownIds.Contains(entityId))
+				continue;
+
+			EDF_DbEntity entity = ReadEntity(entityType, entityId);
+			if (entity)
+				resultEntites.Insert(entity);
+		}
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, resultEntites);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return new EDF_DbCountResult(EDF_EDbOperationStatusCode.SUCCESS, CountMatches(entityType, condition, -1));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return new EDF_DbExistsResult(EDF_EDbOperationStatusCode.SUCCESS, CountMatches(entityType, condition, 1) > 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbAggregator aggregator(aggregation);
+		EDF_EDbOperationStatusCode statusCode = aggregator.Validate(entityType);
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			return new EDF_DbAggregateResult(statusCode);
+
+		set<string> loadIds();
+		bool needsFilter = false;
+		if (!EDF_DbFindConditionEvaluator.CollectEqualIds(condition, loadIds))
+		{
+			loadIds = GetIdsByType(entityType);
+			needsFilter = condition != null;
+		}
+
+		// Single pass over the entities, nothing is collected or copied
+		foreach (string entityId : loadIds)
+		{
+			EDF_DbEntity entity = ReadEntity(entityType, entityId);
+			if (!entity || (needsFilter && !EDF_DbFindConditionEvaluator.Evaluate(entity, condition)))
+				continue;
+
+			aggregator.Accumulate(entity);
+		}
+
+		return new EDF_DbAggregateResult(EDF_EDbOperationStatusCode.SUCCESS, aggregator.GetResults());
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
 	{
@@ -167,6 +408,42 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 			callback.Invoke(statusCode);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = AddOrUpdateMany(entities);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = RemoveMany(entityType, entityIds);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		// FileIO is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = Patch(entityType, entityId, patch, condition);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		EDF_EDbOperationStatusCode statusCode = RemoveWhere(entityType, condition);
+		if (callback)
+			callback.Invoke(statusCode);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
 	{
@@ -176,6 +453,135 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 			callback.Invoke(findResults.GetStatusCode(), findResults.GetEntities());
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		EDF_DbFindResultSingle<EDF_DbEntity> findResult = FindById(entityType, entityId);
+		if (!callback)
+			return;
+
+		array<ref EDF_DbEntity> resultEntities();
+		if (findResult.GetEntity())
+			resultEntities.Insert(findResult.GetEntity());
+
+		callback.Invoke(findResult.GetStatusCode(), resultEntities);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = FindByIds(entityType, entityIds);
+		if (callback)
+			callback.Invoke(findResults.GetStatusCode(), findResults.GetEntities());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		int count = CountMatches(entityType, condition, -1);
+		if (callback)
+			callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, count);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		bool exists = CountMatches(entityType, condition, 1) > 0;
+		if (callback)
+			callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, exists);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		// FileIO is blocking, re-use sync api
+		EDF_DbAggregateResult aggregateResult = Aggregate(entityType, aggregation, condition);
+		if (callback)
+			callback.Invoke(aggregateResult.GetStatusCode(), aggregateResult.GetGroups());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count from the known id pool where possible, only reads entities if the condition needs field values.
+	protected int CountMatches(typename entityType, EDF_DbFindCondition condition, int limit)
+	{
+		set<string> knownIds = GetIdsByType(entityType);
+
+		int count;
+		set<string> loadIds();
+		if (EDF_DbFindConditionEvaluator.CollectEqualIds(condition, loadIds))
+		{
+			foreach (string loadId : loadIds)
+			{
+				if (!knownIds.Contains(loadId))
+					continue;
+
+				if (++count == limit)
+					break;
+			}
+
+			return count;
+		}
+
+		// Only "not these ids" so everything else matches
+		set<string> skipIds();
+		if (!condition || EDF_DbFindConditionEvaluator.CollectSkipIds(condition, skipIds))
+		{
+			count = knownIds.Count();
+			foreach (string skipId : skipIds)
+			{
+				if (knownIds.Contains(skipId))
+					count--;
+			}
+
+			if (limit != -1)
+				return Math.Min(count, limit);
+
+			return count;
+		}
+
+		// Condition requires field values, evaluate one by one without collecting the entities
+		foreach (string entityId : knownIds)
+		{
+			EDF_DbEntity entity = ReadEntity(entityType, entityId);
+			if (!entity || !EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+				continue;
+
+			if (++count == limit)
+				break;
+		}
+
+		return count;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get entity from cache if enabled, otherwise read it from disk. Returns null on failure.
+	protected EDF_DbEntity ReadEntity(typename entityType, string entityId)
+	{
+		EDF_DbEntity entity;
+
+		if (m_bUseCache)
+		{
+			entity = m_pEntityCache.Get(entityId);
+			EDF_DbMetrics.RecordCacheAccess(this, entityType, entity != null);
+		}
+
+		if (!entity)
+		{
+			EDF_EDbOperationStatusCode statusCode = ReadFromDisk(entityType, entityId, entity);
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS || !entity)
+				return null;
+
+			if (m_bUseCache)
+				m_pEntityCache.Add(entity);
+		}
+
+		return entity;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	protected set<string> GetIdsByType(typename entityType, set<string> skipIds = null)
 	{
@@ -206,6 +612,11 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 	//------------------------------------------------------------------------------------------------
 	string _GetTypeDirectory(typename entityType)
 	{
+		// Resolved once per type, every file operation needs it
+		string typeDirectory;
+		if (m_mTypeDirectories.Find(entityType, typeDirectory))
+			return typeDirectory;
+
 		string entityName = EDF_DbName.Get(entityType);
 
 		if (entityName.EndsWith("y"))
@@ -217,13 +628,16 @@ class EDF_FileDbDriverBase : EDF_DbDriver
 			entityName += "s";
 		}
 
-		return string.Format("%1/%2", m_sDbDir, entityName);
+		typeDirectory = string.Format("%1/%2", m_sDbDir, entityName);
+		m_mTypeDirectories.Set(entityType, typeDirectory);
+		return typeDirectory;
 	}
 
 	//------------------------------------------------------------------------------------------------
 	protected string GetFileExtension();
 
 	//------------------------------------------------------------------------------------------------
+	//! Write one entity into its own file. Called per entity by the batch operations, the type directory must already exist.
 	protected EDF_EDbOperationStatusCode WriteToDisk(EDF_DbEntity entity);
 
 	//------------------------------------------------------------------------------------------------
@@ -0,0 +1,517 @@
+//! Measures every call to the wrapped driver and records it in EDF_DbMetrics.
+//! EDF_DbContext.Create() wraps all drivers with it while metrics are enabled.
+class EDF_DbDriverMetricsWrapper : EDF_DbDriver
+{
+	protected ref EDF_DbDriver m_pDriver;
+	protected string m_sDriverName;
+
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		return m_pDriver.Initialize(connectionInfo);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.AddOrUpdate(entity);
+		Record(entity.Type(), "AddOrUpdate", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.Remove(entityType, entityId);
+		Record(entityType, "Remove", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.AddOrUpdateMany(entities);
+		Record(GetCommonType(entities), "AddOrUpdateMany", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.RemoveMany(entityType, entityIds);
+		Record(entityType, "RemoveMany", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.RemoveWhere(entityType, condition);
+		Record(entityType, "RemoveWhere", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.Patch(entityType, entityId, patch, condition);
+		Record(entityType, "Patch", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Increment(typename entityType, string entityId, string fieldPath, int delta)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.Increment(entityType, entityId, fieldPath, delta);
+		Record(entityType, "Increment", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Increment(typename entityType, string entityId, string fieldPath, float delta)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.Increment(entityType, entityId, fieldPath, delta);
+		Record(entityType, "Increment", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, int expectedValue, int newValue)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.CompareAndSet(entityType, entityId, fieldPath, expectedValue, newValue);
+		Record(entityType, "CompareAndSet", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, bool expectedValue, bool newValue)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.CompareAndSet(entityType, entityId, fieldPath, expectedValue, newValue);
+		Record(entityType, "CompareAndSet", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, string expectedValue, string newValue)
+	{
+		int startTime = System.GetTickCount();
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.CompareAndSet(entityType, entityId, fieldPath, expectedValue, newValue);
+		Record(entityType, "CompareAndSet", statusCode, startTime);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		int startTime = System.GetTickCount();
+		EDF_DbFindResultMultiple<EDF_DbEntity> result = m_pDriver.FindAll(entityType, condition, orderBy, limit, offset);
+		Record(entityType, "FindAll", result.GetStatusCode(), startTime);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		int startTime = System.GetTickCount();
+		EDF_DbFindResultSingle<EDF_DbEntity> result = m_pDriver.FindById(entityType, entityId);
+		Record(entityType, "FindById", result.GetStatusCode(), startTime);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		int startTime = System.GetTickCount();
+		EDF_DbFindResultMultiple<EDF_DbEntity> result = m_pDriver.FindByIds(entityType, entityIds);
+		Record(entityType, "FindByIds", result.GetStatusCode(), startTime);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		int startTime = System.GetTickCount();
+		EDF_DbCountResult result = m_pDriver.Count(entityType, condition);
+		Record(entityType, "Count", result.GetStatusCode(), startTime);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		int startTime = System.GetTickCount();
+		EDF_DbExistsResult result = m_pDriver.Exists(entityType, condition);
+		Record(entityType, "Exists", result.GetStatusCode(), startTime);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		int startTime = System.GetTickCount();
+		EDF_DbAggregateResult result = m_pDriver.Aggregate(entityType, aggregation, condition);
+		Record(entityType, "Aggregate", result.GetStatusCode(), startTime);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.AddOrUpdateAsync(entity, new EDF_DbMetricsStatusCallback(m_sDriverName, entity.Type(), "AddOrUpdateAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.RemoveAsync(entityType, entityId, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "RemoveAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.AddOrUpdateManyAsync(entities, new EDF_DbMetricsStatusCallback(m_sDriverName, GetCommonType(entities), "AddOrUpdateManyAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.RemoveManyAsync(entityType, entityIds, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "RemoveManyAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.RemoveWhereAsync(entityType, condition, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "RemoveWhereAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		m_pDriver.PatchAsync(entityType, entityId, patch, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "PatchAsync", callback), condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void IncrementAsync(typename entityType, string entityId, string fieldPath, int delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.IncrementAsync(entityType, entityId, fieldPath, delta, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "IncrementAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void IncrementAsync(typename entityType, string entityId, string fieldPath, float delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.IncrementAsync(entityType, entityId, fieldPath, delta, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "IncrementAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, int expectedValue, int newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.CompareAndSetAsync(entityType, entityId, fieldPath, expectedValue, newValue, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "CompareAndSetAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, bool expectedValue, bool newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.CompareAndSetAsync(entityType, entityId, fieldPath, expectedValue, newValue, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "CompareAndSetAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, string expectedValue, string newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_pDriver.CompareAndSetAsync(entityType, entityId, fieldPath, expectedValue, newValue, new EDF_DbMetricsStatusCallback(m_sDriverName, entityType, "CompareAndSetAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		m_pDriver.FindAllAsync(entityType, condition, orderBy, limit, offset, CreateFindCallback(entityType, "FindAllAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		m_pDriver.FindByIdAsync(entityType, entityId, CreateFindCallback(entityType, "FindByIdAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		m_pDriver.FindByIdsAsync(entityType, entityIds, CreateFindCallback(entityType, "FindByIdsAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		m_pDriver.CountAsync(entityType, condition, new EDF_DbMetricsCountCallback(m_sDriverName, entityType, "CountAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		m_pDriver.ExistsAsync(entityType, condition, new EDF_DbMetricsExistsCallback(m_sDriverName, entityType, "ExistsAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		m_pDriver.AggregateAsync(entityType, aggregation, condition, new EDF_DbMetricsAggregateCallback(m_sDriverName, entityType, "AggregateAsync", callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbDriver GetDriver()
+	{
+		return m_pDriver;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Record(typename entityType, string operation, EDF_EDbOperationStatusCode statusCode, int startTime)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, entityType, operation, statusCode, System.GetTickCount() - startTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Chunked callbacks keep receiving the parts of drivers that stream their results
+	protected EDF_DbFindCallbackBase CreateFindCallback(typename entityType, string operation, EDF_DbFindCallbackBase callback)
+	{
+		auto chunkedCallback = EDF_DbFindCallbackChunked.Cast(callback);
+		if (chunkedCallback)
+			return new EDF_DbMetricsFindChunkedCallback(m_sDriverName, entityType, operation, chunkedCallback);
+
+		return new EDF_DbMetricsFindCallback(m_sDriverName, entityType, operation, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Batches of mixed types are recorded for EDF_DbEntity
+	protected static typename GetCommonType(notnull array<ref EDF_DbEntity> entities)
+	{
+		if (entities.IsEmpty())
+			return EDF_DbEntity;
+
+		typename entityType = entities.Get(0).Type();
+		foreach (EDF_DbEntity entity : entities)
+		{
+			if (entity.Type() != entityType)
+				return EDF_DbEntity;
+		}
+
+		return entityType;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param driverName to record the metrics under, class name of the driver by default
+	void EDF_DbDriverMetricsWrapper(notnull EDF_DbDriver driver, string driverName = string.Empty)
+	{
+		m_pDriver = driver;
+		m_sDriverName = driverName;
+		if (!m_sDriverName)
+			m_sDriverName = driver.ClassName();
+	}
+};
+
+class EDF_DbMetricsStatusCallback : EDF_DbOperationStatusOnlyCallback
+{
+	protected string m_sDriverName;
+	protected typename m_tEntityType;
+	protected string m_sOperation;
+	protected int m_iStartTime;
+	protected ref EDF_DbOperationStatusOnlyCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, EDF_EDbOperationStatusCode.SUCCESS, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, statusCode, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbMetricsStatusCallback(string driverName, typename entityType, string operation, EDF_DbOperationStatusOnlyCallback callback)
+	{
+		m_sDriverName = driverName;
+		m_tEntityType = entityType;
+		m_sOperation = operation;
+		m_iStartTime = System.GetTickCount();
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbMetricsFindCallback : EDF_DbFindCallbackBase
+{
+	protected string m_sDriverName;
+	protected typename m_tEntityType;
+	protected string m_sOperation;
+	protected int m_iStartTime;
+	protected ref EDF_DbFindCallbackBase m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, code, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbMetricsFindCallback(string driverName, typename entityType, string operation, EDF_DbFindCallbackBase callback)
+	{
+		m_sDriverName = driverName;
+		m_tEntityType = entityType;
+		m_sOperation = operation;
+		m_iStartTime = System.GetTickCount();
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbMetricsFindChunkedCallback : EDF_DbFindCallbackChunked
+{
+	protected string m_sDriverName;
+	protected typename m_tEntityType;
+	protected string m_sOperation;
+	protected int m_iStartTime;
+	protected ref EDF_DbFindCallbackChunked m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnChunk(array<ref EDF_DbEntity> chunk, Managed context)
+	{
+		m_pCallback.InvokeChunk(chunk);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnComplete(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, statusCode, System.GetTickCount() - m_iStartTime);
+		m_pCallback.InvokeComplete(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbMetricsFindChunkedCallback(string driverName, typename entityType, string operation, notnull EDF_DbFindCallbackChunked callback)
+	{
+		m_sDriverName = driverName;
+		m_tEntityType = entityType;
+		m_sOperation = operation;
+		m_iStartTime = System.GetTickCount();
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbMetricsCountCallback : EDF_DbCountCallback
+{
+	protected string m_sDriverName;
+	protected typename m_tEntityType;
+	protected string m_sOperation;
+	protected int m_iStartTime;
+	protected ref EDF_DbCountCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(int count, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, EDF_EDbOperationStatusCode.SUCCESS, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, count);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, statusCode, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbMetricsCountCallback(string driverName, typename entityType, string operation, EDF_DbCountCallback callback)
+	{
+		m_sDriverName = driverName;
+		m_tEntityType = entityType;
+		m_sOperation = operation;
+		m_iStartTime = System.GetTickCount();
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbMetricsExistsCallback : EDF_DbExistsCallback
+{
+	protected string m_sDriverName;
+	protected typename m_tEntityType;
+	protected string m_sOperation;
+	protected int m_iStartTime;
+	protected ref EDF_DbExistsCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(bool exists, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, EDF_EDbOperationStatusCode.SUCCESS, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, exists);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, statusCode, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode, false);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbMetricsExistsCallback(string driverName, typename entityType, string operation, EDF_DbExistsCallback callback)
+	{
+		m_sDriverName = driverName;
+		m_tEntityType = entityType;
+		m_sOperation = operation;
+		m_iStartTime = System.GetTickCount();
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbMetricsAggregateCallback : EDF_DbAggregateCallback
+{
+	protected string m_sDriverName;
+	protected typename m_tEntityType;
+	protected string m_sOperation;
+	protected int m_iStartTime;
+	protected ref EDF_DbAggregateCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(array<ref EDF_DbAggregateGroup> groups, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, EDF_EDbOperationStatusCode.SUCCESS, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, groups);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		EDF_DbMetrics.RecordOperation(m_sDriverName, m_tEntityType, m_sOperation, statusCode, System.GetTickCount() - m_iStartTime);
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode, null);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbMetricsAggregateCallback(string driverName, typename entityType, string operation, EDF_DbAggregateCallback callback)
+	{
+		m_sDriverName = driverName;
+		m_tEntityType = entityType;
+		m_sOperation = operation;
+		m_iStartTime = System.GetTickCount();
+		m_pCallback = callback;
+	}
+};
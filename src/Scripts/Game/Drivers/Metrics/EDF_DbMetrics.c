@@ -0,0 +1,342 @@
+//! Collects operation counts, failures, latencies, serialized bytes and cache hit rates per driver and entity type.
+//! Disabled by default. Enable with EDF_DbMetrics.s_bEnabled = true or the -DbMetrics CLI param before the db context is created.
+class EDF_DbMetrics
+{
+	static bool s_bEnabled;
+	static ref ScriptInvoker s_OnReport = new ScriptInvoker(); //!< Invoked with (array<ref EDF_DbTypeMetrics> snapshot) in the reporting interval
+
+	protected static bool s_bCliChecked;
+	protected static bool s_bLogReports;
+	protected static ref map<string, ref EDF_DbTypeMetrics> s_mMetrics;
+
+	//------------------------------------------------------------------------------------------------
+	static bool IsEnabled()
+	{
+		if (!s_bCliChecked)
+		{
+			s_bCliChecked = true;
+			if (System.IsCLIParam("DbMetrics"))
+				s_bEnabled = true;
+		}
+
+		return s_bEnabled;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record a completed driver operation
+	//! \param elapsedMs time from the call until the result was available
+	static void RecordOperation(string driverName, typename entityType, string operation, EDF_EDbOperationStatusCode statusCode, int elapsedMs)
+	{
+		if (!s_bEnabled)
+			return;
+
+		GetTypeMetrics(driverName, entityType).GetOperation(operation).Record(statusCode, elapsedMs);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record data serialized by a driver to send or store it
+	static void RecordBytes(notnull EDF_DbDriver driver, typename entityType, int bytes)
+	{
+		if (!s_bEnabled)
+			return;
+
+		GetTypeMetrics(driver.ClassName(), entityType).m_iBytesSerialized += bytes;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record a lookup in a driver internal cache
+	static void RecordCacheAccess(notnull EDF_DbDriver driver, typename entityType, bool hit)
+	{
+		if (!s_bEnabled)
+			return;
+
+		EDF_DbTypeMetrics typeMetrics = GetTypeMetrics(driver.ClassName(), entityType);
+		if (hit)
+		{
+			typeMetrics.m_iCacheHits++;
+		}
+		else
+		{
+			typeMetrics.m_iCacheMisses++;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record the amount of requests a driver holds back because too many are in flight
+	static void RecordQueueDepth(notnull EDF_DbDriver driver, typename entityType, int depth)
+	{
+		if (!s_bEnabled)
+			return;
+
+		EDF_DbTypeMetrics typeMetrics = GetTypeMetrics(driver.ClassName(), entityType);
+		typeMetrics.m_iQueueDepth = depth;
+		typeMetrics.m_iPeakQueueDepth = Math.Max(typeMetrics.m_iPeakQueueDepth, depth);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return copy of everything recorded so far
+	static array<ref EDF_DbTypeMetrics> GetSnapshot()
+	{
+		array<ref EDF_DbTypeMetrics> snapshot();
+		if (s_mMetrics)
+		{
+			foreach (string key, EDF_DbTypeMetrics typeMetrics : s_mMetrics)
+			{
+				snapshot.Insert(typeMetrics.Copy());
+			}
+		}
+
+		return snapshot;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return amount of completed operations recorded for the driver
+	static int GetOperationCount(string driverName)
+	{
+		int count;
+		if (s_mMetrics)
+		{
+			foreach (string key, EDF_DbTypeMetrics typeMetrics : s_mMetrics)
+			{
+				if (typeMetrics.m_sDriver != driverName)
+					continue;
+
+				foreach (string operation, EDF_DbOperationMetrics operationMetrics : typeMetrics.m_mOperations)
+				{
+					count += operationMetrics.m_iCount;
+				}
+			}
+		}
+
+		return count;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void Reset()
+	{
+		s_mMetrics = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Invoke s_OnReport with a snapshot in the given interval, e.g. to export it into server monitoring
+	//! \param log also print a summary of every operation
+	static void StartReporting(int intervalMs, bool log = true)
+	{
+		StopReporting();
+
+		s_bLogReports = log;
+		GetGame().GetCallqueue().CallLater(Report, intervalMs, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void StopReporting()
+	{
+		if (GetGame())
+			GetGame().GetCallqueue().Remove(Report);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void Report()
+	{
+		array<ref EDF_DbTypeMetrics> snapshot = GetSnapshot();
+
+		if (s_bLogReports)
+		{
+			foreach (EDF_DbTypeMetrics typeMetrics : snapshot)
+			{
+				typeMetrics.Log();
+			}
+		}
+
+		s_OnReport.Invoke(snapshot);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static EDF_DbTypeMetrics GetTypeMetrics(string driverName, typename entityType)
+	{
+		if (!s_mMetrics)
+			s_mMetrics = new map<string, ref EDF_DbTypeMetrics>();
+
+		string key = string.Format("%1:%2", driverName, entityType);
+		EDF_DbTypeMetrics typeMetrics = s_mMetrics.Get(key);
+		if (!typeMetrics)
+		{
+			typeMetrics = new EDF_DbTypeMetrics(driverName, entityType.ToString());
+			s_mMetrics.Set(key, typeMetrics);
+		}
+
+		return typeMetrics;
+	}
+};
+
+class EDF_DbTypeMetrics
+{
+	string m_sDriver;
+	string m_sEntityType;
+	int m_iBytesSerialized;
+	int m_iCacheHits;
+	int m_iCacheMisses;
+	int m_iQueueDepth;
+	int m_iPeakQueueDepth;
+	ref map<string, ref EDF_DbOperationMetrics> m_mOperations = new map<string, ref EDF_DbOperationMetrics>();
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbOperationMetrics GetOperation(string operation)
+	{
+		EDF_DbOperationMetrics operationMetrics = m_mOperations.Get(operation);
+		if (!operationMetrics)
+		{
+			operationMetrics = new EDF_DbOperationMetrics();
+			m_mOperations.Set(operation, operationMetrics);
+		}
+
+		return operationMetrics;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return share of cache lookups that were hits between 0 and 1, -1 if there were none
+	float GetCacheHitRate()
+	{
+		int lookups = m_iCacheHits + m_iCacheMisses;
+		if (lookups == 0)
+			return -1;
+
+		float hits = m_iCacheHits;
+		return hits / lookups;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Log()
+	{
+		foreach (string operation, EDF_DbOperationMetrics operationMetrics : m_mOperations)
+		{
+			Print(string.Format("DbMetrics %1 %2 %3: count=%4 errors=%5 avg=%6ms p95<=%7ms max=%8ms",
+				m_sDriver,
+				m_sEntityType,
+				operation,
+				operationMetrics.m_iCount,
+				operationMetrics.m_iErrors,
+				operationMetrics.GetAverageLatency(),
+				operationMetrics.GetLatencyPercentile(0.95),
+				operationMetrics.m_iMaxLatencyMs), LogLevel.NORMAL);
+		}
+
+		if (m_iBytesSerialized > 0 || m_iCacheHits > 0 || m_iCacheMisses > 0)
+			Print(string.Format("DbMetrics %1 %2: bytes=%3 cacheHitRate=%4", m_sDriver, m_sEntityType, m_iBytesSerialized, GetCacheHitRate()), LogLevel.NORMAL);
+
+		if (m_iPeakQueueDepth > 0)
+			Print(string.Format("DbMetrics %1 %2: queueDepth=%3 peakQueueDepth=%4", m_sDriver, m_sEntityType, m_iQueueDepth, m_iPeakQueueDepth), LogLevel.NORMAL);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbTypeMetrics Copy()
+	{
+		EDF_DbTypeMetrics copy(m_sDriver, m_sEntityType);
+		copy.m_iBytesSerialized = m_iBytesSerialized;
+		copy.m_iCacheHits = m_iCacheHits;
+		copy.m_iCacheMisses = m_iCacheMisses;
+		copy.m_iQueueDepth = m_iQueueDepth;
+		copy.m_iPeakQueueDepth = m_iPeakQueueDepth;
+
+		foreach (string operation, EDF_DbOperationMetrics operationMetrics : m_mOperations)
+		{
+			copy.m_mOperations.Set(operation, operationMetrics.Copy());
+		}
+
+		return copy;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTypeMetrics(string driverName, string entityType)
+	{
+		m_sDriver = driverName;
+		m_sEntityType = entityType;
+	}
+};
+
+class EDF_DbOperationMetrics
+{
+	//! Upper bounds in milliseconds of the latency histogram buckets. Slower operations are counted in one more bucket at the end.
+	static const ref array<int> LATENCY_BUCKETS_MS = {0, 1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500};
+
+	int m_iCount;
+	int m_iErrors;
+	int m_iTotalLatencyMs;
+	int m_iMaxLatencyMs;
+	ref array<int> m_aLatencyHistogram = {};
+	ref map<EDF_EDbOperationStatusCode, int> m_mErrorsByCode = new map<EDF_EDbOperationStatusCode, int>();
+
+	//------------------------------------------------------------------------------------------------
+	void Record(EDF_EDbOperationStatusCode statusCode, int elapsedMs)
+	{
+		m_iCount++;
+		m_iTotalLatencyMs += elapsedMs;
+		m_iMaxLatencyMs = Math.Max(m_iMaxLatencyMs, elapsedMs);
+
+		if (m_aLatencyHistogram.IsEmpty())
+			m_aLatencyHistogram.Resize(LATENCY_BUCKETS_MS.Count() + 1);
+
+		int bucket = LATENCY_BUCKETS_MS.Count();
+		foreach (int nBucket, int upperBound : LATENCY_BUCKETS_MS)
+		{
+			if (elapsedMs <= upperBound)
+			{
+				bucket = nBucket;
+				break;
+			}
+		}
+
+		m_aLatencyHistogram.Set(bucket, m_aLatencyHistogram.Get(bucket) + 1);
+
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			m_iErrors++;
+			m_mErrorsByCode.Set(statusCode, m_mErrorsByCode.Get(statusCode) + 1);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetAverageLatency()
+	{
+		if (m_iCount == 0)
+			return 0;
+
+		float totalLatencyMs = m_iTotalLatencyMs;
+		return totalLatencyMs / m_iCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param percentile between 0 and 1, e.g. 0.95
+	//! \return upper bound of the histogram bucket the percentile falls into, max. latency if beyond the last bound
+	int GetLatencyPercentile(float percentile)
+	{
+		int threshold = Math.Ceil(m_iCount * percentile);
+		int counted;
+		foreach (int nBucket, int bucketCount : m_aLatencyHistogram)
+		{
+			counted += bucketCount;
+			if (counted < threshold || counted == 0)
+				continue;
+
+			if (nBucket < LATENCY_BUCKETS_MS.Count())
+				return LATENCY_BUCKETS_MS.Get(nBucket);
+
+			break;
+		}
+
+		return m_iMaxLatencyMs;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbOperationMetrics Copy()
+	{
+		EDF_DbOperationMetrics copy();
+		copy.m_iCount = m_iCount;
+		copy.m_iErrors = m_iErrors;
+		copy.m_iTotalLatencyMs = m_iTotalLatencyMs;
+		copy.m_iMaxLatencyMs = m_iMaxLatencyMs;
+		copy.m_aLatencyHistogram.Copy(m_aLatencyHistogram);
+		copy.m_mErrorsByCode.Copy(m_mErrorsByCode);
+		return copy;
+	}
+};
@@ -0,0 +1,225 @@
+[EDF_DbConnectionInfoDriverType(EDF_NullDbDriver), BaseContainerProps()]
+class EDF_NullDbConnectionInfo : EDF_DbConnectionInfoBase
+{
+	[Attribute(defvalue: "0", desc: "Amount of entities every find returns. They are created once per type and shared between calls.")]
+	int m_iResults;
+
+	[Attribute(defvalue: "-1", desc: "Result of every count. -1 to use the amount of find results.")]
+	int m_iCount = -1;
+
+	[Attribute(defvalue: "0", uiwidget: UIWidgets.ComboBox, desc: "Status code every operation reports.", enums: ParamEnumArray.FromEnum(EDF_EDbOperationStatusCode))]
+	EDF_EDbOperationStatusCode m_eStatusCode;
+
+	//------------------------------------------------------------------------------------------------
+	override void ReadOptions(string connectionString)
+	{
+		super.ReadOptions(connectionString);
+
+		if (m_sDatabaseName.Length() == connectionString.Length())
+			return;
+
+		array<string> keyValuePairs();
+		int paramsStart = m_sDatabaseName.Length() + 1;
+		connectionString.Substring(paramsStart, connectionString.Length() - paramsStart).Split("&", keyValuePairs, true);
+		foreach (string keyValuePair : keyValuePairs)
+		{
+			string keyLower, value;
+			int keyIdx = keyValuePair.IndexOf("=");
+			if (keyIdx != -1)
+			{
+				keyLower = keyValuePair.Substring(0, keyIdx).Trim();
+				keyLower.ToLower();
+
+				int valueFrom = keyIdx + 1;
+				value = keyValuePair.Substring(valueFrom, keyValuePair.Length() - valueFrom).Trim();
+			}
+
+			switch (keyLower)
+			{
+				case "results":
+				{
+					m_iResults = value.ToInt(m_iResults);
+					break;
+				}
+
+				case "count":
+				{
+					m_iCount = value.ToInt(m_iCount);
+					break;
+				}
+
+				case "status":
+				{
+					string valueUpper = value;
+					valueUpper.ToUpper();
+					int statusCode = typename.StringToEnum(EDF_EDbOperationStatusCode, valueUpper);
+					if (statusCode == -1)
+					{
+						Debug.Error(string.Format("Unknown status code '%1' for the null database connection.", value));
+						break;
+					}
+
+					m_eStatusCode = statusCode;
+					break;
+				}
+			}
+		}
+	}
+};
+
+//! Accepts every operation and answers with canned results without storing anything, e.g. Null://Overhead?results=10
+//! Used as baseline to measure the cost of the framework around the drivers.
+[EDF_DbDriverName({"Null"})]
+class EDF_NullDbDriver : EDF_DbDriver
+{
+	protected EDF_EDbOperationStatusCode m_eStatusCode;
+	protected int m_iResults;
+	protected int m_iCount;
+	protected ref map<typename, ref array<ref EDF_DbEntity>> m_mResults;
+
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		m_mResults = new map<typename, ref array<ref EDF_DbEntity>>();
+
+		EDF_NullDbConnectionInfo nullConnectInfo = EDF_NullDbConnectionInfo.Cast(connectionInfo);
+		if (!nullConnectInfo)
+			return true;
+
+		m_eStatusCode = nullConnectInfo.m_eStatusCode;
+		m_iResults = nullConnectInfo.m_iResults;
+		m_iCount = nullConnectInfo.m_iCount;
+		if (m_iCount == -1)
+			m_iCount = m_iResults;
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
+	{
+		return m_eStatusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
+	{
+		return m_eStatusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(m_eStatusCode, GetResults(entityType));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		array<ref EDF_DbEntity> results = GetResults(entityType);
+		if (results.IsEmpty())
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(m_eStatusCode);
+
+		return new EDF_DbFindResultSingle<EDF_DbEntity>(m_eStatusCode, results.Get(0));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(m_eStatusCode, GetResults(entityType));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return new EDF_DbCountResult(m_eStatusCode, m_iCount);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return new EDF_DbExistsResult(m_eStatusCode, m_iCount > 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		return new EDF_DbAggregateResult(m_eStatusCode, {});
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		return m_eStatusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		return m_eStatusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		return m_eStatusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		return m_eStatusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		if (callback)
+			callback.Invoke(m_eStatusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		if (callback)
+			callback.Invoke(m_eStatusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		if (callback)
+			callback.Invoke(m_eStatusCode, GetResults(entityType));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! The canned entities are created once, so only the framework around the driver is measured.
+	//! \return new array of the shared result instances
+	protected array<ref EDF_DbEntity> GetResults(typename entityType)
+	{
+		array<ref EDF_DbEntity> results();
+		if (m_iResults <= 0 || m_eStatusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			return results;
+
+		array<ref EDF_DbEntity> cannedResults = m_mResults.Get(entityType);
+		if (!cannedResults)
+		{
+			cannedResults = {};
+			cannedResults.Reserve(m_iResults);
+			for (int nResult = 0; nResult < m_iResults; nResult++)
+			{
+				EDF_DbEntity entity = EDF_DbEntity.Cast(entityType.Spawn());
+				if (!entity)
+					break;
+
+				entity.SetId(EDF_DbEntityIdGenerator.Generate());
+				cannedResults.Insert(entity);
+			}
+
+			m_mResults.Set(entityType, cannedResults);
+		}
+
+		results.InsertAll(cannedResults);
+		return results;
+	}
+};
@@ -0,0 +1,533 @@
+//! Writes every call to the wrapped driver into a trace file that EDF_DbTraceReplayer can run against other drivers.
+//! EDF_DbContext.Create() wraps all drivers with it when started with -DbRecord=<file>.
+class EDF_DbDriverRecordingWrapper : EDF_DbDriver
+{
+	protected static int s_iRecordings;
+
+	protected ref EDF_DbDriver m_pDriver;
+	protected FileHandle m_pFile;
+	protected int m_iStartTime;
+
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		return m_pDriver.Initialize(connectionInfo);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
+	{
+		EDF_DbTraceRecord record = Begin("AddOrUpdate", entity.Type());
+		record.SetEntity(entity);
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.AddOrUpdate(entity);
+		Complete(record, statusCode);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
+	{
+		EDF_DbTraceRecord record = Begin("Remove", entityType);
+		record.m_aIds = {entityId};
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.Remove(entityType, entityId);
+		Complete(record, statusCode);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		EDF_DbTraceRecord record = Begin("FindAll", entityType);
+		SetCondition(record, condition);
+		record.m_aOrderBy = orderBy;
+		record.m_iLimit = limit;
+		record.m_iOffset = offset;
+		EDF_DbFindResultMultiple<EDF_DbEntity> result = m_pDriver.FindAll(entityType, condition, orderBy, limit, offset);
+		Complete(record, result.GetStatusCode());
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		EDF_DbTraceRecord record = Begin("FindById", entityType);
+		record.m_aIds = {entityId};
+		EDF_DbFindResultSingle<EDF_DbEntity> result = m_pDriver.FindById(entityType, entityId);
+		Complete(record, result.GetStatusCode());
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		EDF_DbTraceRecord record = Begin("FindByIds", entityType);
+		record.m_aIds = {};
+		record.m_aIds.Copy(entityIds);
+		EDF_DbFindResultMultiple<EDF_DbEntity> result = m_pDriver.FindByIds(entityType, entityIds);
+		Complete(record, result.GetStatusCode());
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbTraceRecord record = Begin("Count", entityType);
+		SetCondition(record, condition);
+		EDF_DbCountResult result = m_pDriver.Count(entityType, condition);
+		Complete(record, result.GetStatusCode());
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbTraceRecord record = Begin("Exists", entityType);
+		SetCondition(record, condition);
+		EDF_DbExistsResult result = m_pDriver.Exists(entityType, condition);
+		Complete(record, result.GetStatusCode());
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbTraceRecord record = Begin("Aggregate", entityType);
+		SetCondition(record, condition);
+		record.m_pAggregation = EDF_DbTraceAggregation.From(aggregation);
+		EDF_DbAggregateResult result = m_pDriver.Aggregate(entityType, aggregation, condition);
+		Complete(record, result.GetStatusCode());
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		EDF_DbTraceRecord record = Begin("AddOrUpdateMany", GetBatchType(entities));
+		record.SetEntities(entities);
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.AddOrUpdateMany(entities);
+		Complete(record, statusCode);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		EDF_DbTraceRecord record = Begin("RemoveMany", entityType);
+		record.m_aIds = {};
+		record.m_aIds.Copy(entityIds);
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.RemoveMany(entityType, entityIds);
+		Complete(record, statusCode);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		EDF_DbTraceRecord record = Begin("RemoveWhere", entityType);
+		SetCondition(record, condition);
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.RemoveWhere(entityType, condition);
+		Complete(record, statusCode);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbTraceRecord record = Begin("Patch", entityType);
+		record.m_aIds = {entityId};
+		record.SetPatch(patch);
+		SetCondition(record, condition);
+		EDF_EDbOperationStatusCode statusCode = m_pDriver.Patch(entityType, entityId, patch, condition);
+		Complete(record, statusCode);
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("AddOrUpdateAsync", entity.Type());
+		record.SetEntity(entity);
+		m_pDriver.AddOrUpdateAsync(entity, new EDF_DbTraceStatusCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("RemoveAsync", entityType);
+		record.m_aIds = {entityId};
+		m_pDriver.RemoveAsync(entityType, entityId, new EDF_DbTraceStatusCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("FindAllAsync", entityType);
+		SetCondition(record, condition);
+		record.m_aOrderBy = orderBy;
+		record.m_iLimit = limit;
+		record.m_iOffset = offset;
+		m_pDriver.FindAllAsync(entityType, condition, orderBy, limit, offset, CreateFindCallback(record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("FindByIdAsync", entityType);
+		record.m_aIds = {entityId};
+		m_pDriver.FindByIdAsync(entityType, entityId, CreateFindCallback(record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("FindByIdsAsync", entityType);
+		record.m_aIds = {};
+		record.m_aIds.Copy(entityIds);
+		m_pDriver.FindByIdsAsync(entityType, entityIds, CreateFindCallback(record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("CountAsync", entityType);
+		SetCondition(record, condition);
+		m_pDriver.CountAsync(entityType, condition, new EDF_DbTraceCountCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("ExistsAsync", entityType);
+		SetCondition(record, condition);
+		m_pDriver.ExistsAsync(entityType, condition, new EDF_DbTraceExistsCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("AggregateAsync", entityType);
+		SetCondition(record, condition);
+		record.m_pAggregation = EDF_DbTraceAggregation.From(aggregation);
+		m_pDriver.AggregateAsync(entityType, aggregation, condition, new EDF_DbTraceAggregateCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("AddOrUpdateManyAsync", GetBatchType(entities));
+		record.SetEntities(entities);
+		m_pDriver.AddOrUpdateManyAsync(entities, new EDF_DbTraceStatusCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("RemoveManyAsync", entityType);
+		record.m_aIds = {};
+		record.m_aIds.Copy(entityIds);
+		m_pDriver.RemoveManyAsync(entityType, entityIds, new EDF_DbTraceStatusCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		EDF_DbTraceRecord record = Begin("RemoveWhereAsync", entityType);
+		SetCondition(record, condition);
+		m_pDriver.RemoveWhereAsync(entityType, condition, new EDF_DbTraceStatusCallback(this, record, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		EDF_DbTraceRecord record = Begin("PatchAsync", entityType);
+		record.m_aIds = {entityId};
+		record.SetPatch(patch);
+		SetCondition(record, condition);
+		m_pDriver.PatchAsync(entityType, entityId, patch, new EDF_DbTraceStatusCallback(this, record, callback), condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Write the record of a completed call
+	void Complete(notnull EDF_DbTraceRecord record, EDF_EDbOperationStatusCode statusCode)
+	{
+		record.m_iDuration = System.GetTickCount() - m_iStartTime - record.m_iTime;
+		record.m_eStatusCode = statusCode;
+
+		if (m_pFile)
+			m_pFile.Write(record.ToJson() + "\n");
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected EDF_DbTraceRecord Begin(string operation, typename entityType)
+	{
+		EDF_DbTraceRecord record();
+		record.m_iTime = System.GetTickCount() - m_iStartTime;
+		record.m_sOperation = operation;
+		record.m_sEntityType = entityType.ToString();
+		return record;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Chunked callbacks keep receiving the parts of drivers that stream their results
+	protected EDF_DbFindCallbackBase CreateFindCallback(EDF_DbTraceRecord record, EDF_DbFindCallbackBase callback)
+	{
+		auto chunkedCallback = EDF_DbFindCallbackChunked.Cast(callback);
+		if (chunkedCallback)
+			return new EDF_DbTraceFindChunkedCallback(this, record, chunkedCallback);
+
+		return new EDF_DbTraceFindCallback(this, record, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void SetCondition(EDF_DbTraceRecord record, EDF_DbFindCondition condition)
+	{
+		if (condition)
+			record.m_pCondition = EDF_DbTraceCondition.From(condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Batches of mixed types are recorded for EDF_DbEntity, every entity keeps its own type in the payload
+	protected static typename GetBatchType(notnull array<ref EDF_DbEntity> entities)
+	{
+		if (entities.IsEmpty())
+			return EDF_DbEntity;
+
+		typename entityType = entities.Get(0).Type();
+		foreach (EDF_DbEntity entity : entities)
+		{
+			if (entity.Type() != entityType)
+				return EDF_DbEntity;
+		}
+
+		return entityType;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return trace file from the -DbRecord=<file> CLI param, empty if recording is not requested
+	static string GetRecordingPath()
+	{
+		string path;
+		if (!System.GetCLIParam("DbRecord", path) || !path)
+			return string.Empty;
+
+		// Every context gets its own trace
+		if (s_iRecordings > 0)
+			path = string.Format("%1.%2", path, s_iRecordings);
+
+		return path;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDriverRecordingWrapper(notnull EDF_DbDriver driver, string path)
+	{
+		m_pDriver = driver;
+		m_iStartTime = System.GetTickCount();
+		m_pFile = FileIO.OpenFile(path, FileMode.WRITE);
+		s_iRecordings++;
+
+		if (!m_pFile)
+			Debug.Error(string.Format("Unable to open database trace file '%1'.", path));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ~EDF_DbDriverRecordingWrapper()
+	{
+		if (m_pFile)
+			m_pFile.Close();
+	}
+};
+
+class EDF_DbTraceStatusCallback : EDF_DbOperationStatusOnlyCallback
+{
+	protected EDF_DbDriverRecordingWrapper m_pRecorder;
+	protected ref EDF_DbTraceRecord m_pRecord;
+	protected ref EDF_DbOperationStatusOnlyCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, EDF_EDbOperationStatusCode.SUCCESS);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, statusCode);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceStatusCallback(EDF_DbDriverRecordingWrapper recorder, EDF_DbTraceRecord record, EDF_DbOperationStatusOnlyCallback callback)
+	{
+		m_pRecorder = recorder;
+		m_pRecord = record;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbTraceFindCallback : EDF_DbFindCallbackBase
+{
+	protected EDF_DbDriverRecordingWrapper m_pRecorder;
+	protected ref EDF_DbTraceRecord m_pRecord;
+	protected ref EDF_DbFindCallbackBase m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, code);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceFindCallback(EDF_DbDriverRecordingWrapper recorder, EDF_DbTraceRecord record, EDF_DbFindCallbackBase callback)
+	{
+		m_pRecorder = recorder;
+		m_pRecord = record;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbTraceFindChunkedCallback : EDF_DbFindCallbackChunked
+{
+	protected EDF_DbDriverRecordingWrapper m_pRecorder;
+	protected ref EDF_DbTraceRecord m_pRecord;
+	protected ref EDF_DbFindCallbackChunked m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnChunk(array<ref EDF_DbEntity> chunk, Managed context)
+	{
+		m_pCallback.InvokeChunk(chunk);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnComplete(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, statusCode);
+
+		m_pCallback.InvokeComplete(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceFindChunkedCallback(EDF_DbDriverRecordingWrapper recorder, EDF_DbTraceRecord record, notnull EDF_DbFindCallbackChunked callback)
+	{
+		m_pRecorder = recorder;
+		m_pRecord = record;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbTraceCountCallback : EDF_DbCountCallback
+{
+	protected EDF_DbDriverRecordingWrapper m_pRecorder;
+	protected ref EDF_DbTraceRecord m_pRecord;
+	protected ref EDF_DbCountCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(int count, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, EDF_EDbOperationStatusCode.SUCCESS);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, count);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, statusCode);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceCountCallback(EDF_DbDriverRecordingWrapper recorder, EDF_DbTraceRecord record, EDF_DbCountCallback callback)
+	{
+		m_pRecorder = recorder;
+		m_pRecord = record;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbTraceExistsCallback : EDF_DbExistsCallback
+{
+	protected EDF_DbDriverRecordingWrapper m_pRecorder;
+	protected ref EDF_DbTraceRecord m_pRecord;
+	protected ref EDF_DbExistsCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(bool exists, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, EDF_EDbOperationStatusCode.SUCCESS);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, exists);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, statusCode);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode, false);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceExistsCallback(EDF_DbDriverRecordingWrapper recorder, EDF_DbTraceRecord record, EDF_DbExistsCallback callback)
+	{
+		m_pRecorder = recorder;
+		m_pRecord = record;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_DbTraceAggregateCallback : EDF_DbAggregateCallback
+{
+	protected EDF_DbDriverRecordingWrapper m_pRecorder;
+	protected ref EDF_DbTraceRecord m_pRecord;
+	protected ref EDF_DbAggregateCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(array<ref EDF_DbAggregateGroup> groups, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, EDF_EDbOperationStatusCode.SUCCESS);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, groups);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_pRecorder)
+			m_pRecorder.Complete(m_pRecord, statusCode);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode, null);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceAggregateCallback(EDF_DbDriverRecordingWrapper recorder, EDF_DbTraceRecord record, EDF_DbAggregateCallback callback)
+	{
+		m_pRecorder = recorder;
+		m_pRecord = record;
+		m_pCallback = callback;
+	}
+};
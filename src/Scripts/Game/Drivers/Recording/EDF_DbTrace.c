@@ -0,0 +1,750 @@
+//! One recorded driver call. Written as one compact json object per line into the trace file.
+class EDF_DbTraceRecord
+{
+	int m_iTime; //!< Milliseconds after the recording started that the call was made
+	int m_iDuration; //!< Milliseconds until the result was available
+	string m_sOperation;
+	string m_sEntityType;
+	EDF_EDbOperationStatusCode m_eStatusCode;
+	ref array<string> m_aIds;
+	ref EDF_DbTraceCondition m_pCondition;
+	ref array<ref TStringArray> m_aOrderBy;
+	int m_iLimit = -1;
+	int m_iOffset = -1;
+	ref array<ref EDF_DbTraceEntity> m_aEntities;
+	ref array<ref EDF_DbTracePatchField> m_aPatch;
+	ref EDF_DbTraceAggregation m_pAggregation;
+
+	//------------------------------------------------------------------------------------------------
+	typename GetEntityType()
+	{
+		return m_sEntityType.ToType();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbFindCondition GetCondition()
+	{
+		if (!m_pCondition)
+			return null;
+
+		return m_pCondition.Build();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	array<ref EDF_DbEntity> GetEntities()
+	{
+		array<ref EDF_DbEntity> entities();
+		if (m_aEntities)
+		{
+			foreach (EDF_DbTraceEntity traceEntity : m_aEntities)
+			{
+				if (traceEntity.m_pEntity)
+					entities.Insert(traceEntity.m_pEntity);
+			}
+		}
+
+		return entities;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatch GetPatch()
+	{
+		EDF_DbPatch patch();
+		if (m_aPatch)
+		{
+			foreach (EDF_DbTracePatchField field : m_aPatch)
+			{
+				field.Build(patch);
+			}
+		}
+
+		return patch;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregation GetAggregation()
+	{
+		if (!m_pAggregation)
+			return EDF_DbAggregation.Create();
+
+		return m_pAggregation.Build();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Copies the entity, so the payload is the state at the time of the call even if it is written later
+	void SetEntity(notnull EDF_DbEntity entity)
+	{
+		m_aEntities = {new EDF_DbTraceEntity(EDF_DbEntityUtils.DeepCopy(entity))};
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void SetEntities(notnull array<ref EDF_DbEntity> entities)
+	{
+		m_aEntities = {};
+		m_aEntities.Reserve(entities.Count());
+		foreach (EDF_DbEntity entity : entities)
+		{
+			m_aEntities.Insert(new EDF_DbTraceEntity(EDF_DbEntityUtils.DeepCopy(entity)));
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void SetPatch(notnull EDF_DbPatch patch)
+	{
+		m_aPatch = {};
+		foreach (EDF_DbPatchField field : patch.m_aFields)
+		{
+			EDF_DbTracePatchField traceField = EDF_DbTracePatchField.From(field);
+			if (traceField)
+				m_aPatch.Insert(traceField);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	string ToJson()
+	{
+		return EDF_DbEntityUtils.ToJson(this);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbTraceRecord FromJson(string data)
+	{
+		SCR_JsonLoadContext reader();
+		EDF_DbTraceRecord record();
+		if (!reader.ImportFromString(data) || !reader.ReadValue("", record))
+			return null;
+
+		return record;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue("t", m_iTime);
+		saveContext.WriteValue("d", m_iDuration);
+		saveContext.WriteValue("op", m_sOperation);
+		saveContext.WriteValue("type", m_sEntityType);
+
+		if (m_eStatusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			saveContext.WriteValue("status", m_eStatusCode);
+
+		if (m_aIds)
+			saveContext.WriteValue("ids", m_aIds);
+
+		if (m_pCondition)
+			saveContext.WriteValue("cond", m_pCondition);
+
+		if (m_aOrderBy)
+			saveContext.WriteValue("order", m_aOrderBy);
+
+		if (m_iLimit != -1)
+			saveContext.WriteValue("limit", m_iLimit);
+
+		if (m_iOffset != -1)
+			saveContext.WriteValue("offset", m_iOffset);
+
+		if (m_aEntities)
+			saveContext.WriteValue("ents", m_aEntities);
+
+		if (m_aPatch)
+			saveContext.WriteValue("patch", m_aPatch);
+
+		if (m_pAggregation)
+			saveContext.WriteValue("agg", m_pAggregation);
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationLoad(BaseSerializationLoadContext loadContext)
+	{
+		// Everything but the operation is optional
+		loadContext.ReadValue("t", m_iTime);
+		loadContext.ReadValue("d", m_iDuration);
+		loadContext.ReadValue("type", m_sEntityType);
+		loadContext.ReadValue("status", m_eStatusCode);
+		loadContext.ReadValue("ids", m_aIds);
+		loadContext.ReadValue("cond", m_pCondition);
+		loadContext.ReadValue("order", m_aOrderBy);
+		loadContext.ReadValue("limit", m_iLimit);
+		loadContext.ReadValue("offset", m_iOffset);
+		loadContext.ReadValue("ents", m_aEntities);
+		loadContext.ReadValue("patch", m_aPatch);
+		loadContext.ReadValue("agg", m_pAggregation);
+		return loadContext.ReadValue("op", m_sOperation);
+	}
+};
+
+//! Entity payload together with its type, so it can be spawned again when the trace is read
+class EDF_DbTraceEntity
+{
+	ref EDF_DbEntity m_pEntity;
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue("type", m_pEntity.Type().ToString());
+		saveContext.WriteValue("data", m_pEntity);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationLoad(BaseSerializationLoadContext loadContext)
+	{
+		string entityTypeName;
+		if (!loadContext.ReadValue("type", entityTypeName))
+			return false;
+
+		typename entityType = entityTypeName.ToType();
+		if (!entityType)
+			return false;
+
+		m_pEntity = EDF_DbEntity.Cast(entityType.Spawn());
+		return m_pEntity && loadContext.ReadValue("data", m_pEntity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceEntity(EDF_DbEntity entity = null)
+	{
+		m_pEntity = entity;
+	}
+};
+
+//! Find condition tree in a form that can be read back. Comparison values are stored as strings.
+class EDF_DbTraceCondition
+{
+	string m_sKind; //!< "and", "or", "null" or the comparison value type e.g. "int" or "array<string>"
+	string m_sFieldPath;
+	EDF_EDbFindOperator m_eOperator;
+	bool m_bFlag; //!< Strings invariant for comparisons, should be null or default for null checks
+	bool m_bPartialMatches;
+	ref array<string> m_aValues;
+	ref array<ref EDF_DbTraceCondition> m_aChildren;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbTraceCondition From(notnull EDF_DbFindCondition condition)
+	{
+		EDF_DbTraceCondition node();
+
+		EDF_DbFindConditionWithChildren withChildren = EDF_DbFindConditionWithChildren.Cast(condition);
+		if (withChildren)
+		{
+			if (EDF_DbFindOr.Cast(condition))
+			{
+				node.m_sKind = "or";
+			}
+			else
+			{
+				node.m_sKind = "and";
+			}
+
+			node.m_aChildren = {};
+			if (withChildren.m_aConditions)
+			{
+				foreach (EDF_DbFindCondition child : withChildren.m_aConditions)
+				{
+					node.m_aChildren.Insert(From(child));
+				}
+			}
+
+			return node;
+		}
+
+		EDF_DbFindCheckFieldNullOrDefault nullCheck = EDF_DbFindCheckFieldNullOrDefault.Cast(condition);
+		if (nullCheck)
+		{
+			node.m_sKind = "null";
+			node.m_sFieldPath = nullCheck.m_sFieldPath;
+			node.m_bFlag = nullCheck.m_ShouldBeNullOrDefault;
+			return node;
+		}
+
+		if (EDF_DbTraceConditionCodec<int>.Encode(condition, node, "int") ||
+			EDF_DbTraceConditionCodec<float>.Encode(condition, node, "float") ||
+			EDF_DbTraceConditionCodec<bool>.Encode(condition, node, "bool") ||
+			EDF_DbTraceConditionCodec<string>.Encode(condition, node, "string") ||
+			EDF_DbTraceConditionCodec<vector>.Encode(condition, node, "vector") ||
+			EDF_DbTraceConditionCodec<typename>.Encode(condition, node, "typename") ||
+			EDF_DbTraceConditionArrayCodec<int>.Encode(condition, node, "array<int>") ||
+			EDF_DbTraceConditionArrayCodec<float>.Encode(condition, node, "array<float>") ||
+			EDF_DbTraceConditionArrayCodec<bool>.Encode(condition, node, "array<bool>") ||
+			EDF_DbTraceConditionArrayCodec<string>.Encode(condition, node, "array<string>") ||
+			EDF_DbTraceConditionArrayCodec<vector>.Encode(condition, node, "array<vector>") ||
+			EDF_DbTraceConditionArrayCodec<typename>.Encode(condition, node, "array<typename>"))
+		{
+			return node;
+		}
+
+		Debug.Error(string.Format("Unable to record find condition of type '%1'.", condition.Type()));
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbFindCondition Build()
+	{
+		switch (m_sKind)
+		{
+			case "and":
+			case "or":
+			{
+				array<ref EDF_DbFindCondition> children();
+				if (m_aChildren)
+				{
+					foreach (EDF_DbTraceCondition child : m_aChildren)
+					{
+						EDF_DbFindCondition childCondition = child.Build();
+						if (childCondition)
+							children.Insert(childCondition);
+					}
+				}
+
+				if (m_sKind == "or")
+					return EDF_DbFindOr.Create(children);
+
+				return EDF_DbFindAnd.Create(children);
+			}
+
+			case "null":
+				return EDF_DbFindCheckFieldNullOrDefault.Create(m_sFieldPath, m_bFlag);
+
+			case "int":
+				return EDF_DbTraceConditionCodec<int>.Decode(this);
+
+			case "float":
+				return EDF_DbTraceConditionCodec<float>.Decode(this);
+
+			case "bool":
+				return EDF_DbTraceConditionCodec<bool>.Decode(this);
+
+			case "string":
+				return EDF_DbTraceConditionCodec<string>.Decode(this);
+
+			case "vector":
+				return EDF_DbTraceConditionCodec<vector>.Decode(this);
+
+			case "typename":
+				return EDF_DbTraceConditionCodec<typename>.Decode(this);
+
+			case "array<int>":
+				return EDF_DbTraceConditionArrayCodec<int>.Decode(this);
+
+			case "array<float>":
+				return EDF_DbTraceConditionArrayCodec<float>.Decode(this);
+
+			case "array<bool>":
+				return EDF_DbTraceConditionArrayCodec<bool>.Decode(this);
+
+			case "array<string>":
+				return EDF_DbTraceConditionArrayCodec<string>.Decode(this);
+
+			case "array<vector>":
+				return EDF_DbTraceConditionArrayCodec<vector>.Decode(this);
+
+			case "array<typename>":
+				return EDF_DbTraceConditionArrayCodec<typename>.Decode(this);
+		}
+
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue("k", m_sKind);
+
+		if (m_sFieldPath)
+			saveContext.WriteValue("f", m_sFieldPath);
+
+		if (m_aValues)
+			saveContext.WriteValue("o", m_eOperator);
+
+		if (m_bFlag)
+			saveContext.WriteValue("i", true);
+
+		if (m_bPartialMatches)
+			saveContext.WriteValue("p", true);
+
+		if (m_aValues)
+			saveContext.WriteValue("v", m_aValues);
+
+		if (m_aChildren)
+			saveContext.WriteValue("c", m_aChildren);
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationLoad(BaseSerializationLoadContext loadContext)
+	{
+		loadContext.ReadValue("f", m_sFieldPath);
+		loadContext.ReadValue("o", m_eOperator);
+		loadContext.ReadValue("i", m_bFlag);
+		loadContext.ReadValue("p", m_bPartialMatches);
+		loadContext.ReadValue("v", m_aValues);
+		loadContext.ReadValue("c", m_aChildren);
+		return loadContext.ReadValue("k", m_sKind);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string EncodeValue(int value)
+	{
+		return value.ToString();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string EncodeValue(float value)
+	{
+		return value.ToString();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string EncodeValue(bool value)
+	{
+		if (value)
+			return "1";
+
+		return "0";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string EncodeValue(string value)
+	{
+		return value;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string EncodeValue(vector value)
+	{
+		return string.Format("%1 %2 %3", value[0], value[1], value[2]);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string EncodeValue(typename value)
+	{
+		return value.ToString();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void DecodeValue(string data, out int value)
+	{
+		value = data.ToInt();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void DecodeValue(string data, out float value)
+	{
+		value = data.ToFloat();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void DecodeValue(string data, out bool value)
+	{
+		value = data == "1";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void DecodeValue(string data, out string value)
+	{
+		value = data;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void DecodeValue(string data, out vector value)
+	{
+		value = data.ToVector();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void DecodeValue(string data, out typename value)
+	{
+		value = data.ToType();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Combine multiple values into one string as <length>:<value> pairs, so values may contain any character
+	static string Join(notnull array<string> values)
+	{
+		string joined;
+		foreach (string value : values)
+		{
+			joined += string.Format("%1:%2", value.Length(), value);
+		}
+
+		return joined;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static array<string> Split(string joined)
+	{
+		array<string> values();
+		int position;
+		int length = joined.Length();
+		while (position < length)
+		{
+			int separator = joined.IndexOfFrom(position, ":");
+			if (separator == -1)
+				break;
+
+			int valueLength = joined.Substring(position, separator - position).ToInt();
+			values.Insert(joined.Substring(separator + 1, valueLength));
+			position = separator + 1 + valueLength;
+		}
+
+		return values;
+	}
+};
+
+class EDF_DbTraceConditionCodec<Class ValueType>
+{
+	//------------------------------------------------------------------------------------------------
+	static bool Encode(EDF_DbFindCondition condition, EDF_DbTraceCondition node, string kind)
+	{
+		EDF_DbFindCompareFieldValues<ValueType> typedCondition = EDF_DbFindCompareFieldValues<ValueType>.Cast(condition);
+		if (!typedCondition)
+			return false;
+
+		node.m_sKind = kind;
+		node.m_sFieldPath = typedCondition.m_sFieldPath;
+		node.m_eOperator = typedCondition.m_eComparisonOperator;
+		node.m_bFlag = typedCondition.m_bStringsInvariant;
+		node.m_bPartialMatches = typedCondition.m_bStringsPartialMatches;
+		node.m_aValues = {};
+		foreach (ValueType value : typedCondition.m_aComparisonValues)
+		{
+			node.m_aValues.Insert(EDF_DbTraceCondition.EncodeValue(value));
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbFindCondition Decode(EDF_DbTraceCondition node)
+	{
+		array<ValueType> values();
+		foreach (string data : node.m_aValues)
+		{
+			ValueType value;
+			EDF_DbTraceCondition.DecodeValue(data, value);
+			values.Insert(value);
+		}
+
+		return EDF_DbFindCompareFieldValues<ValueType>.Create(node.m_sFieldPath, node.m_eOperator, values, node.m_bFlag, node.m_bPartialMatches);
+	}
+};
+
+//! Same as EDF_DbTraceConditionCodec for collection comparisons, each collection is stored as one joined string
+class EDF_DbTraceConditionArrayCodec<Class ValueType>
+{
+	//------------------------------------------------------------------------------------------------
+	static bool Encode(EDF_DbFindCondition condition, EDF_DbTraceCondition node, string kind)
+	{
+		EDF_DbFindCompareFieldValues<array<ValueType>> typedCondition = EDF_DbFindCompareFieldValues<array<ValueType>>.Cast(condition);
+		if (!typedCondition)
+			return false;
+
+		node.m_sKind = kind;
+		node.m_sFieldPath = typedCondition.m_sFieldPath;
+		node.m_eOperator = typedCondition.m_eComparisonOperator;
+		node.m_bFlag = typedCondition.m_bStringsInvariant;
+		node.m_bPartialMatches = typedCondition.m_bStringsPartialMatches;
+		node.m_aValues = {};
+		foreach (array<ValueType> values : typedCondition.m_aComparisonValues)
+		{
+			array<string> encoded();
+			foreach (ValueType value : values)
+			{
+				encoded.Insert(EDF_DbTraceCondition.EncodeValue(value));
+			}
+
+			node.m_aValues.Insert(EDF_DbTraceCondition.Join(encoded));
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbFindCondition Decode(EDF_DbTraceCondition node)
+	{
+		// Keeps the collections alive until the condition holds its own references to them
+		array<ref array<ValueType>> holder();
+		array<array<ValueType>> values();
+		foreach (string joined : node.m_aValues)
+		{
+			array<ValueType> collection();
+			foreach (string data : EDF_DbTraceCondition.Split(joined))
+			{
+				ValueType value;
+				EDF_DbTraceCondition.DecodeValue(data, value);
+				collection.Insert(value);
+			}
+
+			holder.Insert(collection);
+			values.Insert(collection);
+		}
+
+		return EDF_DbFindCompareFieldValues<array<ValueType>>.Create(node.m_sFieldPath, node.m_eOperator, values, node.m_bFlag, node.m_bPartialMatches);
+	}
+};
+
+class EDF_DbTracePatchField
+{
+	string m_sOperator;
+	string m_sValueType;
+	string m_sFieldPath;
+	string m_sValue;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbTracePatchField From(notnull EDF_DbPatchField field)
+	{
+		EDF_DbTracePatchField traceField();
+		traceField.m_sOperator = field.GetOperator();
+		traceField.m_sFieldPath = field.m_sFieldPath;
+
+		if (EDF_DbTracePatchCodec<int>.Encode(field, traceField, "int") ||
+			EDF_DbTracePatchCodec<float>.Encode(field, traceField, "float") ||
+			EDF_DbTracePatchCodec<bool>.Encode(field, traceField, "bool") ||
+			EDF_DbTracePatchCodec<string>.Encode(field, traceField, "string") ||
+			EDF_DbTracePatchCodec<vector>.Encode(field, traceField, "vector"))
+		{
+			return traceField;
+		}
+
+		Debug.Error(string.Format("Unable to record patch field of type '%1'.", field.Type()));
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Build(notnull EDF_DbPatch patch)
+	{
+		switch (m_sValueType)
+		{
+			case "int":
+			{
+				EDF_DbTracePatchCodec<int>.Decode(this, patch);
+				break;
+			}
+
+			case "float":
+			{
+				EDF_DbTracePatchCodec<float>.Decode(this, patch);
+				break;
+			}
+
+			case "bool":
+			{
+				EDF_DbTracePatchCodec<bool>.Decode(this, patch);
+				break;
+			}
+
+			case "string":
+			{
+				EDF_DbTracePatchCodec<string>.Decode(this, patch);
+				break;
+			}
+
+			case "vector":
+			{
+				EDF_DbTracePatchCodec<vector>.Decode(this, patch);
+				break;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue("op", m_sOperator);
+		saveContext.WriteValue("type", m_sValueType);
+		saveContext.WriteValue("f", m_sFieldPath);
+		saveContext.WriteValue("v", m_sValue);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationLoad(BaseSerializationLoadContext loadContext)
+	{
+		return loadContext.ReadValue("op", m_sOperator) &&
+			loadContext.ReadValue("type", m_sValueType) &&
+			loadContext.ReadValue("f", m_sFieldPath) &&
+			loadContext.ReadValue("v", m_sValue);
+	}
+};
+
+class EDF_DbTracePatchCodec<Class ValueType>
+{
+	//------------------------------------------------------------------------------------------------
+	static bool Encode(EDF_DbPatchField field, EDF_DbTracePatchField traceField, string valueType)
+	{
+		EDF_DbPatchFieldValue<ValueType> valueField = EDF_DbPatchFieldValue<ValueType>.Cast(field);
+		if (valueField)
+		{
+			traceField.m_sValueType = valueType;
+			traceField.m_sValue = EDF_DbTraceCondition.EncodeValue(valueField.m_Value);
+			return true;
+		}
+
+		EDF_DbPatchFieldIncrement<ValueType> incrementField = EDF_DbPatchFieldIncrement<ValueType>.Cast(field);
+		if (incrementField)
+		{
+			traceField.m_sValueType = valueType;
+			traceField.m_sValue = EDF_DbTraceCondition.EncodeValue(incrementField.m_Delta);
+			return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void Decode(EDF_DbTracePatchField traceField, EDF_DbPatch patch)
+	{
+		ValueType value;
+		EDF_DbTraceCondition.DecodeValue(traceField.m_sValue, value);
+
+		if (traceField.m_sOperator == "$inc")
+		{
+			patch.m_aFields.Insert(new EDF_DbPatchFieldIncrement<ValueType>(traceField.m_sFieldPath, value));
+		}
+		else
+		{
+			patch.m_aFields.Insert(new EDF_DbPatchFieldValue<ValueType>(traceField.m_sFieldPath, value));
+		}
+	}
+};
+
+class EDF_DbTraceAggregation
+{
+	string m_sGroupBy;
+	ref array<int> m_aOperators = {};
+	ref array<string> m_aFieldPaths = {};
+	ref array<string> m_aAliases = {};
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbTraceAggregation From(notnull EDF_DbAggregation aggregation)
+	{
+		EDF_DbTraceAggregation traceAggregation();
+		traceAggregation.m_sGroupBy = aggregation.m_sGroupByFieldPath;
+		foreach (EDF_DbAggregateField field : aggregation.m_aFields)
+		{
+			traceAggregation.m_aOperators.Insert(field.m_eOperator);
+			traceAggregation.m_aFieldPaths.Insert(field.m_sFieldPath);
+			traceAggregation.m_aAliases.Insert(field.m_sAlias);
+		}
+
+		return traceAggregation;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregation Build()
+	{
+		EDF_DbAggregation aggregation = EDF_DbAggregation.Create();
+		if (m_sGroupBy)
+			aggregation.GroupBy(m_sGroupBy);
+
+		foreach (int nField, int operator : m_aOperators)
+		{
+			aggregation.m_aFields.Insert(new EDF_DbAggregateField(operator, m_aFieldPaths.Get(nField), m_aAliases.Get(nField)));
+		}
+
+		return aggregation;
+	}
+};
@@ -0,0 +1,367 @@
+//! Runs a trace written by EDF_DbDriverRecordingWrapper against any driver and reports throughput and latencies per operation.
+//! Use like: replayer = new EDF_DbTraceReplayer(driver); replayer.Load("$profile:session.trace"); replayer.Start();
+class EDF_DbTraceReplayer
+{
+	ref ScriptInvoker m_OnFinished = new ScriptInvoker(); //!< Invoked with (EDF_DbTraceReplayer replayer) once every call completed
+
+	protected static int s_iReplays;
+
+	protected ref EDF_DbDriver m_pDriver;
+	protected string m_sDriverName;
+	protected ref array<ref EDF_DbTraceRecord> m_aRecords = {};
+	protected int m_iNext;
+	protected int m_iStartTime;
+	protected int m_iElapsedMs;
+	protected bool m_bRealtime;
+	protected bool m_bRunning;
+	protected bool m_bMetricsEnabled;
+
+	//------------------------------------------------------------------------------------------------
+	//! Read all records of a trace file
+	//! \return false if the file could not be opened
+	bool Load(string path)
+	{
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return false;
+
+		int nLine;
+		while (!file.IsEOF())
+		{
+			string line;
+			file.ReadLine(line);
+			nLine++;
+			if (!line)
+				continue;
+
+			EDF_DbTraceRecord record = EDF_DbTraceRecord.FromJson(line);
+			if (!record)
+			{
+				Print(string.Format("Skipped malformed database trace record in line %1 of '%2'.", nLine, path), LogLevel.WARNING);
+				continue;
+			}
+
+			m_aRecords.Insert(record);
+		}
+
+		file.Close();
+		SortByTime();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AddRecord(notnull EDF_DbTraceRecord record)
+	{
+		m_aRecords.Insert(record);
+		SortByTime();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start sending the recorded calls to the driver
+	//! \param realtime issue the calls with their recorded delays instead of as fast as possible. Needs a running game.
+	void Start(bool realtime = false)
+	{
+		if (m_bRunning)
+			return;
+
+		m_bRunning = true;
+		m_bRealtime = realtime;
+		m_iNext = 0;
+
+		// Latencies are collected through the metrics registry under the name of this replay
+		m_bMetricsEnabled = EDF_DbMetrics.IsEnabled();
+		EDF_DbMetrics.s_bEnabled = true;
+
+		m_iStartTime = System.GetTickCount();
+		Tick();
+
+		if (m_bRunning && GetGame())
+			GetGame().GetCallqueue().CallLater(Tick, 0, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Stop dispatching the remaining calls without invoking m_OnFinished and give metrics collection back its previous state
+	void Stop()
+	{
+		if (!m_bRunning)
+			return;
+
+		m_iElapsedMs = System.GetTickCount() - m_iStartTime;
+		m_bRunning = false;
+		EDF_DbMetrics.s_bEnabled = m_bMetricsEnabled;
+
+		if (GetGame())
+			GetGame().GetCallqueue().Remove(Tick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsFinished()
+	{
+		return !m_bRunning && m_iNext > 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return completed calls per second from the start until the last call completed
+	float GetOpsPerSecond()
+	{
+		float operations = EDF_DbMetrics.GetOperationCount(m_sDriverName) * 1000;
+		return operations / Math.Max(m_iElapsedMs, 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetElapsedMs()
+	{
+		return m_iElapsedMs;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return latencies and failures per entity type and operation of this replay
+	array<ref EDF_DbTypeMetrics> GetMetrics()
+	{
+		array<ref EDF_DbTypeMetrics> metrics();
+		foreach (EDF_DbTypeMetrics typeMetrics : EDF_DbMetrics.GetSnapshot())
+		{
+			if (typeMetrics.m_sDriver == m_sDriverName)
+				metrics.Insert(typeMetrics);
+		}
+
+		return metrics;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Log()
+	{
+		Print(string.Format("DbReplay %1: %2 calls in %3ms, %4 ops/s", m_sDriverName, m_aRecords.Count(), m_iElapsedMs, GetOpsPerSecond()), LogLevel.NORMAL);
+		foreach (EDF_DbTypeMetrics typeMetrics : GetMetrics())
+		{
+			typeMetrics.Log();
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int elapsed = System.GetTickCount() - m_iStartTime;
+		int count = m_aRecords.Count();
+		while (m_iNext < count)
+		{
+			EDF_DbTraceRecord record = m_aRecords.Get(m_iNext);
+			if (m_bRealtime && record.m_iTime > elapsed)
+				break;
+
+			Dispatch(record);
+			m_iNext++;
+		}
+
+		if (m_iNext == count && EDF_DbMetrics.GetOperationCount(m_sDriverName) >= count)
+			Finish();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Finish()
+	{
+		Stop();
+		m_OnFinished.Invoke(this);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Dispatch(EDF_DbTraceRecord record)
+	{
+		typename entityType = record.GetEntityType();
+		string entityId;
+		if (record.m_aIds && !record.m_aIds.IsEmpty())
+			entityId = record.m_aIds.Get(0);
+
+		array<string> entityIds = record.m_aIds;
+		if (!entityIds)
+			entityIds = {};
+
+		switch (record.m_sOperation)
+		{
+			case "AddOrUpdate":
+			{
+				m_pDriver.AddOrUpdate(record.GetEntities().Get(0));
+				break;
+			}
+
+			case "AddOrUpdateAsync":
+			{
+				m_pDriver.AddOrUpdateAsync(record.GetEntities().Get(0));
+				break;
+			}
+
+			case "AddOrUpdateMany":
+			{
+				m_pDriver.AddOrUpdateMany(record.GetEntities());
+				break;
+			}
+
+			case "AddOrUpdateManyAsync":
+			{
+				m_pDriver.AddOrUpdateManyAsync(record.GetEntities());
+				break;
+			}
+
+			case "Remove":
+			{
+				m_pDriver.Remove(entityType, entityId);
+				break;
+			}
+
+			case "RemoveAsync":
+			{
+				m_pDriver.RemoveAsync(entityType, entityId);
+				break;
+			}
+
+			case "RemoveMany":
+			{
+				m_pDriver.RemoveMany(entityType, entityIds);
+				break;
+			}
+
+			case "RemoveManyAsync":
+			{
+				m_pDriver.RemoveManyAsync(entityType, entityIds);
+				break;
+			}
+
+			case "RemoveWhere":
+			{
+				m_pDriver.RemoveWhere(entityType, record.GetCondition());
+				break;
+			}
+
+			case "RemoveWhereAsync":
+			{
+				m_pDriver.RemoveWhereAsync(entityType, record.GetCondition());
+				break;
+			}
+
+			case "FindAll":
+			{
+				m_pDriver.FindAll(entityType, record.GetCondition(), record.m_aOrderBy, record.m_iLimit, record.m_iOffset);
+				break;
+			}
+
+			case "FindAllAsync":
+			{
+				m_pDriver.FindAllAsync(entityType, record.GetCondition(), record.m_aOrderBy, record.m_iLimit, record.m_iOffset);
+				break;
+			}
+
+			case "FindById":
+			{
+				m_pDriver.FindById(entityType, entityId);
+				break;
+			}
+
+			case "FindByIdAsync":
+			{
+				m_pDriver.FindByIdAsync(entityType, entityId);
+				break;
+			}
+
+			case "FindByIds":
+			{
+				m_pDriver.FindByIds(entityType, entityIds);
+				break;
+			}
+
+			case "FindByIdsAsync":
+			{
+				m_pDriver.FindByIdsAsync(entityType, entityIds);
+				break;
+			}
+
+			case "Count":
+			{
+				m_pDriver.Count(entityType, record.GetCondition());
+				break;
+			}
+
+			case "CountAsync":
+			{
+				m_pDriver.CountAsync(entityType, record.GetCondition());
+				break;
+			}
+
+			case "Exists":
+			{
+				m_pDriver.Exists(entityType, record.GetCondition());
+				break;
+			}
+
+			case "ExistsAsync":
+			{
+				m_pDriver.ExistsAsync(entityType, record.GetCondition());
+				break;
+			}
+
+			case "Aggregate":
+			{
+				m_pDriver.Aggregate(entityType, record.GetAggregation(), record.GetCondition());
+				break;
+			}
+
+			case "AggregateAsync":
+			{
+				m_pDriver.AggregateAsync(entityType, record.GetAggregation(), record.GetCondition());
+				break;
+			}
+
+			case "Patch":
+			{
+				m_pDriver.Patch(entityType, entityId, record.GetPatch(), null, record.GetCondition());
+				break;
+			}
+
+			case "PatchAsync":
+			{
+				m_pDriver.PatchAsync(entityType, entityId, record.GetPatch(), null, record.GetCondition());
+				break;
+			}
+
+			default:
+			{
+				// Keep the completion count in line with the dispatched records
+				EDF_DbMetrics.RecordOperation(m_sDriverName, entityType, record.m_sOperation, EDF_EDbOperationStatusCode.FAILURE_NOT_IMPLEMENTED, 0);
+				break;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Stable insertion sort by call time. Records are written on completion, so they are almost in order already.
+	protected void SortByTime()
+	{
+		for (int nRecord = 1, count = m_aRecords.Count(); nRecord < count; nRecord++)
+		{
+			EDF_DbTraceRecord record = m_aRecords.Get(nRecord);
+			int nTarget = nRecord;
+			while (nTarget > 0 && m_aRecords.Get(nTarget - 1).m_iTime > record.m_iTime)
+			{
+				nTarget--;
+			}
+
+			if (nTarget == nRecord)
+				continue;
+
+			m_aRecords.RemoveOrdered(nRecord);
+			m_aRecords.InsertAt(record, nTarget);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbTraceReplayer(notnull EDF_DbDriver driver)
+	{
+		m_sDriverName = string.Format("Replay%1:%2", ++s_iReplays, driver.ClassName());
+		m_pDriver = new EDF_DbDriverMetricsWrapper(driver, m_sDriverName);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ~EDF_DbTraceReplayer()
+	{
+		Stop();
+	}
+};
@@ -0,0 +1,813 @@
+enum EDF_EDbShardingMode
+{
+	ENTITY_ID, //!< Spread the entities of every type across all shards by a hash of their id
+	ENTITY_TYPE //!< Keep all entities of a type together on one shard chosen by a hash of the type name
+};
+
+[EDF_DbConnectionInfoDriverType(EDF_ShardedDbDriver), BaseContainerProps()]
+class EDF_ShardedDbConnectionInfo : EDF_DbConnectionInfoBase
+{
+	[Attribute(desc: "Databases to spread the entities across. Shards without a database name use <DatabaseName>_<index>. Must not be changed or reordered once data was stored!")]
+	ref array<ref EDF_DbConnectionInfoBase> m_aShards;
+
+	[Attribute(defvalue: "0", uiwidget: UIWidgets.ComboBox, desc: "How entities are assigned to shards.", enums: ParamEnumArray.FromEnum(EDF_EDbShardingMode))]
+	EDF_EDbShardingMode m_eMode;
+
+	//------------------------------------------------------------------------------------------------
+	override void ReadOptions(string connectionString)
+	{
+		super.ReadOptions(connectionString);
+
+		// All options not meant for the sharding are passed on to every shard
+		string shardDriverName;
+		string shardOptions;
+		int shardCount = 2;
+
+		if (m_sDatabaseName.Length() < connectionString.Length())
+		{
+			array<string> keyValuePairs();
+			int paramsStart = m_sDatabaseName.Length() + 1;
+			connectionString.Substring(paramsStart, connectionString.Length() - paramsStart).Split("&", keyValuePairs, true);
+			foreach (string keyValuePair : keyValuePairs)
+			{
+				string keyLower, value;
+				int keyIdx = keyValuePair.IndexOf("=");
+				if (keyIdx != -1)
+				{
+					keyLower = keyValuePair.Substring(0, keyIdx).Trim();
+					keyLower.ToLower();
+
+					int valueFrom = keyIdx + 1;
+					value = keyValuePair.Substring(valueFrom, keyValuePair.Length() - valueFrom).Trim();
+				}
+
+				string valueLower = value;
+				valueLower.ToLower();
+
+				switch (keyLower)
+				{
+					case "shard":
+					{
+						shardDriverName = value;
+						break;
+					}
+
+					case "shards":
+					{
+						shardCount = Math.Max(value.ToInt(shardCount), 1);
+						break;
+					}
+
+					case "by":
+					{
+						if (valueLower == "type")
+						{
+							m_eMode = EDF_EDbShardingMode.ENTITY_TYPE;
+						}
+						else
+						{
+							m_eMode = EDF_EDbShardingMode.ENTITY_ID;
+						}
+
+						break;
+					}
+
+					default:
+					{
+						if (shardOptions)
+							shardOptions += "&";
+
+						shardOptions += keyValuePair;
+					}
+				}
+			}
+		}
+
+		if (!shardDriverName)
+		{
+			Debug.Error("Sharded database connection requires a shard=<driver-name> option.");
+			return;
+		}
+
+		m_aShards = {};
+		for (int nShard = 0; nShard < shardCount; nShard++)
+		{
+			string shardConnectionString = string.Format("%1://%2_%3", shardDriverName, m_sDatabaseName, nShard);
+			if (shardOptions)
+				shardConnectionString += "?" + shardOptions;
+
+			EDF_DbConnectionInfoBase shardConnectInfo = EDF_DbConnectionInfoBase.Parse(shardConnectionString);
+			if (shardConnectInfo)
+				m_aShards.Insert(shardConnectInfo);
+		}
+	}
+};
+
+//! Spreads entities across multiple underlying drivers. Queries that can not be routed to a single shard are sent to all of them and merged.
+[EDF_DbDriverName({"Sharded"})]
+class EDF_ShardedDbDriver : EDF_DbDriver
+{
+	protected ref array<ref EDF_DbDriver> m_aShards;
+	protected EDF_EDbShardingMode m_eMode;
+
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		EDF_ShardedDbConnectionInfo shardedConnectInfo = EDF_ShardedDbConnectionInfo.Cast(connectionInfo);
+		if (!shardedConnectInfo || !shardedConnectInfo.m_aShards || shardedConnectInfo.m_aShards.IsEmpty())
+		{
+			Debug.Error("Sharded database driver requires at least one shard connection info.");
+			return false;
+		}
+
+		m_eMode = shardedConnectInfo.m_eMode;
+		m_aShards = {};
+
+		foreach (int nShard, EDF_DbConnectionInfoBase shardConnectInfo : shardedConnectInfo.m_aShards)
+		{
+			if (!shardConnectInfo.m_sDatabaseName)
+				shardConnectInfo.m_sDatabaseName = string.Format("%1_%2", shardedConnectInfo.m_sDatabaseName, nShard);
+
+			typename driverType = EDF_DbConnectionInfoDriverType.GetDriverType(shardConnectInfo.Type());
+			EDF_DbDriver driver = EDF_DbDriver.Cast(driverType.Spawn());
+			if (!driver || driver.IsInherited(EDF_ShardedDbDriver) || !driver.Initialize(shardConnectInfo))
+			{
+				Debug.Error(string.Format("Unable to initialize shard %1 database driver of type '%2'.", nShard, driverType));
+				return false;
+			}
+
+			m_aShards.Insert(driver);
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
+	{
+		if (!entity.HasId())
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		return GetShard(entity.Type(), entity.GetId()).AddOrUpdate(entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
+	{
+		if (!entityId)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		return GetShard(entityType, entityId).Remove(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		foreach (EDF_DbEntity entity : entities)
+		{
+			if (!entity.HasId())
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+		}
+
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+		foreach (int nShard, array<ref EDF_DbEntity> shardEntities : GroupEntitiesByShard(entities))
+		{
+			EDF_EDbOperationStatusCode statusCode = m_aShards.Get(nShard).AddOrUpdateMany(shardEntities);
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS && result == EDF_EDbOperationStatusCode.SUCCESS)
+				result = statusCode;
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		foreach (string entityId : entityIds)
+		{
+			if (!entityId)
+				return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+		}
+
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+		foreach (int nShard, array<string> shardIds : GroupIdsByShard(entityType, entityIds))
+		{
+			EDF_EDbOperationStatusCode statusCode = m_aShards.Get(nShard).RemoveMany(entityType, shardIds);
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS && result == EDF_EDbOperationStatusCode.SUCCESS)
+				result = statusCode;
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		EDF_EDbOperationStatusCode result = EDF_EDbOperationStatusCode.SUCCESS;
+		foreach (int nShard : GetQueryShards(entityType, condition))
+		{
+			EDF_EDbOperationStatusCode statusCode = m_aShards.Get(nShard).RemoveWhere(entityType, condition);
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS && result == EDF_EDbOperationStatusCode.SUCCESS)
+				result = statusCode;
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		if (!entityId)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		return GetShard(entityType, entityId).Patch(entityType, entityId, patch, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		array<int> shardIndices = GetQueryShards(entityType, condition);
+		if (shardIndices.Count() == 1)
+			return m_aShards.Get(shardIndices.Get(0)).FindAll(entityType, condition, orderBy, limit, offset);
+
+		// Any shard could hold the entire requested page, so each has to return everything up to the end of it
+		int shardLimit = GetShardLimit(limit, offset);
+
+		array<ref EDF_DbEntity> entities();
+		foreach (int nShard : shardIndices)
+		{
+			EDF_DbFindResultMultiple<EDF_DbEntity> findResults = m_aShards.Get(nShard).FindAll(entityType, condition, orderBy, shardLimit);
+			if (!findResults.IsSuccess())
+				return findResults;
+
+			foreach (EDF_DbEntity entity : findResults.GetEntities())
+			{
+				entities.Insert(entity);
+			}
+		}
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, MergeResults(entities, orderBy, limit, offset));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		if (!entityId)
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+		return GetShard(entityType, entityId).FindById(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		map<int, ref array<string>> idsByShard = GroupIdsByShard(entityType, entityIds);
+		if (idsByShard.Count() == 1)
+			return m_aShards.Get(idsByShard.GetKey(0)).FindByIds(entityType, entityIds);
+
+		array<ref EDF_DbEntity> entities();
+		foreach (int nShard, array<string> shardIds : idsByShard)
+		{
+			EDF_DbFindResultMultiple<EDF_DbEntity> findResults = m_aShards.Get(nShard).FindByIds(entityType, shardIds);
+			if (!findResults.IsSuccess())
+				return findResults;
+
+			foreach (EDF_DbEntity entity : findResults.GetEntities())
+			{
+				entities.Insert(entity);
+			}
+		}
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, EDF_DbEntityUtils.OrderByIds(entities, entityIds));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		int count;
+		foreach (int nShard : GetQueryShards(entityType, condition))
+		{
+			EDF_DbCountResult countResult = m_aShards.Get(nShard).Count(entityType, condition);
+			if (!countResult.IsSuccess())
+				return countResult;
+
+			count += countResult.GetCount();
+		}
+
+		return new EDF_DbCountResult(EDF_EDbOperationStatusCode.SUCCESS, count);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		foreach (int nShard : GetQueryShards(entityType, condition))
+		{
+			EDF_DbExistsResult existsResult = m_aShards.Get(nShard).Exists(entityType, condition);
+			if (!existsResult.IsSuccess() || existsResult.Exists())
+				return existsResult;
+		}
+
+		return new EDF_DbExistsResult(EDF_EDbOperationStatusCode.SUCCESS, false);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		// Averages of partial results can not be combined, so only a single shard can aggregate natively
+		array<int> shardIndices = GetQueryShards(entityType, condition);
+		if (shardIndices.Count() == 1)
+			return m_aShards.Get(shardIndices.Get(0)).Aggregate(entityType, aggregation, condition);
+
+		return super.Aggregate(entityType, aggregation, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		if (!entity.HasId())
+		{
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+			return;
+		}
+
+		GetShard(entity.Type(), entity.GetId()).AddOrUpdateAsync(entity, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		if (!entityId)
+		{
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+			return;
+		}
+
+		GetShard(entityType, entityId).RemoveAsync(entityType, entityId, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		foreach (EDF_DbEntity entity : entities)
+		{
+			if (!entity.HasId())
+			{
+				if (callback)
+					callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+				return;
+			}
+		}
+
+		map<int, ref array<ref EDF_DbEntity>> entitiesByShard = GroupEntitiesByShard(entities);
+		EDF_DbOperationStatusMultiCallback multiCallback(entitiesByShard.Count(), callback);
+		foreach (int nShard, array<ref EDF_DbEntity> shardEntities : entitiesByShard)
+		{
+			m_aShards.Get(nShard).AddOrUpdateManyAsync(shardEntities, multiCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		foreach (string entityId : entityIds)
+		{
+			if (!entityId)
+			{
+				if (callback)
+					callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+				return;
+			}
+		}
+
+		map<int, ref array<string>> idsByShard = GroupIdsByShard(entityType, entityIds);
+		EDF_DbOperationStatusMultiCallback multiCallback(idsByShard.Count(), callback);
+		foreach (int nShard, array<string> shardIds : idsByShard)
+		{
+			m_aShards.Get(nShard).RemoveManyAsync(entityType, shardIds, multiCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		array<int> shardIndices = GetQueryShards(entityType, condition);
+		EDF_DbOperationStatusMultiCallback multiCallback(shardIndices.Count(), callback);
+		foreach (int nShard : shardIndices)
+		{
+			m_aShards.Get(nShard).RemoveWhereAsync(entityType, condition, multiCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		if (!entityId)
+		{
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET);
+
+			return;
+		}
+
+		GetShard(entityType, entityId).PatchAsync(entityType, entityId, patch, callback, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		array<int> shardIndices = GetQueryShards(entityType, condition);
+		if (shardIndices.Count() == 1)
+		{
+			m_aShards.Get(shardIndices.Get(0)).FindAllAsync(entityType, condition, orderBy, limit, offset, callback);
+			return;
+		}
+
+		EDF_ShardedDbDriverFindCallback mergeCallback(shardIndices.Count(), callback);
+		mergeCallback.SetPage(orderBy, limit, offset);
+
+		int shardLimit = GetShardLimit(limit, offset);
+		foreach (int nShard : shardIndices)
+		{
+			m_aShards.Get(nShard).FindAllAsync(entityType, condition, orderBy, shardLimit, -1, mergeCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		if (!entityId)
+		{
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET, new array<ref EDF_DbEntity>());
+
+			return;
+		}
+
+		GetShard(entityType, entityId).FindByIdAsync(entityType, entityId, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		map<int, ref array<string>> idsByShard = GroupIdsByShard(entityType, entityIds);
+		if (idsByShard.IsEmpty())
+		{
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, new array<ref EDF_DbEntity>());
+
+			return;
+		}
+
+		if (idsByShard.Count() == 1)
+		{
+			m_aShards.Get(idsByShard.GetKey(0)).FindByIdsAsync(entityType, entityIds, callback);
+			return;
+		}
+
+		EDF_ShardedDbDriverFindCallback mergeCallback(idsByShard.Count(), new EDF_DbFindByIdsOrderCallback(entityIds, callback));
+		foreach (int nShard, array<string> shardIds : idsByShard)
+		{
+			m_aShards.Get(nShard).FindByIdsAsync(entityType, shardIds, mergeCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		array<int> shardIndices = GetQueryShards(entityType, condition);
+		if (shardIndices.Count() == 1)
+		{
+			m_aShards.Get(shardIndices.Get(0)).CountAsync(entityType, condition, callback);
+			return;
+		}
+
+		EDF_ShardedDbDriverCountCallback sumCallback(shardIndices.Count(), callback);
+		foreach (int nShard : shardIndices)
+		{
+			m_aShards.Get(nShard).CountAsync(entityType, condition, sumCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		array<int> shardIndices = GetQueryShards(entityType, condition);
+		if (shardIndices.Count() == 1)
+		{
+			m_aShards.Get(shardIndices.Get(0)).ExistsAsync(entityType, condition, callback);
+			return;
+		}
+
+		EDF_ShardedDbDriverExistsCallback anyCallback(shardIndices.Count(), callback);
+		foreach (int nShard : shardIndices)
+		{
+			m_aShards.Get(nShard).ExistsAsync(entityType, condition, anyCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		array<int> shardIndices = GetQueryShards(entityType, condition);
+		if (shardIndices.Count() == 1)
+		{
+			m_aShards.Get(shardIndices.Get(0)).AggregateAsync(entityType, aggregation, condition, callback);
+			return;
+		}
+
+		super.AggregateAsync(entityType, aggregation, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return amount of underlying drivers
+	int GetShardCount()
+	{
+		return m_aShards.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return the underlying driver the entity is stored in
+	EDF_DbDriver GetShard(typename entityType, string entityId)
+	{
+		return m_aShards.Get(GetShardIndex(entityType, entityId));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetShardIndex(typename entityType, string entityId)
+	{
+		if (m_aShards.Count() == 1)
+			return 0;
+
+		if (m_eMode == EDF_EDbShardingMode.ENTITY_TYPE)
+			return GetHashIndex(EDF_DbName.Get(entityType));
+
+		return GetHashIndex(entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Stable across sessions and platforms, so entities are always looked up on the shard they were stored on
+	protected int GetHashIndex(string key)
+	{
+		int hash = 5381;
+		for (int nChar = 0, length = key.Length(); nChar < length; nChar++)
+		{
+			hash = hash * 33 + key.ToAscii(nChar);
+		}
+
+		int shardCount = m_aShards.Count();
+		int index = hash % shardCount;
+		if (index < 0)
+			index += shardCount;
+
+		return index;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Shards that can contain matches for the condition. Pure id conditions are only sent to the shards of those ids.
+	protected array<int> GetQueryShards(typename entityType, EDF_DbFindCondition condition)
+	{
+		if (m_eMode == EDF_EDbShardingMode.ENTITY_TYPE || m_aShards.Count() == 1)
+			return {GetShardIndex(entityType, string.Empty)};
+
+		set<string> loadIds(), skipIds();
+		if (EDF_DbFindConditionEvaluator.CollectConditionIds(condition, loadIds, skipIds) &&
+			!loadIds.IsEmpty() &&
+			skipIds.IsEmpty())
+		{
+			set<int> shardSet();
+			foreach (string loadId : loadIds)
+			{
+				shardSet.Insert(GetShardIndex(entityType, loadId));
+			}
+
+			array<int> shardIndices();
+			for (int nShard = 0, count = m_aShards.Count(); nShard < count; nShard++)
+			{
+				if (shardSet.Contains(nShard))
+					shardIndices.Insert(nShard);
+			}
+
+			return shardIndices;
+		}
+
+		array<int> shardIndices();
+		for (int nShard = 0, count = m_aShards.Count(); nShard < count; nShard++)
+		{
+			shardIndices.Insert(nShard);
+		}
+
+		return shardIndices;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected map<int, ref array<string>> GroupIdsByShard(typename entityType, notnull array<string> entityIds)
+	{
+		map<int, ref array<string>> idsByShard();
+		foreach (string entityId : entityIds)
+		{
+			int nShard = GetShardIndex(entityType, entityId);
+			array<string> shardIds = idsByShard.Get(nShard);
+			if (!shardIds)
+			{
+				shardIds = {};
+				idsByShard.Set(nShard, shardIds);
+			}
+
+			shardIds.Insert(entityId);
+		}
+
+		return idsByShard;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected map<int, ref array<ref EDF_DbEntity>> GroupEntitiesByShard(notnull array<ref EDF_DbEntity> entities)
+	{
+		map<int, ref array<ref EDF_DbEntity>> entitiesByShard();
+		foreach (EDF_DbEntity entity : entities)
+		{
+			int nShard = GetShardIndex(entity.Type(), entity.GetId());
+			array<ref EDF_DbEntity> shardEntities = entitiesByShard.Get(nShard);
+			if (!shardEntities)
+			{
+				shardEntities = {};
+				entitiesByShard.Set(nShard, shardEntities);
+			}
+
+			shardEntities.Insert(entity);
+		}
+
+		return entitiesByShard;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static int GetShardLimit(int limit, int offset)
+	{
+		if (limit == -1)
+			return -1;
+
+		return Math.Max(offset, 0) + limit;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Combine the results of all shards and apply the requested page on them
+	static array<ref EDF_DbEntity> MergeResults(notnull array<ref EDF_DbEntity> entities, array<ref TStringArray> orderBy, int limit, int offset)
+	{
+		if (orderBy)
+			entities = EDF_DbEntitySorter.GetSorted(entities, orderBy);
+
+		if (limit == -1 && offset <= 0)
+			return entities;
+
+		array<ref EDF_DbEntity> resultEntities();
+		foreach (int idx, EDF_DbEntity entity : entities)
+		{
+			if (limit != -1 && resultEntities.Count() >= limit)
+				break;
+
+			if (offset != -1 && idx < offset)
+				continue;
+
+			resultEntities.Insert(entity);
+		}
+
+		return resultEntities;
+	}
+};
+
+class EDF_ShardedDbDriverFindCallback : EDF_DbFindCallbackBase
+{
+	protected int m_iPending;
+	protected EDF_EDbOperationStatusCode m_eStatusCode;
+	protected ref array<ref EDF_DbEntity> m_aEntities = {};
+	protected ref array<ref TStringArray> m_aOrderBy;
+	protected int m_iLimit = -1;
+	protected int m_iOffset = -1;
+	protected ref EDF_DbFindCallbackBase m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		if (code != EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			if (m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS)
+				m_eStatusCode = code;
+		}
+		else if (findResults)
+		{
+			foreach (EDF_DbEntity entity : findResults)
+			{
+				m_aEntities.Insert(entity);
+			}
+		}
+
+		if (--m_iPending > 0 || !m_pCallback)
+			return;
+
+		if (m_eStatusCode != EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			m_pCallback.Invoke(m_eStatusCode, new array<ref EDF_DbEntity>());
+			return;
+		}
+
+		m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, EDF_ShardedDbDriver.MergeResults(m_aEntities, m_aOrderBy, m_iLimit, m_iOffset));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void SetPage(array<ref TStringArray> orderBy, int limit, int offset)
+	{
+		m_aOrderBy = orderBy;
+		m_iLimit = limit;
+		m_iOffset = offset;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_ShardedDbDriverFindCallback(int pending, EDF_DbFindCallbackBase callback)
+	{
+		m_iPending = pending;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_ShardedDbDriverCountCallback : EDF_DbCountCallback
+{
+	protected int m_iPending;
+	protected int m_iCount;
+	protected EDF_EDbOperationStatusCode m_eStatusCode;
+	protected ref EDF_DbCountCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(int count, Managed context)
+	{
+		m_iCount += count;
+		Complete();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS)
+			m_eStatusCode = statusCode;
+
+		Complete();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Complete()
+	{
+		if (--m_iPending == 0 && m_pCallback)
+			m_pCallback.Invoke(m_eStatusCode, m_iCount);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_ShardedDbDriverCountCallback(int pending, EDF_DbCountCallback callback)
+	{
+		m_iPending = pending;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_ShardedDbDriverExistsCallback : EDF_DbExistsCallback
+{
+	protected int m_iPending;
+	protected bool m_bExists;
+	protected EDF_EDbOperationStatusCode m_eStatusCode;
+	protected ref EDF_DbExistsCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(bool exists, Managed context)
+	{
+		if (exists)
+			m_bExists = true;
+
+		Complete();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		if (m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS)
+			m_eStatusCode = statusCode;
+
+		Complete();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Complete()
+	{
+		if (--m_iPending == 0 && m_pCallback)
+			m_pCallback.Invoke(m_eStatusCode, m_bExists);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_ShardedDbDriverExistsCallback(int pending, EDF_DbExistsCallback callback)
+	{
+		m_iPending = pending;
+		m_pCallback = callback;
+	}
+};
@@ -0,0 +1,1338 @@
+[EDF_DbConnectionInfoDriverType(EDF_TieredDbDriver), BaseContainerProps()]
+class EDF_TieredDbConnectionInfo : EDF_DbConnectionInfoBase
+{
+	[Attribute(desc: "Persistent storage behind the in-memory hot tier. Uses the database name of the tiered connection if it has none set.")]
+	ref EDF_DbConnectionInfoBase m_pColdStorage;
+
+	[Attribute(defvalue: "10000", desc: "Max. entities kept in memory. The least recently used ones are demoted once exceeded. -1 for no limit.")]
+	int m_iMaxHotEntities = 10000;
+
+	[Attribute(desc: "Buffer writes and pass them on to the cold storage in the background instead of writing them through right away.")]
+	bool m_bWriteBehind;
+
+	[Attribute(defvalue: "5000", desc: "Interval in milliseconds in which buffered writes are flushed to the cold storage when writing behind.")]
+	int m_iFlushIntervalMs = 5000;
+
+	//------------------------------------------------------------------------------------------------
+	override void ReadOptions(string connectionString)
+	{
+		super.ReadOptions(connectionString);
+
+		// All options not meant for the tiering are passed on to the cold storage
+		string coldDriverName;
+		string coldOptions;
+
+		if (m_sDatabaseName.Length() < connectionString.Length())
+		{
+			array<string> keyValuePairs();
+			int paramsStart = m_sDatabaseName.Length() + 1;
+			connectionString.Substring(paramsStart, connectionString.Length() - paramsStart).Split("&", keyValuePairs, true);
+			foreach (string keyValuePair : keyValuePairs)
+			{
+				string keyLower, value;
+				int keyIdx = keyValuePair.IndexOf("=");
+				if (keyIdx != -1)
+				{
+					keyLower = keyValuePair.Substring(0, keyIdx).Trim();
+					keyLower.ToLower();
+
+					int valueFrom = keyIdx + 1;
+					value = keyValuePair.Substring(valueFrom, keyValuePair.Length() - valueFrom).Trim();
+				}
+
+				string valueLower = value;
+				valueLower.ToLower();
+
+				switch (keyLower)
+				{
+					case "cold":
+					{
+						coldDriverName = value;
+						break;
+					}
+
+					case "hotlimit":
+					{
+						m_iMaxHotEntities = value.ToInt(m_iMaxHotEntities);
+						break;
+					}
+
+					case "write":
+					{
+						m_bWriteBehind = valueLower == "behind";
+						break;
+					}
+
+					case "flushinterval":
+					{
+						m_iFlushIntervalMs = value.ToInt(m_iFlushIntervalMs);
+						break;
+					}
+
+					default:
+					{
+						if (coldOptions)
+							coldOptions += "&";
+
+						coldOptions += keyValuePair;
+					}
+				}
+			}
+		}
+
+		if (!coldDriverName)
+		{
+			Debug.Error("Tiered database connection requires a cold=<driver-name> option.");
+			return;
+		}
+
+		string coldConnectionString = string.Format("%1://%2", coldDriverName, m_sDatabaseName);
+		if (coldOptions)
+			coldConnectionString += "?" + coldOptions;
+
+		m_pColdStorage = EDF_DbConnectionInfoBase.Parse(coldConnectionString);
+	}
+};
+
+//! Keeps recently used entities in an in-memory hot tier in front of a persistent cold tier driver.
+//! The hot tier always holds the latest state of the entities it contains, so it assumes to be the only writer of the cold storage.
+[EDF_DbDriverName({"Tiered"})]
+class EDF_TieredDbDriver : EDF_DbDriver
+{
+	protected static int s_iHotTierCount;
+
+	protected ref EDF_InMemoryDbDriver m_pHotTier;
+	protected ref EDF_DbDriver m_pColdTier; // Buffer wrapper around the cold driver when writing behind
+	protected ref EDF_TieredDbDriverAccessOrder m_pAccessOrder;
+	protected ref set<typename> m_aCompleteTypes; // Types entirely loaded into the hot tier, queries on them are answered from memory
+	protected ref map<typename, ref EDF_TieredDbDriverPendingWrites> m_mPendingWrites; // Types with async cold writes not completed yet
+	protected int m_iMaxHotEntities;
+
+	//------------------------------------------------------------------------------------------------
+	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
+	{
+		EDF_TieredDbConnectionInfo tieredConnectInfo = EDF_TieredDbConnectionInfo.Cast(connectionInfo);
+		if (!tieredConnectInfo || !tieredConnectInfo.m_pColdStorage)
+		{
+			Debug.Error("Tiered database driver requires cold storage connection info.");
+			return false;
+		}
+
+		EDF_DbConnectionInfoBase coldConnectInfo = tieredConnectInfo.m_pColdStorage;
+		if (!coldConnectInfo.m_sDatabaseName)
+			coldConnectInfo.m_sDatabaseName = tieredConnectInfo.m_sDatabaseName;
+
+		typename coldDriverType = EDF_DbConnectionInfoDriverType.GetDriverType(coldConnectInfo.Type());
+		EDF_DbDriver coldDriver = EDF_DbDriver.Cast(coldDriverType.Spawn());
+		if (!coldDriver || coldDriver.IsInherited(EDF_TieredDbDriver) || !coldDriver.Initialize(coldConnectInfo))
+		{
+			Debug.Error(string.Format("Unable to initialize cold tier database driver of type '%1'.", coldDriverType));
+			return false;
+		}
+
+		if (tieredConnectInfo.m_bWriteBehind)
+		{
+			m_pColdTier = new EDF_DbDriverBufferWrapper(coldDriver);
+			if (GetGame() && tieredConnectInfo.m_iFlushIntervalMs > 0)
+				GetGame().GetCallqueue().CallLater(Flush, tieredConnectInfo.m_iFlushIntervalMs, true, false);
+		}
+		else
+		{
+			m_pColdTier = coldDriver;
+		}
+
+		// Own hot tier database per driver instance, so the access order always matches its content
+		EDF_InMemoryDbConnectionInfo hotConnectInfo();
+		hotConnectInfo.m_sDatabaseName = string.Format("%1.hot%2", tieredConnectInfo.m_sDatabaseName, s_iHotTierCount++);
+		m_pHotTier = new EDF_InMemoryDbDriver();
+		m_pHotTier.Initialize(hotConnectInfo);
+
+		m_pAccessOrder = new EDF_TieredDbDriverAccessOrder();
+		m_aCompleteTypes = new set<typename>();
+		m_mPendingWrites = new map<typename, ref EDF_TieredDbDriverPendingWrites>();
+		m_iMaxHotEntities = tieredConnectInfo.m_iMaxHotEntities;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
+	{
+		EDF_EDbOperationStatusCode statusCode = m_pColdTier.AddOrUpdate(entity);
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			Store(entity);
+			SupersedePending(entity.Type(), entity.GetId(), entity);
+		}
+
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
+	{
+		EDF_EDbOperationStatusCode statusCode = m_pColdTier.Remove(entityType, entityId);
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS || statusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND)
+		{
+			Discard(entityType, entityId);
+			SupersedePending(entityType, entityId, null);
+		}
+
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		EDF_EDbOperationStatusCode statusCode = m_pColdTier.AddOrUpdateMany(entities);
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			foreach (EDF_DbEntity entity : entities)
+			{
+				Store(entity);
+				SupersedePending(entity.Type(), entity.GetId(), entity);
+			}
+		}
+		else
+		{
+			// Unknown which of them were applied
+			foreach (EDF_DbEntity entity : entities)
+			{
+				if (entity.HasId())
+					Invalidate(entity.Type(), {entity.GetId()});
+			}
+		}
+
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		EDF_EDbOperationStatusCode statusCode = m_pColdTier.RemoveMany(entityType, entityIds);
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS || statusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND)
+		{
+			foreach (string entityId : entityIds)
+			{
+				Discard(entityType, entityId);
+				SupersedePending(entityType, entityId, null);
+			}
+		}
+		else
+		{
+			Invalidate(entityType, entityIds);
+		}
+
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		EDF_EDbOperationStatusCode statusCode = m_pColdTier.RemoveWhere(entityType, condition);
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			DiscardWhere(entityType, condition);
+
+			EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+			if (pendingWrites)
+				pendingWrites.SupersedeWhere(condition);
+		}
+		else
+		{
+			Invalidate(entityType, GetHotIds(entityType, condition));
+		}
+
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = m_pHotTier.Patch(entityType, entityId, patch, condition);
+		if (statusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND)
+		{
+			if (m_aCompleteTypes.Contains(entityType))
+				return statusCode;
+
+			return m_pColdTier.Patch(entityType, entityId, patch, condition);
+		}
+
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			return statusCode;
+
+		// Pass on the patched hot state entirely so both tiers stay the same
+		m_pAccessOrder.Touch(entityType, entityId);
+		EDF_DbEntity patched = m_pHotTier.FindById(entityType, entityId).GetEntity();
+		statusCode = m_pColdTier.AddOrUpdate(patched);
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			SupersedePending(entityType, entityId, patched);
+		}
+		else
+		{
+			Invalidate(entityType, {entityId});
+		}
+
+		return statusCode;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		if (m_aCompleteTypes.Contains(entityType))
+			return m_pHotTier.FindAll(entityType, condition, orderBy, limit, offset);
+
+		EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+		if (pendingWrites)
+		{
+			// Limit and offset can only be applied once the pending writes are in
+			EDF_DbFindResultMultiple<EDF_DbEntity> coldResults = m_pColdTier.FindAll(entityType, condition, orderBy);
+			if (!coldResults.IsSuccess())
+				return coldResults;
+
+			array<ref EDF_DbEntity> entities = pendingWrites.Overlay(coldResults.GetEntities(), condition, orderBy, limit, offset);
+			Promote(entityType, entities, IsLoadingAll(condition, limit, offset));
+			return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, entities);
+		}
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = m_pColdTier.FindAll(entityType, condition, orderBy, limit, offset);
+		if (findResults.IsSuccess())
+			Promote(entityType, findResults.GetEntities(), IsLoadingAll(condition, limit, offset));
+
+		return findResults;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		EDF_DbFindResultSingle<EDF_DbEntity> hotResult = m_pHotTier.FindById(entityType, entityId);
+		EDF_DbMetrics.RecordCacheAccess(this, entityType, hotResult.GetEntity() != null);
+		if (hotResult.GetEntity())
+		{
+			m_pAccessOrder.Touch(entityType, entityId);
+			return hotResult;
+		}
+
+		if (!hotResult.IsSuccess() || m_aCompleteTypes.Contains(entityType))
+			return hotResult;
+
+		EDF_DbEntity written;
+		if (FindPending(entityType, entityId, written))
+			return new EDF_DbFindResultSingle<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, written);
+
+		EDF_DbFindResultSingle<EDF_DbEntity> findResult = m_pColdTier.FindById(entityType, entityId);
+		if (findResult.GetEntity())
+		{
+			array<ref EDF_DbEntity> promoted = {findResult.GetEntity()};
+			Promote(entityType, promoted);
+		}
+
+		return findResult;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		EDF_DbFindResultMultiple<EDF_DbEntity> hotResults = m_pHotTier.FindByIds(entityType, entityIds);
+		array<ref EDF_DbEntity> entities = hotResults.GetEntities();
+		TouchAll(entityType, entities);
+
+		array<string> coldIds = GetMissingIds(entityIds, entities);
+		if (EDF_DbMetrics.s_bEnabled)
+		{
+			foreach (EDF_DbEntity hotEntity : entities)
+			{
+				EDF_DbMetrics.RecordCacheAccess(this, entityType, true);
+			}
+
+			foreach (string coldId : coldIds)
+			{
+				EDF_DbMetrics.RecordCacheAccess(this, entityType, false);
+			}
+		}
+
+		if (coldIds.IsEmpty() || m_aCompleteTypes.Contains(entityType))
+			return hotResults;
+
+		coldIds = ResolvePendingIds(entityType, coldIds, entities);
+		if (coldIds.IsEmpty())
+			return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, EDF_DbEntityUtils.OrderByIds(entities, entityIds));
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> coldResults = m_pColdTier.FindByIds(entityType, coldIds);
+		if (!coldResults.IsSuccess())
+			return coldResults;
+
+		Promote(entityType, coldResults.GetEntities());
+
+		foreach (EDF_DbEntity entity : coldResults.GetEntities())
+		{
+			entities.Insert(entity);
+		}
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, EDF_DbEntityUtils.OrderByIds(entities, entityIds));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = GetPendingOverlay(entityType);
+		if (!pendingWrites)
+			return GetReadTier(entityType).Count(entityType, condition);
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> coldResults = m_pColdTier.FindAll(entityType, condition);
+		if (!coldResults.IsSuccess())
+			return new EDF_DbCountResult(coldResults.GetStatusCode());
+
+		return new EDF_DbCountResult(EDF_EDbOperationStatusCode.SUCCESS, pendingWrites.Overlay(coldResults.GetEntities(), condition).Count());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = GetPendingOverlay(entityType);
+		if (!pendingWrites)
+			return GetReadTier(entityType).Exists(entityType, condition);
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> coldResults = m_pColdTier.FindAll(entityType, condition);
+		if (!coldResults.IsSuccess())
+			return new EDF_DbExistsResult(coldResults.GetStatusCode());
+
+		return new EDF_DbExistsResult(EDF_EDbOperationStatusCode.SUCCESS, !pendingWrites.Overlay(coldResults.GetEntities(), condition).IsEmpty());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = GetPendingOverlay(entityType);
+		if (!pendingWrites)
+			return GetReadTier(entityType).Aggregate(entityType, aggregation, condition);
+
+		EDF_DbAggregator aggregator(aggregation);
+		EDF_EDbOperationStatusCode statusCode = aggregator.Validate(entityType);
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			return new EDF_DbAggregateResult(statusCode);
+
+		EDF_DbFindResultMultiple<EDF_DbEntity> coldResults = m_pColdTier.FindAll(entityType, condition);
+		if (!coldResults.IsSuccess())
+			return new EDF_DbAggregateResult(coldResults.GetStatusCode());
+
+		foreach (EDF_DbEntity entity : pendingWrites.Overlay(coldResults.GetEntities(), condition))
+		{
+			aggregator.Accumulate(entity);
+		}
+
+		return new EDF_DbAggregateResult(EDF_EDbOperationStatusCode.SUCCESS, aggregator.GetResults());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateAsync(notnull EDF_DbEntity entity, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// Visible right away, taken out of the hot tier again if the cold write fails
+		Store(entity);
+		AddPending(entity.Type(), entity.GetId(), entity);
+		m_pColdTier.AddOrUpdateAsync(entity, new EDF_TieredDbDriverWriteCallback(this, entity.Type(), {entity.GetId()}, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveAsync(typename entityType, string entityId, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		Discard(entityType, entityId);
+		AddPending(entityType, entityId, null);
+		m_pColdTier.RemoveAsync(entityType, entityId, new EDF_TieredDbDriverWriteCallback(this, entityType, {entityId}, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		// Grouped by type for the invalidation on failure
+		map<typename, ref array<ref EDF_DbEntity>> entitiesByType();
+		foreach (EDF_DbEntity entity : entities)
+		{
+			Store(entity);
+
+			typename entityType = entity.Type();
+			AddPending(entityType, entity.GetId(), entity);
+			array<ref EDF_DbEntity> typeEntities = entitiesByType.Get(entityType);
+			if (!typeEntities)
+			{
+				typeEntities = {};
+				entitiesByType.Set(entityType, typeEntities);
+			}
+
+			typeEntities.Insert(entity);
+		}
+
+		EDF_DbOperationStatusMultiCallback multiCallback(entitiesByType.Count(), callback);
+		foreach (typename entityType, array<ref EDF_DbEntity> typeEntities : entitiesByType)
+		{
+			array<string> entityIds();
+			foreach (EDF_DbEntity entity : typeEntities)
+			{
+				entityIds.Insert(entity.GetId());
+			}
+
+			m_pColdTier.AddOrUpdateManyAsync(typeEntities, new EDF_TieredDbDriverWriteCallback(this, entityType, entityIds, multiCallback));
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		foreach (string entityId : entityIds)
+		{
+			Discard(entityType, entityId);
+			AddPending(entityType, entityId, null);
+		}
+
+		m_pColdTier.RemoveManyAsync(entityType, entityIds, new EDF_TieredDbDriverWriteCallback(this, entityType, entityIds, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		DiscardWhere(entityType, condition);
+
+		EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+		if (!pendingWrites)
+		{
+			pendingWrites = new EDF_TieredDbDriverPendingWrites();
+			m_mPendingWrites.Set(entityType, pendingWrites);
+		}
+
+		pendingWrites.AddRemoveWhere(condition);
+		m_pColdTier.RemoveWhereAsync(entityType, condition, new EDF_TieredDbDriverWriteCallback(this, entityType, new array<string>(), callback, condition));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		EDF_EDbOperationStatusCode statusCode = m_pHotTier.Patch(entityType, entityId, patch, condition);
+		if (statusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND && !m_aCompleteTypes.Contains(entityType))
+		{
+			// Not in memory, the patched state is unknown until the cold tier applied it, so reads can not be overlaid with it
+			m_pColdTier.PatchAsync(entityType, entityId, patch, callback, condition);
+			return;
+		}
+
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			if (callback)
+				callback.Invoke(statusCode);
+
+			return;
+		}
+
+		m_pAccessOrder.Touch(entityType, entityId);
+		EDF_DbEntity entity = m_pHotTier.FindById(entityType, entityId).GetEntity();
+		AddPending(entityType, entityId, entity);
+		m_pColdTier.AddOrUpdateAsync(entity, new EDF_TieredDbDriverWriteCallback(this, entityType, {entityId}, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		if (m_aCompleteTypes.Contains(entityType))
+		{
+			m_pHotTier.FindAllAsync(entityType, condition, orderBy, limit, offset, callback);
+			return;
+		}
+
+		EDF_TieredDbDriverPromoteCallback promoteCallback(this, entityType, IsLoadingAll(condition, limit, offset), callback);
+		EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+		if (pendingWrites)
+		{
+			// Limit and offset can only be applied once the pending writes are in
+			promoteCallback.OverlayWith(pendingWrites, condition, orderBy, limit, offset);
+			m_pColdTier.FindAllAsync(entityType, condition, orderBy, callback: promoteCallback);
+			return;
+		}
+
+		m_pColdTier.FindAllAsync(entityType, condition, orderBy, limit, offset, promoteCallback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbFindResultSingle<EDF_DbEntity> hotResult = m_pHotTier.FindById(entityType, entityId);
+		if (hotResult.GetEntity() || !hotResult.IsSuccess() || m_aCompleteTypes.Contains(entityType))
+		{
+			if (hotResult.GetEntity())
+				m_pAccessOrder.Touch(entityType, entityId);
+
+			if (!callback)
+				return;
+
+			array<ref EDF_DbEntity> resultEntities();
+			if (hotResult.GetEntity())
+				resultEntities.Insert(hotResult.GetEntity());
+
+			callback.Invoke(hotResult.GetStatusCode(), resultEntities);
+			return;
+		}
+
+		EDF_DbEntity written;
+		if (FindPending(entityType, entityId, written))
+		{
+			if (!callback)
+				return;
+
+			array<ref EDF_DbEntity> writtenEntities();
+			if (written)
+				writtenEntities.Insert(written);
+
+			callback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, writtenEntities);
+			return;
+		}
+
+		m_pColdTier.FindByIdAsync(entityType, entityId, new EDF_TieredDbDriverPromoteCallback(this, entityType, false, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		EDF_DbFindResultMultiple<EDF_DbEntity> hotResults = m_pHotTier.FindByIds(entityType, entityIds);
+		array<ref EDF_DbEntity> entities = hotResults.GetEntities();
+		TouchAll(entityType, entities);
+
+		array<string> coldIds = GetMissingIds(entityIds, entities);
+		if (!m_aCompleteTypes.Contains(entityType))
+			coldIds = ResolvePendingIds(entityType, coldIds, entities);
+
+		if (coldIds.IsEmpty() || m_aCompleteTypes.Contains(entityType))
+		{
+			if (callback)
+				callback.Invoke(hotResults.GetStatusCode(), EDF_DbEntityUtils.OrderByIds(entities, entityIds));
+
+			return;
+		}
+
+		EDF_TieredDbDriverPromoteCallback promoteCallback(this, entityType, false, callback);
+		promoteCallback.MergeWith(entities, entityIds);
+		m_pColdTier.FindByIdsAsync(entityType, coldIds, promoteCallback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = GetPendingOverlay(entityType);
+		if (!pendingWrites)
+		{
+			GetReadTier(entityType).CountAsync(entityType, condition, callback);
+			return;
+		}
+
+		m_pColdTier.FindAllAsync(entityType, condition, callback: new EDF_TieredDbDriverOverlayCallback(pendingWrites, condition, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = GetPendingOverlay(entityType);
+		if (!pendingWrites)
+		{
+			GetReadTier(entityType).ExistsAsync(entityType, condition, callback);
+			return;
+		}
+
+		m_pColdTier.FindAllAsync(entityType, condition, callback: new EDF_TieredDbDriverOverlayCallback(pendingWrites, condition, callback));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = GetPendingOverlay(entityType);
+		if (!pendingWrites)
+		{
+			GetReadTier(entityType).AggregateAsync(entityType, aggregation, condition, callback);
+			return;
+		}
+
+		EDF_DbAggregator aggregator(aggregation);
+		EDF_EDbOperationStatusCode statusCode = aggregator.Validate(entityType);
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			if (callback)
+				callback.Invoke(statusCode, new array<ref EDF_DbAggregateGroup>());
+
+			return;
+		}
+
+		EDF_TieredDbDriverOverlayCallback overlayCallback(pendingWrites, condition, callback);
+		overlayCallback.AggregateWith(aggregation, aggregator);
+		m_pColdTier.FindAllAsync(entityType, condition, callback: overlayCallback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pass buffered writes on to the cold storage. Only relevant when writing behind, called automatically in the configured interval.
+	//! \param forceBlocking wait until everything was written
+	void Flush(bool forceBlocking = false)
+	{
+		EDF_DbDriverBufferWrapper bufferWrapper = EDF_DbDriverBufferWrapper.Cast(m_pColdTier);
+		if (bufferWrapper)
+			bufferWrapper.Flush(forceBlocking);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return amount of entities currently kept in memory
+	int GetHotCount()
+	{
+		return m_pAccessOrder.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Add entities read from the cold tier to the hot tier
+	//! \param complete entities are all there is of the type, so queries on it can be answered from memory from now on
+	void Promote(typename entityType, notnull array<ref EDF_DbEntity> entities, bool complete = false)
+	{
+		array<ref EDF_DbEntity> newEntities();
+		foreach (EDF_DbEntity entity : entities)
+		{
+			// What is already hot is at least as recent as the cold read, e.g. when an async write is still in flight
+			string entityId = entity.GetId();
+			if (!m_pAccessOrder.Contains(entityType, entityId))
+				newEntities.Insert(entity);
+
+			m_pAccessOrder.Touch(entityType, entityId);
+		}
+
+		if (!newEntities.IsEmpty())
+			m_pHotTier.AddOrUpdateMany(newEntities);
+
+		if (complete)
+			m_aCompleteTypes.Insert(entityType);
+
+		Demote();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Drop entities from the hot tier whose cold state is unknown after a failed write
+	void Invalidate(typename entityType, notnull array<string> entityIds)
+	{
+		foreach (string entityId : entityIds)
+		{
+			Discard(entityType, entityId);
+		}
+
+		m_aCompleteTypes.RemoveItem(entityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Called by the write callbacks once async writes passed on to the cold tier completed, successfully or not
+	//! \param removeCondition of the completed RemoveWhereAsync, if any
+	void CompletePending(typename entityType, int writes, EDF_DbFindCondition removeCondition = null)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+		if (pendingWrites && pendingWrites.Complete(writes, removeCondition))
+			m_mPendingWrites.Remove(entityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Store(notnull EDF_DbEntity entity)
+	{
+		if (!entity.HasId())
+			return;
+
+		m_pHotTier.AddOrUpdate(entity);
+		m_pAccessOrder.Touch(entity.Type(), entity.GetId());
+		Demote();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Discard(typename entityType, string entityId)
+	{
+		if (!m_pAccessOrder.Forget(entityType, entityId))
+			return;
+
+		m_pHotTier.Remove(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void DiscardWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		foreach (string entityId : GetHotIds(entityType, condition))
+		{
+			Discard(entityType, entityId);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Demote the least recently used entities until the hot tier is within its limit again
+	protected void Demote()
+	{
+		if (m_iMaxHotEntities == -1)
+			return;
+
+		typename entityType;
+		string entityId;
+		while (m_pAccessOrder.Count() > m_iMaxHotEntities && m_pAccessOrder.PopLeastRecent(entityType, entityId))
+		{
+			// Already written to the cold tier or held by its write buffer
+			m_pHotTier.Remove(entityType, entityId);
+			m_aCompleteTypes.RemoveItem(entityType);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void TouchAll(typename entityType, notnull array<ref EDF_DbEntity> entities)
+	{
+		foreach (EDF_DbEntity entity : entities)
+		{
+			m_pAccessOrder.Touch(entityType, entity.GetId());
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected array<string> GetHotIds(typename entityType, EDF_DbFindCondition condition)
+	{
+		array<string> entityIds();
+		foreach (EDF_DbEntity entity : m_pHotTier.FindAll(entityType, condition).GetEntities())
+		{
+			entityIds.Insert(entity.GetId());
+		}
+
+		return entityIds;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Track an async write passed on to the cold tier until its callback
+	//! \param entity written state, null for a removal
+	protected void AddPending(typename entityType, string entityId, EDF_DbEntity entity)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+		if (!pendingWrites)
+		{
+			pendingWrites = new EDF_TieredDbDriverPendingWrites();
+			m_mPendingWrites.Set(entityType, pendingWrites);
+		}
+
+		pendingWrites.Add(entityId, entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! A blocking write reached the cold tier ahead of async writes of the type still pending, keep its state for the overlay
+	protected void SupersedePending(typename entityType, string entityId, EDF_DbEntity entity)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+		if (pendingWrites)
+			pendingWrites.Supersede(entityId, entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param[out] entity written while async writes of the type are pending, null if it was removed
+	//! \return true if the cold tier may not have that state yet
+	protected bool FindPending(typename entityType, string entityId, out EDF_DbEntity entity)
+	{
+		EDF_TieredDbDriverPendingWrites pendingWrites = m_mPendingWrites.Get(entityType);
+		return pendingWrites && pendingWrites.Find(entityId, entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Answer ids written while async writes of the type are pending from what was written instead of the cold tier
+	//! \param[out] entities receives the written ones that were not removed
+	//! \return ids still to read from the cold tier
+	protected array<string> ResolvePendingIds(typename entityType, notnull array<string> entityIds, notnull array<ref EDF_DbEntity> entities)
+	{
+		if (!m_mPendingWrites.Contains(entityType))
+			return entityIds;
+
+		array<string> coldIds();
+		foreach (string entityId : entityIds)
+		{
+			EDF_DbEntity written;
+			if (!FindPending(entityType, entityId, written))
+			{
+				coldIds.Insert(entityId);
+				continue;
+			}
+
+			if (written)
+				entities.Insert(written);
+		}
+
+		return coldIds;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return pending writes to overlay reads of the cold tier with, null if the type is read from the tier as is
+	protected EDF_TieredDbDriverPendingWrites GetPendingOverlay(typename entityType)
+	{
+		if (m_aCompleteTypes.Contains(entityType))
+			return null;
+
+		return m_mPendingWrites.Get(entityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected EDF_DbDriver GetReadTier(typename entityType)
+	{
+		if (m_aCompleteTypes.Contains(entityType))
+			return m_pHotTier;
+
+		return m_pColdTier;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static bool IsLoadingAll(EDF_DbFindCondition condition, int limit, int offset)
+	{
+		return !condition && limit == -1 && offset <= 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static array<string> GetMissingIds(notnull array<string> entityIds, notnull array<ref EDF_DbEntity> foundEntities)
+	{
+		set<string> foundIds();
+		foreach (EDF_DbEntity entity : foundEntities)
+		{
+			foundIds.Insert(entity.GetId());
+		}
+
+		array<string> missingIds();
+		foreach (string entityId : entityIds)
+		{
+			if (!foundIds.Contains(entityId))
+				missingIds.Insert(entityId);
+		}
+
+		return missingIds;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ~EDF_TieredDbDriver()
+	{
+		if (GetGame())
+			GetGame().GetCallqueue().Remove(Flush);
+	}
+};
+
+//! Least recently used order of the hot tier entities. Every access appends to a queue and outdated queue entries are skipped, so touching is O(1).
+class EDF_TieredDbDriverAccessOrder
+{
+	protected ref array<ref EDF_TieredDbDriverAccessEntry> m_aQueue = {};
+	protected int m_iHead;
+	protected int m_iTick;
+	protected ref map<string, int> m_mLastAccess = new map<string, int>();
+
+	protected static const int COMPACT_THRESHOLD = 1024;
+
+	//------------------------------------------------------------------------------------------------
+	void Touch(typename entityType, string entityId)
+	{
+		EDF_TieredDbDriverAccessEntry entry();
+		entry.m_tEntityType = entityType;
+		entry.m_sEntityId = entityId;
+		entry.m_iTick = ++m_iTick;
+
+		m_mLastAccess.Set(GetKey(entityType, entityId), entry.m_iTick);
+		m_aQueue.Insert(entry);
+
+		if (m_aQueue.Count() - m_iHead > 2 * m_mLastAccess.Count() + COMPACT_THRESHOLD)
+			Compact();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return true if the entity was tracked
+	bool Forget(typename entityType, string entityId)
+	{
+		string key = GetKey(entityType, entityId);
+		if (!m_mLastAccess.Contains(key))
+			return false;
+
+		m_mLastAccess.Remove(key);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool Contains(typename entityType, string entityId)
+	{
+		return m_mLastAccess.Contains(GetKey(entityType, entityId));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_mLastAccess.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Stop tracking the least recently used entity
+	//! \return false if nothing is tracked
+	bool PopLeastRecent(out typename entityType, out string entityId)
+	{
+		while (m_iHead < m_aQueue.Count())
+		{
+			EDF_TieredDbDriverAccessEntry entry = m_aQueue.Get(m_iHead);
+			m_aQueue.Set(m_iHead++, null);
+
+			string key = GetKey(entry.m_tEntityType, entry.m_sEntityId);
+			int lastAccess;
+			if (!m_mLastAccess.Find(key, lastAccess) || lastAccess != entry.m_iTick)
+				continue; // Accessed again later or forgotten
+
+			m_mLastAccess.Remove(key);
+			entityType = entry.m_tEntityType;
+			entityId = entry.m_sEntityId;
+			return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Drop outdated queue entries
+	protected void Compact()
+	{
+		array<ref EDF_TieredDbDriverAccessEntry> queue();
+		queue.Reserve(m_mLastAccess.Count());
+
+		for (int nEntry = m_iHead, count = m_aQueue.Count(); nEntry < count; nEntry++)
+		{
+			EDF_TieredDbDriverAccessEntry entry = m_aQueue.Get(nEntry);
+			if (m_mLastAccess.Get(GetKey(entry.m_tEntityType, entry.m_sEntityId)) == entry.m_iTick)
+				queue.Insert(entry);
+		}
+
+		m_aQueue = queue;
+		m_iHead = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static string GetKey(typename entityType, string entityId)
+	{
+		return string.Format("%1:%2", entityType, entityId);
+	}
+};
+
+class EDF_TieredDbDriverAccessEntry
+{
+	typename m_tEntityType;
+	string m_sEntityId;
+	int m_iTick;
+};
+
+//! Latest state written by the driver for one entity type while async writes of it to the cold tier have not completed.
+//! Reads from the cold tier are overlaid with it, so they never return data older than what the hot tier already showed.
+class EDF_TieredDbDriverPendingWrites
+{
+	protected ref map<string, ref EDF_DbEntity> m_mEntities = new map<string, ref EDF_DbEntity>(); // Null for removed
+	protected ref array<ref EDF_DbFindCondition> m_aRemoveConditions = {};
+	protected int m_iPending;
+
+	//------------------------------------------------------------------------------------------------
+	//! \param entity written state, null for a removal
+	void Add(string entityId, EDF_DbEntity entity)
+	{
+		m_iPending++;
+		Supersede(entityId, entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Entities matching the condition are removed, including the ones of earlier writes
+	void AddRemoveWhere(notnull EDF_DbFindCondition condition)
+	{
+		m_iPending++;
+		m_aRemoveConditions.Insert(condition);
+		SupersedeWhere(condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Keep the state of a blocking write made while async ones are pending, the cold tier already has it
+	void Supersede(string entityId, EDF_DbEntity entity)
+	{
+		if (!entityId)
+			return;
+
+		if (!entity)
+		{
+			m_mEntities.Set(entityId, null);
+			return;
+		}
+
+		EDF_DbEntity copy = EDF_DbEntity.Cast(entity.Type().Spawn());
+		EDF_DbEntityUtils.StructAutoCopy(entity, copy);
+		m_mEntities.Set(entityId, copy);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void SupersedeWhere(notnull EDF_DbFindCondition condition)
+	{
+		array<string> removedIds();
+		foreach (string entityId, EDF_DbEntity entity : m_mEntities)
+		{
+			if (entity && EDF_DbFindConditionEvaluator.Evaluate(entity, condition))
+				removedIds.Insert(entityId);
+		}
+
+		foreach (string removedId : removedIds)
+		{
+			m_mEntities.Set(removedId, null);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param writes amount of completed writes
+	//! \param removeCondition of the completed RemoveWhere, if any
+	//! \return true once nothing is pending anymore
+	bool Complete(int writes, EDF_DbFindCondition removeCondition = null)
+	{
+		m_iPending -= writes;
+		if (removeCondition)
+		{
+			m_iPending--;
+			m_aRemoveConditions.RemoveItem(removeCondition);
+		}
+
+		return m_iPending <= 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param[out] entity copy of the written state, null if it was removed
+	//! \return true if the driver wrote the entity since async writes became pending
+	bool Find(string entityId, out EDF_DbEntity entity)
+	{
+		EDF_DbEntity written;
+		if (!m_mEntities.Find(entityId, written))
+			return false;
+
+		if (written)
+		{
+			entity = EDF_DbEntity.Cast(written.Type().Spawn());
+			EDF_DbEntityUtils.StructAutoCopy(written, entity);
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Replace the written entities in the cold results, drop the removed ones and add the written ones that now match.
+	//! \param coldEntities read without limit and offset, those can only be applied afterwards
+	array<ref EDF_DbEntity> Overlay(notnull array<ref EDF_DbEntity> coldEntities, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
+	{
+		array<ref EDF_DbEntity> entities();
+		foreach (EDF_DbEntity coldEntity : coldEntities)
+		{
+			if (m_mEntities.Contains(coldEntity.GetId()) || IsRemoved(coldEntity))
+				continue;
+
+			entities.Insert(coldEntity);
+		}
+
+		foreach (string entityId, EDF_DbEntity written : m_mEntities)
+		{
+			if (!written || (condition && !EDF_DbFindConditionEvaluator.Evaluate(written, condition)))
+				continue;
+
+			EDF_DbEntity copy = EDF_DbEntity.Cast(written.Type().Spawn());
+			EDF_DbEntityUtils.StructAutoCopy(written, copy);
+			entities.Insert(copy);
+		}
+
+		if (orderBy)
+			entities = EDF_DbEntitySorter.GetSorted(entities, orderBy);
+
+		if (limit == -1 && offset <= 0)
+			return entities;
+
+		array<ref EDF_DbEntity> page();
+		for (int nEntity = Math.Max(offset, 0), count = entities.Count(); nEntity < count; nEntity++)
+		{
+			if (limit != -1 && page.Count() >= limit)
+				break;
+
+			page.Insert(entities.Get(nEntity));
+		}
+
+		return page;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool IsRemoved(notnull EDF_DbEntity entity)
+	{
+		foreach (EDF_DbFindCondition removeCondition : m_aRemoveConditions)
+		{
+			if (EDF_DbFindConditionEvaluator.Evaluate(entity, removeCondition))
+				return true;
+		}
+
+		return false;
+	}
+};
+
+class EDF_TieredDbDriverPromoteCallback : EDF_DbFindCallbackBase
+{
+	protected EDF_TieredDbDriver m_pDriver;
+	protected typename m_tEntityType;
+	protected bool m_bComplete;
+	protected ref EDF_DbFindCallbackBase m_pCallback;
+	protected ref array<ref EDF_DbEntity> m_aHotEntities;
+	protected ref array<string> m_aEntityIds;
+	protected ref EDF_TieredDbDriverPendingWrites m_pPendingWrites;
+	protected ref EDF_DbFindCondition m_pCondition;
+	protected ref array<ref TStringArray> m_aOrderBy;
+	protected int m_iLimit;
+	protected int m_iOffset;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		if (code == EDF_EDbOperationStatusCode.SUCCESS && findResults)
+		{
+			if (m_pPendingWrites)
+				findResults = m_pPendingWrites.Overlay(findResults, m_pCondition, m_aOrderBy, m_iLimit, m_iOffset);
+
+			if (m_pDriver)
+				m_pDriver.Promote(m_tEntityType, findResults, m_bComplete);
+
+			if (m_aHotEntities)
+			{
+				foreach (EDF_DbEntity entity : m_aHotEntities)
+				{
+					findResults.Insert(entity);
+				}
+
+				findResults = EDF_DbEntityUtils.OrderByIds(findResults, m_aEntityIds);
+			}
+		}
+
+		if (m_pCallback)
+			m_pCallback.Invoke(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Combine the cold results with entities already read from the hot tier
+	//! \param entityIds requested ids that define the order of the combined result
+	void MergeWith(notnull array<ref EDF_DbEntity> hotEntities, notnull array<string> entityIds)
+	{
+		m_aHotEntities = hotEntities;
+		m_aEntityIds = entityIds;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Apply the writes still pending when the read was made to the cold results
+	//! \param limit and offset are applied afterwards, the cold tier has to be read without them
+	void OverlayWith(notnull EDF_TieredDbDriverPendingWrites pendingWrites, EDF_DbFindCondition condition, array<ref TStringArray> orderBy, int limit, int offset)
+	{
+		m_pPendingWrites = pendingWrites;
+		m_pCondition = condition;
+		m_aOrderBy = orderBy;
+		m_iLimit = limit;
+		m_iOffset = offset;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_TieredDbDriverPromoteCallback(EDF_TieredDbDriver driver, typename entityType, bool complete, EDF_DbFindCallbackBase callback)
+	{
+		m_pDriver = driver;
+		m_tEntityType = entityType;
+		m_bComplete = complete;
+		m_pCallback = callback;
+	}
+};
+
+class EDF_TieredDbDriverWriteCallback : EDF_DbOperationStatusOnlyCallback
+{
+	protected EDF_TieredDbDriver m_pDriver;
+	protected typename m_tEntityType;
+	protected ref array<string> m_aEntityIds;
+	protected ref EDF_DbOperationStatusOnlyCallback m_pCallback;
+	protected ref EDF_DbFindCondition m_pRemoveCondition;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		if (m_pDriver)
+			m_pDriver.CompletePending(m_tEntityType, m_aEntityIds.Count(), m_pRemoveCondition);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		// Removing what is already gone leaves both tiers the same
+		if (m_pDriver && statusCode != EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND)
+			m_pDriver.Invalidate(m_tEntityType, m_aEntityIds);
+
+		if (m_pDriver)
+			m_pDriver.CompletePending(m_tEntityType, m_aEntityIds.Count(), m_pRemoveCondition);
+
+		if (m_pCallback)
+			m_pCallback.Invoke(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param removeCondition of a RemoveWhereAsync, its removals are pending until the callback
+	void EDF_TieredDbDriverWriteCallback(EDF_TieredDbDriver driver, typename entityType, array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback, EDF_DbFindCondition removeCondition = null)
+	{
+		m_pDriver = driver;
+		m_tEntityType = entityType;
+		m_aEntityIds = entityIds;
+		m_pCallback = callback;
+		m_pRemoveCondition = removeCondition;
+	}
+};
+
+//! Count, exists and aggregate answered from cold tier matches overlaid with the pending writes of the type
+class EDF_TieredDbDriverOverlayCallback : EDF_DbFindCallbackBase
+{
+	protected ref EDF_TieredDbDriverPendingWrites m_pPendingWrites;
+	protected ref EDF_DbFindCondition m_pCondition;
+	protected ref EDF_DbOperationCallback m_pCallback;
+	protected ref EDF_DbAggregation m_pAggregation; // Only referenced weakly by the aggregator
+	protected ref EDF_DbAggregator m_pAggregator;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		array<ref EDF_DbEntity> matches();
+		if (code == EDF_EDbOperationStatusCode.SUCCESS && findResults)
+			matches = m_pPendingWrites.Overlay(findResults, m_pCondition);
+
+		auto countCallback = EDF_DbCountCallback.Cast(m_pCallback);
+		if (countCallback)
+		{
+			countCallback.Invoke(code, matches.Count());
+			return;
+		}
+
+		auto existsCallback = EDF_DbExistsCallback.Cast(m_pCallback);
+		if (existsCallback)
+		{
+			existsCallback.Invoke(code, !matches.IsEmpty());
+			return;
+		}
+
+		auto aggregateCallback = EDF_DbAggregateCallback.Cast(m_pCallback);
+		if (!aggregateCallback)
+			return;
+
+		if (code != EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			aggregateCallback.Invoke(code, new array<ref EDF_DbAggregateGroup>());
+			return;
+		}
+
+		foreach (EDF_DbEntity match : matches)
+		{
+			m_pAggregator.Accumulate(match);
+		}
+
+		aggregateCallback.Invoke(code, m_pAggregator.GetResults());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param aggregator already validated against the entity type
+	void AggregateWith(notnull EDF_DbAggregation aggregation, notnull EDF_DbAggregator aggregator)
+	{
+		m_pAggregation = aggregation;
+		m_pAggregator = aggregator;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_TieredDbDriverOverlayCallback(notnull EDF_TieredDbDriverPendingWrites pendingWrites, EDF_DbFindCondition condition, EDF_DbOperationCallback callback)
+	{
+		m_pPendingWrites = pendingWrites;
+		m_pCondition = condition;
+		m_pCallback = callback;
+	}
+};
@@ -10,6 +10,21 @@ class EDF_WebProxyConnectionInfoBase : EDF_DbConnectionInfoBase
 	[Attribute(desc: "Use TLS/SSL to connect to the web proxy.")]
 	bool m_bSecureConnection;
 
+	[Attribute(defvalue: "32", desc: "Max. requests sent to the proxy at the same time, others wait with reads before writes. 0 for no limit.")]
+	int m_iMaxInFlight = 32;
+
+	[Attribute(defvalue: "-1", desc: "Writes within this many ms are sent together in one bulk request. 0 for writes of the same frame, -1 (default, off) to send every write on its own. Needs the proxy to support POST <type>/_bulk.")]
+	int m_iBatchWindow = -1;
+
+	[Attribute(defvalue: "100", desc: "Max. writes per bulk request.")]
+	int m_iBatchSize = 100;
+
+	[Attribute(defvalue: "1", desc: "Send the id lookups of an entity type made in the same frame as one request.")]
+	bool m_bCoalesceLookups = true;
+
+	[Attribute(defvalue: "500", desc: "Max. entities read from a find response per frame, larger results are read over multiple frames. 0 to read all at once.")]
+	int m_iParseBudget = 500;
+
 	[Attribute(desc: "Additional parameters added to the url with ...&key=value e.g. api keys.")]
 	ref array<ref EDF_WebProxyParameter> m_aParameters;
 
@@ -64,8 +79,42 @@ class EDF_WebProxyConnectionInfoBase : EDF_DbConnectionInfoBase
 					break;
 				}
 
+				case "maxinflight":
+				{
+					m_iMaxInFlight = value.ToInt(m_iMaxInFlight);
+					break;
+				}
+
+				case "batchwindow":
+				{
+					m_iBatchWindow = value.ToInt(m_iBatchWindow);
+					break;
+				}
+
+				case "batchsize":
+				{
+					m_iBatchSize = value.ToInt(m_iBatchSize);
+					break;
+				}
+
+				case "parsebudget":
+				{
+					m_iParseBudget = value.ToInt(m_iParseBudget);
+					break;
+				}
+
+				case "coalesce":
+				case "coalescelookups":
+				{
+					m_bCoalesceLookups = valueLower == "1" || valueLower == "true" || valueLower == "yes";
+					break;
+				}
+
 				default:
 				{
+					if (!m_aParameters)
+						m_aParameters = {};
+
 					m_aParameters.Insert(new EDF_WebProxyParameter(key, value));
 				}
 			}
@@ -118,9 +167,15 @@ sealed class EDF_WebProxyDbDriverCallback : RestCallback
 
 	protected ref EDF_DbOperationCallback m_pCallback;
 	protected typename m_tResultType;
+	protected EDF_WebProxyDbDriverScheduler m_pScheduler;
 
 	protected string m_sVerb;
 	protected string m_sUrl;
+	protected bool m_bReadMatched;
+	protected bool m_bSingleEntity;
+	protected int m_iParseBudget;
+	protected ref EDF_WebProxyDbDriverResultReader m_pResultReader;
+	protected ref array<ref EDF_DbEntity> m_aResults;
 
 	//------------------------------------------------------------------------------------------------
 	override void OnSuccess(string data, int dataSize)
@@ -130,6 +185,34 @@ sealed class EDF_WebProxyDbDriverCallback : RestCallback
 		#endif
 
 		s_aSelfReferences.RemoveItem(this);
+		if (m_pScheduler)
+			m_pScheduler.OnRequestFinished();
+
+		if (m_bReadMatched)
+		{
+			// Conditional operations answer with {"matched": <bool>}
+			SCR_JsonLoadContext matchedReader();
+			bool matched;
+			if (!matchedReader.ImportFromString(data) || !matchedReader.ReadValue("matched", matched))
+			{
+				OnFailure(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
+				return;
+			}
+
+			if (!matched)
+			{
+				OnFailure(EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET);
+				return;
+			}
+		}
+
+		// Bulk writes answer with the ops that failed
+		auto writeBatchCallback = EDF_WebProxyDbDriverWriteBatchCallback.Cast(m_pCallback);
+		if (writeBatchCallback)
+		{
+			writeBatchCallback.OnResponse(data);
+			return;
+		}
 
 		auto statusCallback = EDF_DbOperationStatusOnlyCallback.Cast(m_pCallback);
 		if (statusCallback)
@@ -138,6 +221,49 @@ sealed class EDF_WebProxyDbDriverCallback : RestCallback
 			return;
 		}
 
+		auto countCallback = EDF_DbCountCallback.Cast(m_pCallback);
+		if (countCallback)
+		{
+			int count;
+			if (!ReadCount(data, count))
+			{
+				OnFailure(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
+				return;
+			}
+
+			countCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, count);
+			return;
+		}
+
+		auto existsCallback = EDF_DbExistsCallback.Cast(m_pCallback);
+		if (existsCallback)
+		{
+			int matches;
+			if (!ReadCount(data, matches))
+			{
+				OnFailure(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
+				return;
+			}
+
+			existsCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, matches > 0);
+			return;
+		}
+
+		auto aggregateCallback = EDF_DbAggregateCallback.Cast(m_pCallback);
+		if (aggregateCallback)
+		{
+			SCR_JsonLoadContext aggregateReader();
+			array<ref EDF_DbAggregateGroup> groups();
+			if (!aggregateReader.ImportFromString(data) || !aggregateReader.ReadValue("groups", groups))
+			{
+				OnFailure(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
+				return;
+			}
+
+			aggregateCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, groups);
+			return;
+		}
+
 		auto findCallback = EDF_DbFindCallbackBase.Cast(m_pCallback);
 		if (!findCallback)
 			return; // Could have been a status only operation but no callback was set
@@ -151,29 +277,74 @@ sealed class EDF_WebProxyDbDriverCallback : RestCallback
 		SCR_JsonLoadContext reader();
 		array<ref EDF_DbEntity> resultEntities();
 
-		// Read per line individually until json load context has polymorph support: https://feedback.bistudio.com/T173074
-		array<string> lines();
-		data.Split("\n", lines, true);
-		for (int nLine = 1, count = lines.Count() - 1; nLine < count; nLine++)
+		// Lookup by id answers with the entity json only
+		if (m_bSingleEntity)
 		{
-			EDF_DbEntity entity = EDF_DbEntity.Cast(m_tResultType.Spawn());
-
-			if (!reader.ImportFromString(lines[nLine]) || !reader.ReadValue("", entity))
+			EDF_DbEntity singleEntity = EDF_DbEntity.Cast(m_tResultType.Spawn());
+			if (!reader.ImportFromString(data) || !reader.ReadValue("", singleEntity))
 			{
 				OnFailure(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
 				return;
 			}
 
-			resultEntities.Insert(entity);
+			resultEntities.Insert(singleEntity);
+			findCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, resultEntities);
+			return;
 		}
 
-		findCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, resultEntities);
+		// Read per line individually until json load context has polymorph support: https://feedback.bistudio.com/T173074
+		m_pResultReader = new EDF_WebProxyDbDriverResultReader(data, m_tResultType);
+		m_aResults = resultEntities;
+		ContinueReading();
 	};
 
+	//------------------------------------------------------------------------------------------------
+	//! Read the next m_iParseBudget entities of the response, the rest follows in the next frame
+	protected void ContinueReading()
+	{
+		// The self reference can be the last one keeping this alive, so it is only dropped once nothing else is used
+		EDF_WebProxyDbDriverResultReader resultReader = m_pResultReader;
+		EDF_DbOperationCallback callback = m_pCallback;
+		auto chunkedCallback = EDF_DbFindCallbackChunked.Cast(callback);
+		if (chunkedCallback)
+			m_aResults = {};
+
+		array<ref EDF_DbEntity> results = m_aResults;
+		if (!resultReader.Read(results, m_iParseBudget))
+		{
+			m_pResultReader = null;
+			OnFailure(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
+			s_aSelfReferences.RemoveItem(this);
+			return;
+		}
+
+		if (chunkedCallback && !results.IsEmpty())
+			chunkedCallback.InvokeChunk(results);
+
+		if (!resultReader.IsFinished())
+		{
+			// Stay alive until the remaining entities are read
+			s_aSelfReferences.Insert(this);
+			GetGame().GetCallqueue().CallLater(ContinueReading);
+			return;
+		}
+
+		m_pResultReader = null;
+
+		if (chunkedCallback)
+			chunkedCallback.InvokeComplete(EDF_EDbOperationStatusCode.SUCCESS);
+		else
+			EDF_DbFindCallbackBase.Cast(callback).Invoke(EDF_EDbOperationStatusCode.SUCCESS, results);
+
+		s_aSelfReferences.RemoveItem(this);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override void OnError(int errorCode)
 	{
 		s_aSelfReferences.RemoveItem(this);
+		if (m_pScheduler)
+			m_pScheduler.OnRequestFinished();
 
 		#ifdef PERSISTENCE_DEBUG
 		Print(string.Format("%1::OnError(%2) from %3:%4", this, typename.EnumToString(ERestResult, errorCode), m_sVerb, m_sUrl), LogLevel.ERROR);
@@ -202,6 +373,8 @@ sealed class EDF_WebProxyDbDriverCallback : RestCallback
 	override void OnTimeout()
 	{
 		s_aSelfReferences.RemoveItem(this);
+		if (m_pScheduler)
+			m_pScheduler.OnRequestFinished();
 
 		#ifdef PERSISTENCE_DEBUG
 		Print(string.Format("%1::OnTimeout() from %2:%3", this, m_sVerb, m_sUrl), LogLevel.VERBOSE);
@@ -220,11 +393,70 @@ sealed class EDF_WebProxyDbDriverCallback : RestCallback
 			return;
 		}
 
+		auto countCallback = EDF_DbCountCallback.Cast(m_pCallback);
+		if (countCallback)
+		{
+			countCallback.Invoke(statusCode, 0);
+			return;
+		}
+
+		auto existsCallback = EDF_DbExistsCallback.Cast(m_pCallback);
+		if (existsCallback)
+		{
+			existsCallback.Invoke(statusCode, false);
+			return;
+		}
+
+		auto aggregateCallback = EDF_DbAggregateCallback.Cast(m_pCallback);
+		if (aggregateCallback)
+		{
+			aggregateCallback.Invoke(statusCode, new array<ref EDF_DbAggregateGroup>);
+			return;
+		}
+
 		auto findCallback = EDF_DbFindCallbackBase.Cast(m_pCallback);
-		if (findCallback)
-			findCallback.Invoke(EDF_EDbOperationStatusCode.FAILURE_UNKNOWN, new array<ref EDF_DbEntity>);
+		if (!findCallback)
+			return;
+
+		// Unknown id on lookup is not an error, there just is no result
+		if (m_bSingleEntity && statusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND)
+		{
+			findCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS, new array<ref EDF_DbEntity>);
+			return;
+		}
+
+		findCallback.Invoke(EDF_EDbOperationStatusCode.FAILURE_UNKNOWN, new array<ref EDF_DbEntity>);
 	};
 
+	//------------------------------------------------------------------------------------------------
+	//! Answer of the request sent blocking instead. Those have no error code, nothing at all means the proxy did not answer.
+	//! Plain writes can not tell this apart from success, like the blocking writes of the sync API.
+	void OnBlockingResponse(string response)
+	{
+		if (response.IsEmpty() && (m_bReadMatched || !EDF_DbOperationStatusOnlyCallback.Cast(m_pCallback) || EDF_WebProxyDbDriverWriteBatchCallback.Cast(m_pCallback)))
+		{
+			OnTimeout();
+			return;
+		}
+
+		OnSuccess(response, response.Length());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Free the slot of the scheduler that sent the request once it finished
+	void SetScheduler(EDF_WebProxyDbDriverScheduler scheduler)
+	{
+		m_pScheduler = scheduler;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Read {"count": <number>} responses
+	protected static bool ReadCount(string data, out int count)
+	{
+		SCR_JsonLoadContext reader();
+		return reader.ImportFromString(data) && reader.ReadValue("count", count);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	static void Reset()
 	{
@@ -232,12 +464,16 @@ sealed class EDF_WebProxyDbDriverCallback : RestCallback
 	}
 
 	//------------------------------------------------------------------------------------------------
-	void EDF_WebProxyDbDriverCallback(EDF_DbOperationCallback callback, typename resultType = typename.Empty, string verb = string.Empty, string url = string.Empty)
+	//! \param parseBudget max. entities read from the response per frame, 0 to read all at once
+	void EDF_WebProxyDbDriverCallback(EDF_DbOperationCallback callback, typename resultType = typename.Empty, string verb = string.Empty, string url = string.Empty, bool readMatched = false, bool singleEntity = false, int parseBudget = 0)
 	{
 		m_pCallback = callback;
 		m_tResultType = resultType;
 		m_sVerb = verb;
 		m_sUrl = url;
+		m_bReadMatched = readMatched;
+		m_bSingleEntity = singleEntity;
+		m_iParseBudget = parseBudget;
 		s_aSelfReferences.Insert(this);
 	};
 }
@@ -277,10 +513,82 @@ sealed class EDF_WebProxyDbDriverFindRequest
 	}
 }
 
+sealed class EDF_WebProxyDbDriverAggregateRequest
+{
+	EDF_DbFindCondition m_pCondition;
+	EDF_DbAggregation m_pAggregation;
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		if (m_pCondition)
+			saveContext.WriteValue("condition", m_pCondition);
+
+		saveContext.WriteValue("aggregation", m_pAggregation);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverAggregateRequest(EDF_DbFindCondition condition, EDF_DbAggregation aggregation)
+	{
+		m_pCondition = condition;
+		m_pAggregation = aggregation;
+	}
+}
+
+sealed class EDF_WebProxyDbDriverPatchRequest
+{
+	EDF_DbFindCondition m_pCondition;
+	EDF_DbPatch m_pPatch;
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		if (m_pCondition)
+			saveContext.WriteValue("condition", m_pCondition);
+
+		m_pPatch.WriteOperators(saveContext);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverPatchRequest(EDF_DbFindCondition condition, EDF_DbPatch patch)
+	{
+		m_pCondition = condition;
+		m_pPatch = patch;
+	}
+}
+
+sealed class EDF_WebProxyDbDriverBulkRequest
+{
+	array<ref EDF_DbEntity> m_aEntities;
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue("entities", m_aEntities);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverBulkRequest(array<ref EDF_DbEntity> entities)
+	{
+		m_aEntities = entities;
+	}
+}
+
 class EDF_WebProxyDbDriver : EDF_DbDriver
 {
 	protected RestContext m_pContext;
 	protected string m_sAddtionalParams;
+	protected ref map<typename, ref EDF_WebProxyDbDriverWriteQueue> m_mWriteQueues = new map<typename, ref EDF_WebProxyDbDriverWriteQueue>();
+	protected ref EDF_WebProxyDbDriverScheduler m_pScheduler;
+	protected int m_iBatchWindow;
+	protected int m_iBatchSize;
+	protected bool m_bWriteFlushScheduled;
+	protected bool m_bCoalesceLookups;
+	protected int m_iParseBudget;
+	protected ref map<typename, ref EDF_WebProxyDbDriverIdLookupBatch> m_mIdLookups = new map<typename, ref EDF_WebProxyDbDriverIdLookupBatch>();
 
 	//------------------------------------------------------------------------------------------------
 	override bool Initialize(notnull EDF_DbConnectionInfoBase connectionInfo)
@@ -294,6 +602,11 @@ class EDF_WebProxyDbDriver : EDF_DbDriver
 		// !!! Must have trailing / or the blocking methods don't like invoking it
 		url += string.Format("://%1:%2/%3/", webConnectInfo.m_sProxyHost, webConnectInfo.m_iProxyPort, webConnectInfo.m_sDatabaseName);
 		m_pContext = GetGame().GetRestApi().GetContext(url);
+		m_pScheduler = new EDF_WebProxyDbDriverScheduler(this, m_pContext, webConnectInfo.m_iMaxInFlight);
+		m_iBatchWindow = webConnectInfo.m_iBatchWindow;
+		m_iBatchSize = Math.Max(webConnectInfo.m_iBatchSize, 1);
+		m_bCoalesceLookups = webConnectInfo.m_bCoalesceLookups;
+		m_iParseBudget = webConnectInfo.m_iParseBudget;
 
 		if (webConnectInfo.m_aParameters)
 		{
@@ -311,6 +624,7 @@ class EDF_WebProxyDbDriver : EDF_DbDriver
 			}
 		}
 
+		EDF_DbShutdownFlush.Register(this);
 		return true;
 	}
 
@@ -318,8 +632,10 @@ class EDF_WebProxyDbDriver : EDF_DbDriver
 	override EDF_EDbOperationStatusCode AddOrUpdate(notnull EDF_DbEntity entity)
 	{
 		typename entityType = entity.Type();
+		SendHeldBackWritesNow(entityType);
+
 		string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entity.GetId(), m_sAddtionalParams);
-		string data = Serialize(entity);
+		string data = SerializeRequest(entityType, entity);
 		m_pContext.PUT_now(request, data);
 		return EDF_EDbOperationStatusCode.SUCCESS;
 	}
@@ -327,16 +643,132 @@ class EDF_WebProxyDbDriver : EDF_DbDriver
 	//------------------------------------------------------------------------------------------------
 	override EDF_EDbOperationStatusCode Remove(typename entityType, string entityId)
 	{
+		SendHeldBackWritesNow(entityType);
+
 		string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entityId, m_sAddtionalParams);
 		m_pContext.DELETE_now(request, string.Empty);
 		return EDF_EDbOperationStatusCode.SUCCESS;
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		map<typename, ref array<ref EDF_DbEntity>> entitiesByType = EDF_DbEntityUtils.GroupByType(entities);
+		foreach (typename entityType, array<ref EDF_DbEntity> typeEntities : entitiesByType)
+		{
+			SendHeldBackWritesNow(entityType);
+
+			string request = string.Format("%1%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+			string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverBulkRequest(typeEntities));
+			m_pContext.PUT_now(request, data);
+		}
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		if (entityIds.IsEmpty())
+			return EDF_EDbOperationStatusCode.SUCCESS;
+
+		return RemoveWhere(entityType, EDF_DbFind.Id().EqualsAnyOf(entityIds));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		SendHeldBackWritesNow(entityType);
+
+		string request = string.Format("%1/_delete%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverFindRequest(condition, null, -1, -1));
+		m_pContext.POST_now(request, data);
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		if (!entityId)
+			return EDF_EDbOperationStatusCode.FAILURE_ID_NOT_SET;
+
+		SendHeldBackWritesNow(entityType);
+
+		string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entityId, m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverPatchRequest(condition, patch));
+		string response = m_pContext.POST_now(request, data);
+		if (!condition)
+			return EDF_EDbOperationStatusCode.SUCCESS;
+
+		// Conditional operations answer with {"matched": <bool>}
+		if (response.IsEmpty())
+			return EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE;
+
+		SCR_JsonLoadContext reader();
+		bool matched;
+		if (!reader.ImportFromString(response) || !reader.ReadValue("matched", matched))
+			return EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED;
+
+		if (!matched)
+			return EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET;
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	override EDF_DbFindResultMultiple<EDF_DbEntity> FindAll(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1)
 	{
-		// Can not be implemented until https://feedback.bistudio.com/T166390 is fixed. Hopefully AR 0.9.9 or 0.9.10
-		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.FAILURE_NOT_IMPLEMENTED, {});
+		SendHeldBackWritesNow(entityType);
+
+		string request = string.Format("%1%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverFindRequest(condition, orderBy, limit, offset));
+		string response = m_pContext.POST_now(request, data);
+
+		// Even no matches come with the opening and closing line, nothing at all means the proxy did not answer
+		if (response.IsEmpty())
+			return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE, {});
+
+		array<ref EDF_DbEntity> entities();
+		EDF_WebProxyDbDriverResultReader reader(response, entityType);
+		if (!reader.Read(entities))
+			return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED, {});
+
+		return new EDF_DbFindResultMultiple<EDF_DbEntity>(EDF_EDbOperationStatusCode.SUCCESS, entities);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		int count;
+		EDF_EDbOperationStatusCode statusCode = CountNow(entityType, condition, -1, count);
+		return new EDF_DbCountResult(statusCode, count);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		int matches;
+		EDF_EDbOperationStatusCode statusCode = CountNow(entityType, condition, 1, matches);
+		return new EDF_DbExistsResult(statusCode, matches > 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		SendHeldBackWritesNow(entityType);
+
+		string request = string.Format("%1/_aggregate%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverAggregateRequest(condition, aggregation));
+		string response = m_pContext.POST_now(request, data);
+		if (response.IsEmpty())
+			return new EDF_DbAggregateResult(EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE);
+
+		SCR_JsonLoadContext reader();
+		array<ref EDF_DbAggregateGroup> groups();
+		if (!reader.ImportFromString(response) || !reader.ReadValue("groups", groups))
+			return new EDF_DbAggregateResult(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
+
+		return new EDF_DbAggregateResult(EDF_EDbOperationStatusCode.SUCCESS, groups);
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -351,10 +783,17 @@ class EDF_WebProxyDbDriver : EDF_DbDriver
 			return;
 		}
 
+		// Serialized right away, later changes to the entity must not end up in the held back write
 		typename entityType = entity.Type();
+		if (EDF_DbShutdownFlush.IsDraining() || m_iBatchWindow >= 0)
+		{
+			EnqueueWrite(entityType, entity.GetId(), EDF_DbEntityUtils.ToJson(entity), callback);
+			return;
+		}
+
 		string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entity.GetId(), m_sAddtionalParams);
-		string data = Serialize(entity);
-		m_pContext.PUT(new EDF_WebProxyDbDriverCallback(callback, verb: "PUT", url: request), request, data);
+		string data = SerializeRequest(entityType, entity);
+		SendRequest(EDF_EDbRequestPriority.BACKGROUND, entityType, "PUT", request, data, new EDF_WebProxyDbDriverCallback(callback, verb: "PUT", url: request));
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -369,148 +808,675 @@ class EDF_WebProxyDbDriver : EDF_DbDriver
 			return;
 		}
 
+		if (EDF_DbShutdownFlush.IsDraining() || m_iBatchWindow >= 0)
+		{
+			EnqueueWrite(entityType, entityId, string.Empty, callback);
+			return;
+		}
+
 		string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entityId, m_sAddtionalParams);
-		m_pContext.DELETE(new EDF_WebProxyDbDriverCallback(callback, verb: "DELETE", url: request), request, string.Empty);
+		SendRequest(EDF_EDbRequestPriority.BACKGROUND, entityType, "DELETE", request, string.Empty, new EDF_WebProxyDbDriverCallback(callback, verb: "DELETE", url: request));
 	}
 
 	//------------------------------------------------------------------------------------------------
-	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	override void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
 	{
-		/*
-		EDF_DbFindFieldCondition findField = EDF_DbFindFieldCondition.Cast(condition);
-		if (findField && findField.m_bUsesTypename)
+		if (s_bForceBlocking)
 		{
-			Debug.Error("Typename usage in find conditions currently unsupported by this driver.");
+			EDF_EDbOperationStatusCode statusCode = AddOrUpdateMany(entities);
 			if (callback)
-				callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_NOT_IMPLEMENTED, new array<ref EDF_DbEntity>());
+				callback.Invoke(statusCode);
+
+			return;
 		}
-		*/
 
-		if (s_bForceBlocking)
+		if (EDF_DbShutdownFlush.IsDraining())
 		{
-			EDF_DbFindResultMultiple<EDF_DbEntity> results = FindAll(entityType, condition, orderBy, limit, offset);
-			if (callback)
-				callback.Invoke(results.GetStatusCode(), results.GetEntities());
+			EDF_DbOperationStatusMultiCallback queuedCallback(entities.Count(), callback);
+			foreach (EDF_DbEntity entity : entities)
+			{
+				GetWriteQueue(entity.Type()).Enqueue(entity.GetId(), EDF_DbEntityUtils.ToJson(entity), queuedCallback);
+			}
 
 			return;
 		}
 
-		string request = string.Format("%1%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
-		string data = Serialize(new EDF_WebProxyDbDriverFindRequest(condition, orderBy, limit, offset));
+		// One multi document request per entity type instead of one per entity
+		map<typename, ref array<ref EDF_DbEntity>> entitiesByType = EDF_DbEntityUtils.GroupByType(entities);
+		EDF_DbOperationStatusMultiCallback multiCallback(entitiesByType.Count(), callback);
+		foreach (typename entityType, array<ref EDF_DbEntity> typeEntities : entitiesByType)
+		{
+			SendAddOrUpdateMany(entityType, typeEntities, multiCallback);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		if (s_bForceBlocking || entityIds.IsEmpty())
+		{
+			EDF_EDbOperationStatusCode statusCode = RemoveMany(entityType, entityIds);
+			if (callback)
+				callback.Invoke(statusCode);
+
+			return;
+		}
+
+		if (EDF_DbShutdownFlush.IsDraining())
+		{
+			EDF_WebProxyDbDriverWriteQueue queue = GetWriteQueue(entityType);
+			EDF_DbOperationStatusMultiCallback queuedCallback(entityIds.Count(), callback);
+			foreach (string entityId : entityIds)
+			{
+				queue.Enqueue(entityId, string.Empty, queuedCallback);
+			}
+
+			return;
+		}
+
+		RemoveWhereAsync(entityType, EDF_DbFind.Id().EqualsAnyOf(entityIds), callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		if (s_bForceBlocking || !entityId)
+		{
+			EDF_EDbOperationStatusCode statusCode = Patch(entityType, entityId, patch, condition);
+			if (callback)
+				callback.Invoke(statusCode);
+
+			return;
+		}
+
+		// Only the changed fields are sent as {"$set": {<fieldPath>: <value>}, "$inc": {...}}, the proxy applies them in one atomic update
+		string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entityId, m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverPatchRequest(condition, patch));
+		SendRequest(EDF_EDbRequestPriority.BACKGROUND, entityType, "POST", request, data, new EDF_WebProxyDbDriverCallback(callback, verb: "POST", url: request, readMatched: condition != null));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		if (s_bForceBlocking)
+		{
+			EDF_EDbOperationStatusCode statusCode = RemoveWhere(entityType, condition);
+			if (callback)
+				callback.Invoke(statusCode);
+
+			return;
+		}
+
+		// Delete by query, the proxy removes all matches in one go
+		string request = string.Format("%1/_delete%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverFindRequest(condition, null, -1, -1));
+		SendRequest(EDF_EDbRequestPriority.BACKGROUND, entityType, "POST", request, data, new EDF_WebProxyDbDriverCallback(callback, verb: "POST", url: request));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		/*
+		EDF_DbFindFieldCondition findField = EDF_DbFindFieldCondition.Cast(condition);
+		if (findField && findField.m_bUsesTypename)
+		{
+			Debug.Error("Typename usage in find conditions currently unsupported by this driver.");
+			if (callback)
+				callback.Invoke(EDF_EDbOperationStatusCode.FAILURE_NOT_IMPLEMENTED, new array<ref EDF_DbEntity>());
+		}
+		*/
+
+		if (s_bForceBlocking)
+		{
+			EDF_DbFindResultMultiple<EDF_DbEntity> results = FindAll(entityType, condition, orderBy, limit, offset);
+			if (callback)
+				callback.Invoke(results.GetStatusCode(), results.GetEntities());
+
+			return;
+		}
+
+		string request = string.Format("%1%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverFindRequest(condition, orderBy, limit, offset));
 		//Print(request);
 		//Print(data);
 		//System.ExportToClipboard(data);
-		m_pContext.POST(new EDF_WebProxyDbDriverCallback(callback, entityType, verb: "POST", url: request), request, data);
+		SendRequest(EDF_EDbRequestPriority.INTERACTIVE, entityType, "POST", request, data, new EDF_WebProxyDbDriverCallback(callback, entityType, verb: "POST", url: request, parseBudget: m_iParseBudget));
 	}
 
 	//------------------------------------------------------------------------------------------------
-	static string Serialize(Managed data)
+	override void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
 	{
-		ContainerSerializationSaveContext writer();
-		JsonSaveContainer jsonContainer = new JsonSaveContainer();
-		jsonContainer.SetMaxDecimalPlaces(5);
-		writer.SetContainer(jsonContainer);
-		writer.WriteValue("", data);
-		return jsonContainer.ExportToString();
+		if (s_bForceBlocking || !entityId)
+		{
+			super.FindByIdAsync(entityType, entityId, callback);
+			return;
+		}
+
+		if (m_bCoalesceLookups)
+		{
+			AddIdLookup(entityType, {entityId}, callback);
+			return;
+		}
+
+		SendFindById(entityType, entityId, callback);
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! TODO: Rely on https://feedback.bistudio.com/T173074 instead once added
-	static string MoveTypeDiscriminatorIn(string data, string discriminator = "_type")
+	override void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		if (s_bForceBlocking || !m_bCoalesceLookups || entityIds.IsEmpty())
+		{
+			super.FindByIdsAsync(entityType, entityIds, callback);
+			return;
+		}
+
+		AddIdLookup(entityType, entityIds, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		if (s_bForceBlocking)
+		{
+			EDF_DbCountResult countResult = Count(entityType, condition);
+			if (callback)
+				callback.Invoke(countResult.GetStatusCode(), countResult.GetCount());
+
+			return;
+		}
+
+		// Proxy answers with {"count": <number>} instead of the entities
+		string request = string.Format("%1/_count%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverFindRequest(condition, null, -1, -1));
+		SendRequest(EDF_EDbRequestPriority.INTERACTIVE, entityType, "POST", request, data, new EDF_WebProxyDbDriverCallback(callback, verb: "POST", url: request));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		if (s_bForceBlocking)
+		{
+			EDF_DbExistsResult existsResult = Exists(entityType, condition);
+			if (callback)
+				callback.Invoke(existsResult.GetStatusCode(), existsResult.Exists());
+
+			return;
+		}
+
+		// Re-use count endpoint but let the backend stop after the first match
+		string request = string.Format("%1/_count%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverFindRequest(condition, null, 1, -1));
+		SendRequest(EDF_EDbRequestPriority.INTERACTIVE, entityType, "POST", request, data, new EDF_WebProxyDbDriverCallback(callback, verb: "POST", url: request));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		if (s_bForceBlocking)
+		{
+			EDF_DbAggregateResult aggregateResult = Aggregate(entityType, aggregation, condition);
+			if (callback)
+				callback.Invoke(aggregateResult.GetStatusCode(), aggregateResult.GetGroups());
+
+			return;
+		}
+
+		// Backend computes the aggregation, proxy answers with {"groups": [{"key": ..., "values": {<alias>: <number>}}]}
+		string request = string.Format("%1/_aggregate%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverAggregateRequest(condition, aggregation));
+		SendRequest(EDF_EDbRequestPriority.INTERACTIVE, entityType, "POST", request, data, new EDF_WebProxyDbDriverCallback(callback, verb: "POST", url: request));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override int GetShutdownPendingCount()
+	{
+		int pending = m_pScheduler.GetQueuedCount();
+		foreach (typename entityType, EDF_WebProxyDbDriverWriteQueue queue : m_mWriteQueues)
+		{
+			pending += queue.GetPendingCount();
+		}
+
+		return pending;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void DrainShutdown(int maxConcurrency, int batchSize)
+	{
+		int inFlight;
+		foreach (typename entityType, EDF_WebProxyDbDriverWriteQueue queue : m_mWriteQueues)
+		{
+			inFlight += queue.m_iInFlightBatches;
+		}
+
+		foreach (typename entityType, EDF_WebProxyDbDriverWriteQueue queue : m_mWriteQueues)
+		{
+			while (inFlight < maxConcurrency && !queue.IsEmpty())
+			{
+				array<ref EDF_WebProxyDbDriverQueuedWrite> batch = queue.TakeBatch(batchSize);
+				if (batch.IsEmpty())
+					break; // Only ids that are still in flight left
+
+				SendWriteBatch(queue, batch, false);
+				inFlight++;
+			}
+
+			if (queue.IsEmpty())
+				SendBlockedRequests(queue);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void HardFlushShutdown()
+	{
+		if (!m_mIdLookups.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(FlushIdLookups);
+			FlushIdLookups();
+		}
+
+		m_pScheduler.Flush();
+
+		// Ids whose drain batch did not complete yet are written anyway, there is no later frame to wait for
+		foreach (typename entityType, EDF_WebProxyDbDriverWriteQueue queue : m_mWriteQueues)
+		{
+			array<ref EDF_WebProxyDbDriverRequest> blocked();
+			queue.TakeBlockedRequests(blocked);
+			SendWriteQueueNow(queue, EDF_DbShutdownFlush.s_iBatchSize, true);
+			foreach (EDF_WebProxyDbDriverRequest request : blocked)
+			{
+				SendRequestNow(request);
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Send the writes as one POST <type>/_bulk request, the proxy applies them as one bulk operation and lists the ops that failed
+	protected void SendWriteBatch(notnull EDF_WebProxyDbDriverWriteQueue queue, notnull array<ref EDF_WebProxyDbDriverQueuedWrite> batch, bool blocking)
+	{
+		typename entityType = queue.m_tEntityType;
+		string request = string.Format("%1/_bulk%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = EDF_WebProxyDbDriverBulkWriteRequest.Build(batch);
+		EDF_DbMetrics.RecordBytes(this, entityType, data.Length());
+
+		if (blocking)
+		{
+			string response = m_pContext.POST_now(request, data);
+			if (response.IsEmpty())
+			{
+				queue.Complete(batch, EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE);
+				return;
+			}
+
+			EDF_WebProxyDbDriverWriteBatchCallback blockingCallback(null, queue, batch);
+			blockingCallback.OnResponse(response);
+			return;
+		}
+
+		// Not through SendRequest, the batch was just taken from the queue that it would flush
+		EDF_WebProxyDbDriverWriteBatchCallback batchCallback(this, queue, batch);
+		m_pScheduler.Send(new EDF_WebProxyDbDriverRequest(EDF_EDbRequestPriority.BACKGROUND, entityType, "POST", request, data, new EDF_WebProxyDbDriverCallback(batchCallback, verb: "POST", url: request)));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Called by the write batch callbacks. Requests blocked behind writes of ids that were in flight can go once those writes were sent.
+	void OnWriteBatchFinished(notnull EDF_WebProxyDbDriverWriteQueue queue)
 	{
-		string quoutedDiscriminator = string.Format("\"%1\"", discriminator);
-		int typeDiscriminatorIdx = data.IndexOf(quoutedDiscriminator);
-		if (typeDiscriminatorIdx == -1)
-			return data;
+		if (!queue.HasBlockedRequests() || EDF_DbShutdownFlush.IsDraining())
+			return;
 
-		string processedString;
-		int dataPosition;
-		int dataLength = data.Length();
+		FlushWriteQueue(queue);
+		if (queue.IsEmpty())
+			SendBlockedRequests(queue);
+	}
 
-		while (true)
+	//------------------------------------------------------------------------------------------------
+	//! Hand the requests blocked behind the held back writes of the queue to the scheduler, in the order they were made
+	protected void SendBlockedRequests(notnull EDF_WebProxyDbDriverWriteQueue queue)
+	{
+		array<ref EDF_WebProxyDbDriverRequest> requests();
+		queue.TakeBlockedRequests(requests);
+		foreach (EDF_WebProxyDbDriverRequest request : requests)
 		{
-			// Add content until discriminator
-			processedString += data.Substring(dataPosition, typeDiscriminatorIdx - dataPosition);
+			m_pScheduler.Send(request);
+		}
+	}
 
-			// Extract discriminator
-			int discriminatorLength = data.IndexOfFrom(typeDiscriminatorIdx, ",") - typeDiscriminatorIdx + 1;
-			string typeDiscrimiantor = data.Substring(typeDiscriminatorIdx, discriminatorLength);
+	//------------------------------------------------------------------------------------------------
+	//! Send the requests of the type still waiting in the scheduler and all its held back writes with blocking requests,
+	//! so a blocking read or write is not overtaken by them. Requests already in flight can not be waited on.
+	protected void SendHeldBackWritesNow(typename entityType)
+	{
+		if (EDF_DbShutdownFlush.IsDraining())
+			return;
+
+		// Everything in the scheduler was made before the writes still held back and those before the blocked requests, see SendRequest.
+		// The blocked requests are taken first, so batches completing in between do not release them.
+		array<ref EDF_WebProxyDbDriverRequest> blocked();
+		EDF_WebProxyDbDriverWriteQueue queue = m_mWriteQueues.Get(entityType);
+		if (queue)
+			queue.TakeBlockedRequests(blocked);
+
+		array<ref EDF_WebProxyDbDriverRequest> requests();
+		m_pScheduler.TakeQueued(entityType, requests);
+		foreach (EDF_WebProxyDbDriverRequest request : requests)
+		{
+			SendRequestNow(request);
+		}
 
-			// Read remaining data until injection point
-			int injectionIndex = data.IndexOfFrom(typeDiscriminatorIdx + discriminatorLength, "{") + 1;
-			int skipOver = typeDiscriminatorIdx + discriminatorLength;
-			processedString += data.Substring(skipOver, injectionIndex - skipOver);
+		if (!queue)
+			return;
 
-			// Inject discriminator
-			processedString += typeDiscrimiantor;
+		SendWriteQueueNow(queue, m_iBatchSize, true);
+		foreach (EDF_WebProxyDbDriverRequest request : blocked)
+		{
+			SendRequestNow(request);
+		}
+	}
 
-			dataPosition = injectionIndex;
-			typeDiscriminatorIdx = data.IndexOfFrom(skipOver, quoutedDiscriminator);
-			if (typeDiscriminatorIdx == -1)
+	//------------------------------------------------------------------------------------------------
+	//! Send a request taken from the scheduler with the blocking call of its verb and answer its callback right away
+	protected void SendRequestNow(notnull EDF_WebProxyDbDriverRequest request)
+	{
+		string response;
+		switch (request.m_sVerb)
+		{
+			case "GET":
+			{
+				response = m_pContext.GET_now(request.m_sUrl);
+				break;
+			}
+
+			case "PUT":
+			{
+				response = m_pContext.PUT_now(request.m_sUrl, request.m_sData);
+				break;
+			}
+
+			case "DELETE":
+			{
+				response = m_pContext.DELETE_now(request.m_sUrl, request.m_sData);
+				break;
+			}
+
+			default:
 			{
-				processedString += data.Substring(dataPosition, dataLength - dataPosition);
+				response = m_pContext.POST_now(request.m_sUrl, request.m_sData);
 				break;
 			}
 		}
 
-		return processedString;
+		request.m_pCallback.OnBlockingResponse(response);
 	}
 
 	//------------------------------------------------------------------------------------------------
-	static string MoveTypeDiscriminatorOut(string data, string discriminator = "_type")
+	//! \param includeInFlight also send writes of ids whose earlier batch has not completed yet
+	protected void SendWriteQueueNow(notnull EDF_WebProxyDbDriverWriteQueue queue, int batchSize, bool includeInFlight = false)
+	{
+		while (!queue.IsEmpty())
+		{
+			array<ref EDF_WebProxyDbDriverQueuedWrite> batch = queue.TakeBatch(batchSize, includeInFlight);
+			if (batch.IsEmpty())
+				break; // Only ids that are still in flight left
+
+			SendWriteBatch(queue, batch, true);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Blocking POST <type>/_count, answered with {"count": <number>}
+	//! \param limit stop counting after this many matches, -1 for no limit
+	protected EDF_EDbOperationStatusCode CountNow(typename entityType, EDF_DbFindCondition condition, int limit, out int count)
+	{
+		SendHeldBackWritesNow(entityType);
+
+		string request = string.Format("%1/_count%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverFindRequest(condition, null, limit, -1));
+		string response = m_pContext.POST_now(request, data);
+		if (response.IsEmpty())
+			return EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE;
+
+		SCR_JsonLoadContext reader();
+		if (!reader.ImportFromString(response) || !reader.ReadValue("count", count))
+			return EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED;
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Hold the write back until the batch window ends. A full batch is sent right away.
+	protected void EnqueueWrite(typename entityType, string entityId, string data, EDF_DbOperationStatusOnlyCallback callback)
+	{
+		EDF_WebProxyDbDriverWriteQueue queue = GetWriteQueue(entityType);
+
+		// Shutdown flush drains the queues itself
+		if (EDF_DbShutdownFlush.IsDraining())
+		{
+			queue.Enqueue(entityId, data, callback);
+			return;
+		}
+
+		// Must not be batched ahead of the requests made before it, so it waits behind them as a request of its own
+		if (queue.HasBlockedRequests())
+		{
+			string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entityId, m_sAddtionalParams);
+			string verb = "PUT";
+			if (!data)
+				verb = "DELETE";
+
+			EDF_DbMetrics.RecordBytes(this, entityType, data.Length());
+			queue.Block(new EDF_WebProxyDbDriverRequest(EDF_EDbRequestPriority.BACKGROUND, entityType, verb, request, data, new EDF_WebProxyDbDriverCallback(callback, verb: verb, url: request)));
+			return;
+		}
+
+		queue.Enqueue(entityId, data, callback);
+
+		if (queue.GetQueuedCount() >= m_iBatchSize)
+		{
+			FlushWriteQueue(queue);
+			return;
+		}
+
+		ScheduleWriteFlush();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void ScheduleWriteFlush()
+	{
+		if (m_bWriteFlushScheduled)
+			return;
+
+		m_bWriteFlushScheduled = true;
+		GetGame().GetCallqueue().CallLater(FlushWrites, Math.Max(m_iBatchWindow, 0));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void FlushWrites()
+	{
+		m_bWriteFlushScheduled = false;
+		if (EDF_DbShutdownFlush.IsDraining())
+			return;
+
+		bool waiting;
+		foreach (typename entityType, EDF_WebProxyDbDriverWriteQueue queue : m_mWriteQueues)
+		{
+			FlushWriteQueue(queue);
+			if (queue.IsEmpty())
+			{
+				SendBlockedRequests(queue);
+			}
+			else
+			{
+				waiting = true;
+			}
+		}
+
+		// Newer writes of ids that were still in flight
+		if (waiting)
+			ScheduleWriteFlush();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Send the writes of ids that are not in flight, the others wait for their earlier batch to complete
+	protected void FlushWriteQueue(notnull EDF_WebProxyDbDriverWriteQueue queue)
 	{
-		string quoutedDiscriminator = string.Format("\"%1\"", discriminator);
-		int typeDiscriminatorIdx = data.IndexOf(quoutedDiscriminator);
-		if (typeDiscriminatorIdx == -1)
-			return data;
+		while (!queue.IsEmpty())
+		{
+			array<ref EDF_WebProxyDbDriverQueuedWrite> batch = queue.TakeBatch(m_iBatchSize);
+			if (batch.IsEmpty())
+				break; // Only ids that are still in flight left
 
-		string processedString;
-		int dataPosition;
-		int dataLength = data.Length();
+			SendWriteBatch(queue, batch, false);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Hold the lookup back until the end of the frame, so all lookups of the type go out as one request
+	protected void AddIdLookup(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback)
+	{
+		if (m_mIdLookups.IsEmpty())
+			GetGame().GetCallqueue().CallLater(FlushIdLookups);
 
-		while (true)
+		EDF_WebProxyDbDriverIdLookupBatch batch = m_mIdLookups.Get(entityType);
+		if (!batch)
 		{
-			// Extract discriminator
-			int discriminatorLength = data.IndexOfFrom(typeDiscriminatorIdx, ",") - typeDiscriminatorIdx + 1;
-			string typeDiscrimiantor = data.Substring(typeDiscriminatorIdx, discriminatorLength);
+			batch = new EDF_WebProxyDbDriverIdLookupBatch(entityType);
+			m_mIdLookups.Set(entityType, batch);
+		}
 
-			// Find injection position
-			int injectAt = -1, remainingBrackes = 2;
-			for (int nChar = typeDiscriminatorIdx - 1; nChar >= 0; nChar--)
+		batch.Add(entityIds, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void FlushIdLookups()
+	{
+		map<typename, ref EDF_WebProxyDbDriverIdLookupBatch> lookups = m_mIdLookups;
+		m_mIdLookups = new map<typename, ref EDF_WebProxyDbDriverIdLookupBatch>();
+
+		foreach (typename entityType, EDF_WebProxyDbDriverIdLookupBatch batch : lookups)
+		{
+			// A lone lookup needs no fan out
+			array<ref EDF_WebProxyDbDriverIdLookupRequest> requests = batch.GetRequests();
+			if (requests.Count() == 1)
 			{
-				if ((data.Get(nChar) == "\"") && (--remainingBrackes == 0))
+				EDF_WebProxyDbDriverIdLookupRequest lookup = requests.Get(0);
+				if (lookup.m_aEntityIds.Count() == 1)
 				{
-					injectAt = nChar;
-					break;
+					SendFindById(entityType, lookup.m_aEntityIds.Get(0), lookup.m_pCallback);
+				}
+				else
+				{
+					FindAllAsync(entityType, EDF_DbFind.Id().EqualsAnyOf(lookup.m_aEntityIds), callback: new EDF_DbFindByIdsOrderCallback(lookup.m_aEntityIds, lookup.m_pCallback));
 				}
-			}
 
-			// Get data in front
-			processedString += data.Substring(dataPosition, injectAt - dataPosition);
+				continue;
+			}
 
-			// Inject type discriminator
-			processedString += typeDiscrimiantor;
+			FindAllAsync(entityType, EDF_DbFind.Id().EqualsAnyOf(batch.GetEntityIds()), callback: new EDF_WebProxyDbDriverIdLookupCallback(batch));
+		}
+	}
 
-			// Add data from in between
-			processedString += data.Substring(injectAt, typeDiscriminatorIdx - injectAt);
+	//------------------------------------------------------------------------------------------------
+	//! Direct lookup, no condition needs to be built or evaluated
+	protected void SendFindById(typename entityType, string entityId, EDF_DbFindCallbackBase callback)
+	{
+		string request = string.Format("%1/%2%3", EDF_DbName.Get(entityType), entityId, m_sAddtionalParams);
+		SendRequest(EDF_EDbRequestPriority.INTERACTIVE, entityType, "GET", request, string.Empty, new EDF_WebProxyDbDriverCallback(callback, entityType, verb: "GET", url: request, singleEntity: true));
+	}
 
-			// Continue behind original position
-			dataPosition = typeDiscriminatorIdx + discriminatorLength;
+	//------------------------------------------------------------------------------------------------
+	//! Save multiple entities of the same type with one PUT <type> {"entities": [...]} request.
+	//! Unlike POST <type>/_bulk of the write queue there is only one callback, so no per id result is needed.
+	protected void SendAddOrUpdateMany(typename entityType, notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback)
+	{
+		string request = string.Format("%1%2", EDF_DbName.Get(entityType), m_sAddtionalParams);
+		string data = SerializeRequest(entityType, new EDF_WebProxyDbDriverBulkRequest(entities));
+		SendRequest(EDF_EDbRequestPriority.BACKGROUND, entityType, "PUT", request, data, new EDF_WebProxyDbDriverCallback(callback, verb: "PUT", url: request));
+	}
 
-			typeDiscriminatorIdx = data.IndexOfFrom(dataPosition, quoutedDiscriminator);
-			if (typeDiscriminatorIdx == -1)
+	//------------------------------------------------------------------------------------------------
+	protected void SendRequest(EDF_EDbRequestPriority priority, typename entityType, string verb, string request, string data, notnull EDF_WebProxyDbDriverCallback callback)
+	{
+		// Held back writes of the type go first. Otherwise reads return data older than them
+		// and a later bulk write would undo patches or removals or bring back removed entities.
+		EDF_WebProxyDbDriverRequest webRequest(priority, entityType, verb, request, data, callback);
+		if (!EDF_DbShutdownFlush.IsDraining())
+		{
+			EDF_WebProxyDbDriverWriteQueue queue = m_mWriteQueues.Get(entityType);
+			if (queue)
 			{
-				processedString += data.Substring(dataPosition, dataLength - dataPosition);
-				break;
+				FlushWriteQueue(queue);
+
+				// Writes of ids still in flight can not be sent yet, a second batch could land before the first one
+				if (!queue.IsEmpty() || queue.HasBlockedRequests())
+				{
+					queue.Block(webRequest);
+					return;
+				}
 			}
 		}
 
-		return processedString;
+		m_pScheduler.Send(webRequest);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Requests waiting for a free slot and in flight, see m_iMaxInFlight of the connection info
+	EDF_WebProxyDbDriverScheduler GetScheduler()
+	{
+		return m_pScheduler;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected EDF_WebProxyDbDriverWriteQueue GetWriteQueue(typename entityType)
+	{
+		EDF_WebProxyDbDriverWriteQueue queue = m_mWriteQueues.Get(entityType);
+		if (!queue)
+		{
+			queue = new EDF_WebProxyDbDriverWriteQueue(entityType);
+			m_mWriteQueues.Set(entityType, queue);
+		}
+
+		return queue;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected string SerializeRequest(typename entityType, Managed data)
+	{
+		string serialized = EDF_DbEntityUtils.ToJson(data);
+		EDF_DbMetrics.RecordBytes(this, entityType, serialized.Length());
+		return serialized;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Kept for existing callers, same as EDF_DbEntityUtils.ToJson
+	static string Serialize(Managed data)
+	{
+		return EDF_DbEntityUtils.ToJson(data);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! TODO: Rely on https://feedback.bistudio.com/T173074 instead once added
+	static string MoveTypeDiscriminatorIn(string data, string discriminator = "_type")
+	{
+		return EDF_WebProxyDbDriverTypeDiscriminator.MoveIn(data, discriminator);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string MoveTypeDiscriminatorOut(string data, string discriminator = "_type")
+	{
+		return EDF_WebProxyDbDriverTypeDiscriminator.MoveOut(data, discriminator);
 	}
 
 	//------------------------------------------------------------------------------------------------
 	void ~EDF_WebProxyDbDriver()
 	{
+		EDF_DbShutdownFlush.Unregister(this);
+
+		if (m_bWriteFlushScheduled && GetGame())
+			GetGame().GetCallqueue().Remove(FlushWrites);
+
+		if (!m_mIdLookups.IsEmpty() && GetGame())
+			GetGame().GetCallqueue().Remove(FlushIdLookups);
+
 		if (!m_pContext)
 			return;
 
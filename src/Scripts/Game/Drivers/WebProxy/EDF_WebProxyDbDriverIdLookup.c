@@ -0,0 +1,120 @@
+class EDF_WebProxyDbDriverIdLookupRequest
+{
+	ref array<string> m_aEntityIds;
+	ref EDF_DbFindCallbackBase m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverIdLookupRequest(array<string> entityIds, EDF_DbFindCallbackBase callback)
+	{
+		m_aEntityIds = entityIds;
+		m_pCallback = callback;
+	}
+};
+
+//! Id lookups of one entity type made in the same frame. They are sent as one EqualsAnyOf find and the results are handed back to each lookup.
+class EDF_WebProxyDbDriverIdLookupBatch
+{
+	typename m_tEntityType;
+
+	protected ref array<ref EDF_WebProxyDbDriverIdLookupRequest> m_aRequests = {};
+	protected ref set<string> m_aEntityIds = new set<string>();
+
+	//------------------------------------------------------------------------------------------------
+	void Add(notnull array<string> entityIds, EDF_DbFindCallbackBase callback)
+	{
+		// Copy, the caller may reuse its array before the lookup is sent
+		array<string> requestedIds();
+		requestedIds.Copy(entityIds);
+		m_aRequests.Insert(new EDF_WebProxyDbDriverIdLookupRequest(requestedIds, callback));
+		foreach (string entityId : entityIds)
+		{
+			m_aEntityIds.Insert(entityId);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return all requested ids without duplicates
+	array<string> GetEntityIds()
+	{
+		array<string> entityIds();
+		entityIds.Reserve(m_aEntityIds.Count());
+		foreach (string entityId : m_aEntityIds)
+		{
+			entityIds.Insert(entityId);
+		}
+
+		return entityIds;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	array<ref EDF_WebProxyDbDriverIdLookupRequest> GetRequests()
+	{
+		return m_aRequests;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Give every lookup the entities of its ids in the requested order
+	void Complete(EDF_EDbOperationStatusCode statusCode, array<ref EDF_DbEntity> findResults)
+	{
+		map<string, EDF_DbEntity> entitiesById();
+		if (statusCode == EDF_EDbOperationStatusCode.SUCCESS && findResults)
+		{
+			foreach (EDF_DbEntity entity : findResults)
+			{
+				entitiesById.Set(entity.GetId(), entity);
+			}
+		}
+
+		// Lookups of the same id must not share one instance, later ones get a copy
+		set<string> handedOut();
+		foreach (EDF_WebProxyDbDriverIdLookupRequest request : m_aRequests)
+		{
+			if (!request.m_pCallback)
+				continue;
+
+			array<ref EDF_DbEntity> results();
+			foreach (string entityId : request.m_aEntityIds)
+			{
+				EDF_DbEntity entity = entitiesById.Get(entityId);
+				if (!entity)
+					continue;
+
+				if (handedOut.Contains(entityId))
+				{
+					entity = EDF_DbEntityUtils.DeepCopy(entity);
+				}
+				else
+				{
+					handedOut.Insert(entityId);
+				}
+
+				results.Insert(entity);
+			}
+
+			request.m_pCallback.Invoke(statusCode, results);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverIdLookupBatch(typename entityType)
+	{
+		m_tEntityType = entityType;
+	}
+};
+
+class EDF_WebProxyDbDriverIdLookupCallback : EDF_DbFindCallbackBase
+{
+	protected ref EDF_WebProxyDbDriverIdLookupBatch m_pBatch;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		m_pBatch.Complete(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverIdLookupCallback(EDF_WebProxyDbDriverIdLookupBatch batch)
+	{
+		m_pBatch = batch;
+	}
+};
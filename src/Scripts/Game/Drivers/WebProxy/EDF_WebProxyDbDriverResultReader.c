@@ -0,0 +1,94 @@
+//! Reads the entities of a FindAll response one line at a time. The response has one entity json per line between an opening and a closing line.
+//! Lines are located by offset, so neither a line array nor a second copy of the payload is created and reading can stop and continue later.
+class EDF_WebProxyDbDriverResultReader
+{
+	protected string m_sData;
+	protected typename m_tResultType;
+	protected int m_iPosition;
+	protected int m_iEnd;
+	protected bool m_bFailed;
+	protected ref SCR_JsonLoadContext m_pReader = new SCR_JsonLoadContext();
+
+	//------------------------------------------------------------------------------------------------
+	//! Read up to maxEntities further entities
+	//! \param maxEntities 0 or less to read all remaining ones
+	//! \return false if a line could not be read as entity
+	bool Read(notnull array<ref EDF_DbEntity> results, int maxEntities = 0)
+	{
+		if (m_bFailed)
+			return false;
+
+		int read;
+		while (m_iPosition < m_iEnd && (maxEntities <= 0 || read < maxEntities))
+		{
+			int lineEnd = m_sData.IndexOfFrom(m_iPosition, "\n");
+			if (lineEnd == -1 || lineEnd > m_iEnd)
+				lineEnd = m_iEnd;
+
+			int lineLength = lineEnd - m_iPosition;
+			if (lineLength > 0)
+			{
+				EDF_DbEntity entity = EDF_DbEntity.Cast(m_tResultType.Spawn());
+				if (!m_pReader.ImportFromString(m_sData.Substring(m_iPosition, lineLength)) || !m_pReader.ReadValue("", entity))
+				{
+					m_bFailed = true;
+					return false;
+				}
+
+				results.Insert(entity);
+				read++;
+			}
+
+			m_iPosition = lineEnd + 1;
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsFinished()
+	{
+		return m_bFailed || m_iPosition >= m_iEnd;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverResultReader(string data, typename resultType)
+	{
+		m_sData = data;
+		m_tResultType = resultType;
+
+		int length = data.Length();
+
+		// Skip the opening line
+		while (m_iPosition < length && data.Get(m_iPosition) == "\n")
+		{
+			m_iPosition++;
+		}
+
+		m_iPosition = data.IndexOfFrom(m_iPosition, "\n");
+		if (m_iPosition == -1)
+		{
+			m_iPosition = length;
+			return;
+		}
+
+		m_iPosition++;
+
+		// Entities end where the closing line starts
+		int end = length;
+		while (end > m_iPosition && data.Get(end - 1) == "\n")
+		{
+			end--;
+		}
+
+		m_iEnd = m_iPosition;
+		for (int nChar = end - 1; nChar >= m_iPosition; nChar--)
+		{
+			if (data.Get(nChar) == "\n")
+			{
+				m_iEnd = nChar;
+				break;
+			}
+		}
+	}
+};
@@ -0,0 +1,363 @@
+enum EDF_EDbRequestPriority
+{
+	INTERACTIVE,	//!< Reads someone is waiting on, e.g. a player join lookup
+	BACKGROUND		//!< Writes like autosaves, nobody waits on them
+};
+
+class EDF_WebProxyDbDriverRequest
+{
+	EDF_EDbRequestPriority m_ePriority;
+	typename m_tEntityType;
+	string m_sVerb;
+	string m_sUrl;
+	string m_sData;
+	ref EDF_WebProxyDbDriverCallback m_pCallback;
+	int m_iQueuedAt;
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverRequest(EDF_EDbRequestPriority priority, typename entityType, string verb, string url, string data, EDF_WebProxyDbDriverCallback callback)
+	{
+		m_ePriority = priority;
+		m_tEntityType = entityType;
+		m_sVerb = verb;
+		m_sUrl = url;
+		m_sData = data;
+		m_pCallback = callback;
+	}
+};
+
+//! Requests of one entity type in the order they were made
+class EDF_WebProxyDbDriverTypeQueue
+{
+	protected ref array<ref EDF_WebProxyDbDriverRequest> m_aRequests = {};
+	protected int m_iHead;
+
+	//------------------------------------------------------------------------------------------------
+	void Enqueue(notnull EDF_WebProxyDbDriverRequest request)
+	{
+		m_aRequests.Insert(request);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_WebProxyDbDriverRequest Dequeue()
+	{
+		EDF_WebProxyDbDriverRequest request = m_aRequests.Get(m_iHead++);
+
+		// Drop the taken requests in one go instead of shifting the array on every dequeue
+		if (m_iHead == m_aRequests.Count())
+		{
+			m_aRequests.Clear();
+			m_iHead = 0;
+		}
+		else if (m_iHead >= 64 && m_iHead * 2 >= m_aRequests.Count())
+		{
+			array<ref EDF_WebProxyDbDriverRequest> remaining();
+			remaining.Reserve(m_aRequests.Count() - m_iHead);
+			for (int nRequest = m_iHead, count = m_aRequests.Count(); nRequest < count; nRequest++)
+			{
+				remaining.Insert(m_aRequests.Get(nRequest));
+			}
+
+			m_aRequests = remaining;
+			m_iHead = 0;
+		}
+
+		return request;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Move all requests into the array, oldest first
+	void DequeueAll(notnull array<ref EDF_WebProxyDbDriverRequest> requests)
+	{
+		for (int nRequest = m_iHead, count = m_aRequests.Count(); nRequest < count; nRequest++)
+		{
+			requests.Insert(m_aRequests.Get(nRequest));
+		}
+
+		m_aRequests.Clear();
+		m_iHead = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aRequests.Count() - m_iHead;
+	}
+};
+
+//! Requests of one priority. Every entity type keeps its own order and the types take turns, so one bulk save can not hold back all others.
+class EDF_WebProxyDbDriverPriorityQueue
+{
+	protected ref map<typename, ref EDF_WebProxyDbDriverTypeQueue> m_mTypeQueues = new map<typename, ref EDF_WebProxyDbDriverTypeQueue>();
+	protected ref array<typename> m_aTurnOrder = {}; // Types with waiting requests
+	protected int m_iNextTurn;
+	protected int m_iCount;
+
+	//------------------------------------------------------------------------------------------------
+	void Enqueue(notnull EDF_WebProxyDbDriverRequest request)
+	{
+		EDF_WebProxyDbDriverTypeQueue typeQueue = m_mTypeQueues.Get(request.m_tEntityType);
+		if (!typeQueue)
+		{
+			typeQueue = new EDF_WebProxyDbDriverTypeQueue();
+			m_mTypeQueues.Set(request.m_tEntityType, typeQueue);
+		}
+
+		if (typeQueue.Count() == 0)
+			m_aTurnOrder.Insert(request.m_tEntityType);
+
+		typeQueue.Enqueue(request);
+		m_iCount++;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return oldest request of the type whose turn it is, null if empty
+	EDF_WebProxyDbDriverRequest Dequeue()
+	{
+		if (m_iCount == 0)
+			return null;
+
+		if (m_iNextTurn >= m_aTurnOrder.Count())
+			m_iNextTurn = 0;
+
+		typename entityType = m_aTurnOrder.Get(m_iNextTurn);
+		EDF_WebProxyDbDriverTypeQueue typeQueue = m_mTypeQueues.Get(entityType);
+		EDF_WebProxyDbDriverRequest request = typeQueue.Dequeue();
+		m_iCount--;
+
+		if (typeQueue.Count() == 0)
+		{
+			// Next type moves into the current turn slot
+			m_aTurnOrder.RemoveOrdered(m_iNextTurn);
+			m_mTypeQueues.Remove(entityType);
+		}
+		else
+		{
+			m_iNextTurn++;
+		}
+
+		return request;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Move all requests of the type into the array, oldest first. The other types keep their turns.
+	void DequeueAll(typename entityType, notnull array<ref EDF_WebProxyDbDriverRequest> requests)
+	{
+		EDF_WebProxyDbDriverTypeQueue typeQueue = m_mTypeQueues.Get(entityType);
+		if (!typeQueue)
+			return;
+
+		m_iCount -= typeQueue.Count();
+		typeQueue.DequeueAll(requests);
+		m_mTypeQueues.Remove(entityType);
+
+		int turn = m_aTurnOrder.Find(entityType);
+		m_aTurnOrder.RemoveOrdered(turn);
+		if (turn < m_iNextTurn)
+			m_iNextTurn--;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_iCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int Count(typename entityType)
+	{
+		EDF_WebProxyDbDriverTypeQueue typeQueue = m_mTypeQueues.Get(entityType);
+		if (!typeQueue)
+			return 0;
+
+		return typeQueue.Count();
+	}
+};
+
+//! Limits the requests the web proxy driver has in flight. Waiting requests are sent by priority, interactive reads before background writes.
+//! A read only overtakes waiting writes of other entity types, so it never returns data older than a write made before it.
+class EDF_WebProxyDbDriverScheduler
+{
+	protected EDF_WebProxyDbDriver m_pDriver;
+	protected RestContext m_pContext;
+	protected int m_iMaxInFlight;
+	protected int m_iInFlight;
+	protected int m_iPeakQueued;
+	protected ref array<ref EDF_WebProxyDbDriverPriorityQueue> m_aQueues = {};
+
+	//------------------------------------------------------------------------------------------------
+	//! Send the request now if a slot is free, otherwise queue it
+	void Send(notnull EDF_WebProxyDbDriverRequest request)
+	{
+		// Keep the order with writes of the same type still waiting
+		if (request.m_ePriority == EDF_EDbRequestPriority.INTERACTIVE && m_aQueues.Get(EDF_EDbRequestPriority.BACKGROUND).Count(request.m_tEntityType) > 0)
+			request.m_ePriority = EDF_EDbRequestPriority.BACKGROUND;
+
+		if (HasFreeSlot() && GetQueuedCount() == 0)
+		{
+			Dispatch(request);
+			return;
+		}
+
+		request.m_iQueuedAt = System.GetTickCount();
+		m_aQueues.Get(request.m_ePriority).Enqueue(request);
+		m_iPeakQueued = Math.Max(m_iPeakQueued, GetQueuedCount());
+		RecordQueueDepth(request.m_tEntityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Called by the request callbacks once an answer, error or timeout arrived
+	void OnRequestFinished()
+	{
+		m_iInFlight--;
+		DispatchQueued();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Send all waiting requests regardless of the limit, e.g. before the session ends
+	void Flush()
+	{
+		int maxInFlight = m_iMaxInFlight;
+		m_iMaxInFlight = 0;
+		DispatchQueued();
+		m_iMaxInFlight = maxInFlight;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Take the waiting requests of the type out of the queues, e.g. to send them blocking instead
+	//! \param[out] requests in the order they have to be sent
+	void TakeQueued(typename entityType, notnull array<ref EDF_WebProxyDbDriverRequest> requests)
+	{
+		// Interactive requests of a type only wait while none of its background requests do, so they are the older ones
+		foreach (EDF_WebProxyDbDriverPriorityQueue queue : m_aQueues)
+		{
+			queue.DequeueAll(entityType, requests);
+		}
+
+		RecordQueueDepth(entityType);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return requests waiting for a free slot
+	int GetQueuedCount()
+	{
+		int queued;
+		foreach (EDF_WebProxyDbDriverPriorityQueue queue : m_aQueues)
+		{
+			queued += queue.Count();
+		}
+
+		return queued;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetQueuedCount(EDF_EDbRequestPriority priority)
+	{
+		return m_aQueues.Get(priority).Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return most requests that were waiting at the same time
+	int GetPeakQueuedCount()
+	{
+		return m_iPeakQueued;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetInFlightCount()
+	{
+		return m_iInFlight;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool HasFreeSlot()
+	{
+		return m_iMaxInFlight <= 0 || m_iInFlight < m_iMaxInFlight;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void DispatchQueued()
+	{
+		while (HasFreeSlot())
+		{
+			EDF_WebProxyDbDriverRequest request = null;
+			foreach (EDF_WebProxyDbDriverPriorityQueue queue : m_aQueues)
+			{
+				request = queue.Dequeue();
+				if (request)
+					break;
+			}
+
+			if (!request)
+				return;
+
+			if (m_pDriver)
+				EDF_DbMetrics.RecordOperation(m_pDriver.ClassName(), request.m_tEntityType, "QueueWait", EDF_EDbOperationStatusCode.SUCCESS, System.GetTickCount() - request.m_iQueuedAt);
+
+			RecordQueueDepth(request.m_tEntityType);
+			Dispatch(request);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Dispatch(EDF_WebProxyDbDriverRequest request)
+	{
+		m_iInFlight++;
+		request.m_pCallback.SetScheduler(this);
+
+		switch (request.m_sVerb)
+		{
+			case "GET":
+			{
+				m_pContext.GET(request.m_pCallback, request.m_sUrl);
+				break;
+			}
+
+			case "PUT":
+			{
+				m_pContext.PUT(request.m_pCallback, request.m_sUrl, request.m_sData);
+				break;
+			}
+
+			case "DELETE":
+			{
+				m_pContext.DELETE(request.m_pCallback, request.m_sUrl, request.m_sData);
+				break;
+			}
+
+			default:
+			{
+				m_pContext.POST(request.m_pCallback, request.m_sUrl, request.m_sData);
+				break;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void RecordQueueDepth(typename entityType)
+	{
+		if (!m_pDriver || !EDF_DbMetrics.s_bEnabled)
+			return;
+
+		int depth;
+		foreach (EDF_WebProxyDbDriverPriorityQueue queue : m_aQueues)
+		{
+			depth += queue.Count(entityType);
+		}
+
+		EDF_DbMetrics.RecordQueueDepth(m_pDriver, entityType, depth);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param maxInFlight max. requests sent at the same time, 0 for no limit
+	void EDF_WebProxyDbDriverScheduler(notnull EDF_WebProxyDbDriver driver, RestContext context, int maxInFlight)
+	{
+		m_pDriver = driver;
+		m_pContext = context;
+		m_iMaxInFlight = maxInFlight;
+
+		// Indexed by EDF_EDbRequestPriority
+		m_aQueues.Insert(new EDF_WebProxyDbDriverPriorityQueue());
+		m_aQueues.Insert(new EDF_WebProxyDbDriverPriorityQueue());
+	}
+};
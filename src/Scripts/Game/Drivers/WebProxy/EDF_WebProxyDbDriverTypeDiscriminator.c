@@ -0,0 +1,363 @@
+//! Moves type discriminators of polymorphic values between the object and the member holding it:
+//! In:  "_type": "A", "m_pItem": {"x": 1}  ->  "m_pItem": {"_type": "A", "x": 1}
+//! Out: "m_pItem": {"_type": "A", "x": 1}  ->  "_type": "A", "m_pItem": {"x": 1}
+//! The json is scanned once. Strings are skipped as a whole, so discriminators, braces or escaped quotes inside of string values are left alone.
+//! Changes are collected as edits and the result is joined from the unchanged parts in between, instead of growing one string per change.
+class EDF_WebProxyDbDriverTypeDiscriminator
+{
+	protected string m_sData;
+	protected int m_iLength;
+	protected string m_sDiscriminator;
+	protected bool m_bMoveIn;
+	protected ref array<ref EDF_WebProxyDbDriverJsonEdit> m_aEdits = {};
+	protected ref array<ref EDF_WebProxyDbDriverJsonFrame> m_aFrames = {};
+
+	//------------------------------------------------------------------------------------------------
+	static string MoveIn(string data, string discriminator = "_type")
+	{
+		return Rewrite(data, discriminator, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string MoveOut(string data, string discriminator = "_type")
+	{
+		return Rewrite(data, discriminator, false);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static string Rewrite(string data, string discriminator, bool moveIn)
+	{
+		// Nothing to do for the common case of non polymorphic data
+		if (data.IndexOf(string.Format("\"%1\"", discriminator)) == -1)
+			return data;
+
+		EDF_WebProxyDbDriverTypeDiscriminator rewriter(data, discriminator, moveIn);
+		rewriter.Scan();
+		return rewriter.Apply();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Scan()
+	{
+		int position;
+		while (position < m_iLength)
+		{
+			string char = m_sData.Get(position);
+			switch (char)
+			{
+				case "\"":
+				{
+					position = ReadString(position);
+					break;
+				}
+
+				case "{":
+				{
+					EDF_WebProxyDbDriverJsonFrame frame(true);
+					frame.m_iEditIndex = m_aEdits.Count();
+					EDF_WebProxyDbDriverJsonFrame parent = GetFrame();
+					if (parent && parent.m_bObject)
+						frame.m_iOwnerKeyStart = parent.m_iKeyStart;
+
+					m_aFrames.Insert(frame);
+					position++;
+					break;
+				}
+
+				case "[":
+				{
+					m_aFrames.Insert(new EDF_WebProxyDbDriverJsonFrame(false));
+					position++;
+					break;
+				}
+
+				case "}":
+				case "]":
+				{
+					if (!m_aFrames.IsEmpty())
+						m_aFrames.Remove(m_aFrames.Count() - 1);
+
+					position++;
+					break;
+				}
+
+				case ",":
+				{
+					EDF_WebProxyDbDriverJsonFrame frame = GetFrame();
+					if (frame && frame.m_bObject)
+					{
+						frame.m_bExpectKey = true;
+						frame.m_iLastComma = position;
+					}
+
+					position++;
+					break;
+				}
+
+				default:
+				{
+					position++;
+					break;
+				}
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return position after the string starting at the quote
+	protected int ReadString(int start)
+	{
+		int end = FindStringEnd(start);
+
+		EDF_WebProxyDbDriverJsonFrame frame = GetFrame();
+		if (!frame || !frame.m_bObject || !frame.m_bExpectKey)
+			return end + 1;
+
+		// Member key
+		frame.m_bExpectKey = false;
+		frame.m_iKeyStart = start;
+
+		int keyLength = end - start - 1;
+		if (keyLength == m_sDiscriminator.Length() && m_sData.Substring(start + 1, keyLength) == m_sDiscriminator)
+		{
+			int next = ReadDiscriminator(frame, start, end);
+			if (next != -1)
+				return next;
+		}
+		else if (m_bMoveIn && frame.m_iPendingEdit != -1)
+		{
+			InjectPending(frame, end + 1);
+		}
+
+		return end + 1;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return position to continue at or -1 if the member stays where it is
+	protected int ReadDiscriminator(EDF_WebProxyDbDriverJsonFrame frame, int keyStart, int keyEnd)
+	{
+		int valueStart = SkipWhitespace(keyEnd + 1);
+		if (valueStart >= m_iLength || m_sData.Get(valueStart) != ":")
+			return -1;
+
+		valueStart = SkipWhitespace(valueStart + 1);
+		if (valueStart >= m_iLength || m_sData.Get(valueStart) != "\"")
+			return -1; // Only string discriminators are moved
+
+		int memberEnd = FindStringEnd(valueStart) + 1;
+		int afterMember = SkipWhitespace(memberEnd);
+		bool hasComma = afterMember < m_iLength && m_sData.Get(afterMember) == ",";
+		string member = m_sData.Substring(keyStart, memberEnd - keyStart);
+
+		if (m_bMoveIn)
+		{
+			// The member after it receives the discriminator, without one there is nothing to move into
+			if (!hasComma)
+				return -1;
+
+			frame.m_sPendingMember = member;
+			frame.m_iPendingEdit = m_aEdits.Insert(new EDF_WebProxyDbDriverJsonEdit(keyStart, afterMember + 1 - keyStart, string.Empty));
+			frame.m_bExpectKey = true;
+			return afterMember + 1;
+		}
+
+		// Only objects held by a member can get the discriminator in front of it
+		if (frame.m_iOwnerKeyStart == -1)
+			return -1;
+
+		m_aEdits.InsertAt(new EDF_WebProxyDbDriverJsonEdit(frame.m_iOwnerKeyStart, 0, member + ","), frame.m_iEditIndex);
+
+		if (hasComma)
+		{
+			m_aEdits.Insert(new EDF_WebProxyDbDriverJsonEdit(keyStart, afterMember + 1 - keyStart, string.Empty));
+			frame.m_bExpectKey = true;
+			return afterMember + 1;
+		}
+
+		// Last member, the comma in front of it goes as well
+		int removeFrom = keyStart;
+		if (frame.m_iLastComma != -1)
+			removeFrom = frame.m_iLastComma;
+
+		m_aEdits.Insert(new EDF_WebProxyDbDriverJsonEdit(removeFrom, memberEnd - removeFrom, string.Empty));
+		return memberEnd;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Put the held back discriminator into the object value of the member whose key ends before keyEnd
+	protected void InjectPending(EDF_WebProxyDbDriverJsonFrame frame, int keyEnd)
+	{
+		int pendingEdit = frame.m_iPendingEdit;
+		frame.m_iPendingEdit = -1;
+
+		int valueStart = SkipWhitespace(keyEnd);
+		if (valueStart < m_iLength && m_sData.Get(valueStart) == ":")
+			valueStart = SkipWhitespace(valueStart + 1);
+
+		if (valueStart >= m_iLength || m_sData.Get(valueStart) != "{")
+		{
+			// Not an object, the discriminator stays where it was
+			m_aEdits.RemoveOrdered(pendingEdit);
+			return;
+		}
+
+		string inject = frame.m_sPendingMember;
+		int contentStart = SkipWhitespace(valueStart + 1);
+		if (contentStart < m_iLength && m_sData.Get(contentStart) != "}")
+			inject += ",";
+
+		m_aEdits.Insert(new EDF_WebProxyDbDriverJsonEdit(valueStart + 1, 0, inject));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return index of the closing quote of the string starting at the quote
+	protected int FindStringEnd(int start)
+	{
+		int position = start + 1;
+		while (true)
+		{
+			int quote = m_sData.IndexOfFrom(position, "\"");
+			if (quote == -1)
+				return m_iLength - 1;
+
+			// Escaped if preceded by an odd number of backslashes
+			int backslashes;
+			while (quote - backslashes - 1 > start && m_sData.Get(quote - backslashes - 1) == "\\")
+			{
+				backslashes++;
+			}
+
+			if (backslashes % 2 == 0)
+				return quote;
+
+			position = quote + 1;
+		}
+
+		return m_iLength - 1;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected int SkipWhitespace(int position)
+	{
+		while (position < m_iLength)
+		{
+			string char = m_sData.Get(position);
+			if (char != " " && char != "\n" && char != "\r" && char != "\t")
+				break;
+
+			position++;
+		}
+
+		return position;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected EDF_WebProxyDbDriverJsonFrame GetFrame()
+	{
+		if (m_aFrames.IsEmpty())
+			return null;
+
+		return m_aFrames.Get(m_aFrames.Count() - 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected string Apply()
+	{
+		if (m_aEdits.IsEmpty())
+			return m_sData;
+
+		array<string> parts();
+		parts.Reserve(m_aEdits.Count() * 2 + 1);
+
+		int position;
+		foreach (EDF_WebProxyDbDriverJsonEdit edit : m_aEdits)
+		{
+			if (edit.m_iPosition > position)
+				parts.Insert(m_sData.Substring(position, edit.m_iPosition - position));
+
+			if (edit.m_sInsert)
+				parts.Insert(edit.m_sInsert);
+
+			position = edit.m_iPosition + edit.m_iRemove;
+		}
+
+		if (position < m_iLength)
+			parts.Insert(m_sData.Substring(position, m_iLength - position));
+
+		return Join(parts);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Join neighbouring pairs until one string is left. Every character is copied once per round instead of once per part.
+	static string Join(notnull array<string> parts)
+	{
+		if (parts.IsEmpty())
+			return string.Empty;
+
+		while (parts.Count() > 1)
+		{
+			array<string> joined();
+			joined.Reserve((parts.Count() + 1) / 2);
+			for (int nPart = 0, count = parts.Count(); nPart < count; nPart += 2)
+			{
+				if (nPart + 1 < count)
+				{
+					joined.Insert(parts.Get(nPart) + parts.Get(nPart + 1));
+				}
+				else
+				{
+					joined.Insert(parts.Get(nPart));
+				}
+			}
+
+			parts = joined;
+		}
+
+		return parts.Get(0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void EDF_WebProxyDbDriverTypeDiscriminator(string data, string discriminator, bool moveIn)
+	{
+		m_sData = data;
+		m_iLength = data.Length();
+		m_sDiscriminator = discriminator;
+		m_bMoveIn = moveIn;
+	}
+};
+
+//! Replace m_iRemove characters at m_iPosition of the source with m_sInsert
+class EDF_WebProxyDbDriverJsonEdit
+{
+	int m_iPosition;
+	int m_iRemove;
+	string m_sInsert;
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverJsonEdit(int position, int remove, string insert)
+	{
+		m_iPosition = position;
+		m_iRemove = remove;
+		m_sInsert = insert;
+	}
+};
+
+//! Open object or array while scanning
+class EDF_WebProxyDbDriverJsonFrame
+{
+	bool m_bObject;
+	bool m_bExpectKey;
+	int m_iKeyStart = -1;		// Key of the member currently read
+	int m_iLastComma = -1;
+	int m_iOwnerKeyStart = -1;	// Key of the member holding this object, -1 in arrays and at the top level
+	int m_iEditIndex;			// Edits made before this object was opened
+	int m_iPendingEdit = -1;	// Removal of a discriminator waiting for the next member
+	string m_sPendingMember;
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverJsonFrame(bool isObject)
+	{
+		m_bObject = isObject;
+		m_bExpectKey = isObject;
+	}
+};
@@ -0,0 +1,289 @@
+class EDF_WebProxyDbDriverQueuedWrite
+{
+	string m_sEntityId;
+	string m_sData; // Serialized entity, empty for removals
+	ref array<ref EDF_DbOperationStatusOnlyCallback> m_aCallbacks = {};
+
+	//------------------------------------------------------------------------------------------------
+	void Complete(EDF_EDbOperationStatusCode statusCode)
+	{
+		foreach (EDF_DbOperationStatusOnlyCallback callback : m_aCallbacks)
+		{
+			callback.Invoke(statusCode);
+		}
+	}
+};
+
+//! Held back writes of one entity type. Only the latest write per id is kept and ids in flight are not sent again until they completed,
+//! so batches taken from the queue never conflict with each other and can be sent concurrently.
+//! Requests of the type made while writes wait for their earlier batch are blocked until those writes were sent.
+class EDF_WebProxyDbDriverWriteQueue
+{
+	typename m_tEntityType;
+	int m_iInFlightBatches;
+
+	protected ref map<string, ref EDF_WebProxyDbDriverQueuedWrite> m_mWrites = new map<string, ref EDF_WebProxyDbDriverQueuedWrite>();
+	protected ref map<string, int> m_mInFlightIds = new map<string, int>(); // Batches in flight per id
+	protected ref array<ref EDF_WebProxyDbDriverRequest> m_aBlockedRequests = {};
+
+	//------------------------------------------------------------------------------------------------
+	//! \param data serialized entity to save or empty to remove the id
+	void Enqueue(string entityId, string data, EDF_DbOperationStatusOnlyCallback callback)
+	{
+		EDF_WebProxyDbDriverQueuedWrite write = m_mWrites.Get(entityId);
+		if (!write)
+		{
+			write = new EDF_WebProxyDbDriverQueuedWrite();
+			write.m_sEntityId = entityId;
+			m_mWrites.Set(entityId, write);
+		}
+
+		write.m_sData = data;
+
+		if (callback)
+			write.m_aCallbacks.Insert(callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Hold the request back until the writes queued before it were sent
+	void Block(notnull EDF_WebProxyDbDriverRequest request)
+	{
+		m_aBlockedRequests.Insert(request);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool HasBlockedRequests()
+	{
+		return !m_aBlockedRequests.IsEmpty();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Move the blocked requests into the array, oldest first
+	void TakeBlockedRequests(notnull array<ref EDF_WebProxyDbDriverRequest> requests)
+	{
+		requests.InsertAll(m_aBlockedRequests);
+		m_aBlockedRequests.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return amount of queued and in flight writes and blocked requests
+	int GetPendingCount()
+	{
+		return m_mWrites.Count() + m_mInFlightIds.Count() + m_aBlockedRequests.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return amount of writes not yet taken
+	int GetQueuedCount()
+	{
+		return m_mWrites.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsEmpty()
+	{
+		return m_mWrites.IsEmpty();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Take up to batchSize writes whose ids are not currently in flight
+	//! \param includeInFlight also take writes of ids in flight, only for blocking sends when there is no later frame to wait in
+	array<ref EDF_WebProxyDbDriverQueuedWrite> TakeBatch(int batchSize, bool includeInFlight = false)
+	{
+		array<ref EDF_WebProxyDbDriverQueuedWrite> batch();
+		foreach (string entityId, EDF_WebProxyDbDriverQueuedWrite write : m_mWrites)
+		{
+			if (batch.Count() >= batchSize)
+				break;
+
+			if (!includeInFlight && m_mInFlightIds.Contains(entityId))
+				continue;
+
+			batch.Insert(write);
+		}
+
+		foreach (EDF_WebProxyDbDriverQueuedWrite write : batch)
+		{
+			m_mWrites.Remove(write.m_sEntityId);
+			m_mInFlightIds.Set(write.m_sEntityId, m_mInFlightIds.Get(write.m_sEntityId) + 1);
+		}
+
+		if (!batch.IsEmpty())
+			m_iInFlightBatches++;
+
+		return batch;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Complete a batch taken by TakeBatch() with the same status for every write
+	void Complete(notnull array<ref EDF_WebProxyDbDriverQueuedWrite> batch, EDF_EDbOperationStatusCode statusCode)
+	{
+		Release(batch);
+
+		foreach (EDF_WebProxyDbDriverQueuedWrite write : batch)
+		{
+			write.Complete(statusCode);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Complete a batch taken by TakeBatch() with the per item results of a bulk response
+	//! \param failures status by entity id as reported by the proxy, writes without an entry succeeded
+	void Complete(notnull array<ref EDF_WebProxyDbDriverQueuedWrite> batch, notnull map<string, string> failures)
+	{
+		Release(batch);
+
+		foreach (EDF_WebProxyDbDriverQueuedWrite write : batch)
+		{
+			EDF_EDbOperationStatusCode statusCode = EDF_EDbOperationStatusCode.SUCCESS;
+
+			string failure;
+			if (failures.Find(write.m_sEntityId, failure))
+			{
+				if (failure == "notfound")
+				{
+					statusCode = EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
+				}
+				else
+				{
+					statusCode = EDF_EDbOperationStatusCode.FAILURE_UNKNOWN;
+				}
+			}
+
+			write.Complete(statusCode);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Release(array<ref EDF_WebProxyDbDriverQueuedWrite> batch)
+	{
+		m_iInFlightBatches--;
+
+		foreach (EDF_WebProxyDbDriverQueuedWrite write : batch)
+		{
+			int inFlight = m_mInFlightIds.Get(write.m_sEntityId) - 1;
+			if (inFlight > 0)
+			{
+				m_mInFlightIds.Set(write.m_sEntityId, inFlight);
+			}
+			else
+			{
+				m_mInFlightIds.Remove(write.m_sEntityId);
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_WebProxyDbDriverWriteQueue(typename entityType)
+	{
+		m_tEntityType = entityType;
+	}
+};
+
+//! Builds the body of a POST <type>/_bulk request: {"ops": [{"id": <id>, "entity": <entity json>}, {"id": <id>}, ...]}
+//! Ops with an entity are saved, ops without one removed. The entities are serialized when queued, so the body is joined from their strings in one go.
+class EDF_WebProxyDbDriverBulkWriteRequest
+{
+	//------------------------------------------------------------------------------------------------
+	static string Build(notnull array<ref EDF_WebProxyDbDriverQueuedWrite> batch)
+	{
+		array<string> parts();
+		parts.Reserve(batch.Count() + 2);
+		parts.Insert("{\"ops\":[");
+		foreach (int idx, EDF_WebProxyDbDriverQueuedWrite write : batch)
+		{
+			string separator = ",";
+			if (idx == 0)
+				separator = string.Empty;
+
+			if (write.m_sData)
+			{
+				parts.Insert(string.Format("%1{\"id\":\"%2\",\"entity\":%3}", separator, write.m_sEntityId, write.m_sData));
+			}
+			else
+			{
+				parts.Insert(string.Format("%1{\"id\":\"%2\"}", separator, write.m_sEntityId));
+			}
+		}
+
+		parts.Insert("]}");
+		return EDF_WebProxyDbDriverTypeDiscriminator.Join(parts);
+	}
+};
+
+//! Failed op of a bulk response {"failed": [{"id": <id>, "status": "notfound"|"error"}]}
+class EDF_WebProxyDbDriverBulkWriteFailure
+{
+	string m_sId;
+	string m_sStatus;
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationLoad(BaseSerializationLoadContext loadContext)
+	{
+		loadContext.ReadValue("id", m_sId);
+		return loadContext.ReadValue("status", m_sStatus);
+	}
+};
+
+class EDF_WebProxyDbDriverWriteBatchCallback : EDF_DbOperationStatusOnlyCallback
+{
+	protected EDF_WebProxyDbDriver m_pDriver;
+	protected ref EDF_WebProxyDbDriverWriteQueue m_pQueue;
+	protected ref array<ref EDF_WebProxyDbDriverQueuedWrite> m_aBatch;
+
+	//------------------------------------------------------------------------------------------------
+	//! Map the per item results of a bulk response back to the queued writes
+	void OnResponse(string data)
+	{
+		map<string, string> failures();
+		SCR_JsonLoadContext reader();
+		if (!reader.ImportFromString(data))
+		{
+			Complete(EDF_EDbOperationStatusCode.FAILURE_RESPONSE_MALFORMED);
+			return;
+		}
+
+		// No failed list means every op was applied
+		array<ref EDF_WebProxyDbDriverBulkWriteFailure> failed();
+		if (reader.ReadValue("failed", failed))
+		{
+			foreach (EDF_WebProxyDbDriverBulkWriteFailure failure : failed)
+			{
+				failures.Set(failure.m_sId, failure.m_sStatus);
+			}
+		}
+
+		m_pQueue.Complete(m_aBatch, failures);
+		if (m_pDriver)
+			m_pDriver.OnWriteBatchFinished(m_pQueue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		Complete(EDF_EDbOperationStatusCode.SUCCESS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		Complete(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Complete(EDF_EDbOperationStatusCode statusCode)
+	{
+		m_pQueue.Complete(m_aBatch, statusCode);
+		if (m_pDriver)
+			m_pDriver.OnWriteBatchFinished(m_pQueue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param driver to notify once the batch completed, null for blocking sends
+	void EDF_WebProxyDbDriverWriteBatchCallback(EDF_WebProxyDbDriver driver, EDF_WebProxyDbDriverWriteQueue queue, array<ref EDF_WebProxyDbDriverQueuedWrite> batch)
+	{
+		m_pDriver = driver;
+		m_pQueue = queue;
+		m_aBatch = batch;
+	}
+};
@@ -1,10 +1,26 @@
-/*
+//! Db context that queues all writes in memory until Flush() is called. Reads include the pending changes.
 class EDF_BufferedDbContext : EDF_DbContext
 {
 	//------------------------------------------------------------------------------------------------
-	void Flush(int maxBatchSize = 50)
+	//! Pass all pending changes on to the actual database driver. Non-blocking flushes are spread across frames.
+	//! \param forceBlocking wait until everything was written
+	void Flush(bool forceBlocking = false)
 	{
-		EDF_DbDriverBufferWrapper.Cast(m_Driver).Flush(maxBatchSize);
+		EDF_DbDriverBufferWrapper.Cast(m_Driver).Flush(forceBlocking);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Configure the frame budget and entity type priorities of non-blocking flushes
+	EDF_DbFlushScheduler GetFlushScheduler()
+	{
+		return EDF_DbDriverBufferWrapper.Cast(m_Driver).GetFlushScheduler();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return amount of buffered updates and removals not yet confirmed by the database driver
+	int GetPendingCount()
+	{
+		return EDF_DbDriverBufferWrapper.Cast(m_Driver).GetPendingCount();
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -23,4 +39,3 @@ class EDF_BufferedDbContext : EDF_DbContext
 		m_Driver = new EDF_DbDriverBufferWrapper(driver);
 	}
 };
-*/
\ No newline at end of file
@@ -0,0 +1,568 @@
+enum EDF_EDbAggregateOperator
+{
+	COUNT,
+	SUM,
+	MIN,
+	MAX,
+	AVG
+}
+
+class EDF_DbAggregateField
+{
+	EDF_EDbAggregateOperator m_eOperator;
+	string m_sFieldPath;
+	string m_sAlias;
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue("operator", m_eOperator);
+
+		if (m_sFieldPath)
+			saveContext.WriteValue("fieldPath", m_sFieldPath);
+
+		saveContext.WriteValue("alias", m_sAlias);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbAggregateField(EDF_EDbAggregateOperator operator, string fieldPath, string alias)
+	{
+		m_eOperator = operator;
+		m_sFieldPath = fieldPath;
+		m_sAlias = alias;
+	}
+}
+
+//! Describes which values to aggregate over the entities matched by a find condition.
+//! Use like: EDF_DbAggregation.Create().GroupBy("m_sFaction").Count().Sum("m_fMoney", "money")
+class EDF_DbAggregation
+{
+	string m_sGroupByFieldPath;
+	ref array<ref EDF_DbAggregateField> m_aFields = {};
+
+	//------------------------------------------------------------------------------------------------
+	//! Split results into one group per distinct value of the field path
+	EDF_DbAggregation GroupBy(string fieldPath)
+	{
+		m_sGroupByFieldPath = fieldPath;
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Number of matched entities
+	EDF_DbAggregation Count(string alias = "count")
+	{
+		m_aFields.Insert(new EDF_DbAggregateField(EDF_EDbAggregateOperator.COUNT, string.Empty, alias));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregation Sum(string fieldPath, string alias = string.Empty)
+	{
+		return Add(EDF_EDbAggregateOperator.SUM, fieldPath, alias);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregation Min(string fieldPath, string alias = string.Empty)
+	{
+		return Add(EDF_EDbAggregateOperator.MIN, fieldPath, alias);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregation Max(string fieldPath, string alias = string.Empty)
+	{
+		return Add(EDF_EDbAggregateOperator.MAX, fieldPath, alias);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregation Avg(string fieldPath, string alias = string.Empty)
+	{
+		return Add(EDF_EDbAggregateOperator.AVG, fieldPath, alias);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Default alias is operator and field path e.g. "sum:m_fMoney"
+	protected EDF_DbAggregation Add(EDF_EDbAggregateOperator operator, string fieldPath, string alias)
+	{
+		if (!alias)
+		{
+			alias = typename.EnumToString(EDF_EDbAggregateOperator, operator);
+			alias.ToLower();
+			alias = string.Format("%1:%2", alias, fieldPath);
+		}
+
+		m_aFields.Insert(new EDF_DbAggregateField(operator, fieldPath, alias));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		if (m_sGroupByFieldPath)
+			saveContext.WriteValue("groupBy", m_sGroupByFieldPath);
+
+		saveContext.WriteValue("fields", m_aFields);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregation Copy()
+	{
+		EDF_DbAggregation copy();
+		copy.m_sGroupByFieldPath = m_sGroupByFieldPath;
+		copy.m_aFields.Reserve(m_aFields.Count());
+		foreach (EDF_DbAggregateField field : m_aFields)
+		{
+			copy.m_aFields.Insert(new EDF_DbAggregateField(field.m_eOperator, field.m_sFieldPath, field.m_sAlias));
+		}
+
+		return copy;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbAggregation Create()
+	{
+		return new EDF_DbAggregation();
+	}
+}
+
+class EDF_DbAggregateGroup
+{
+	string m_sKey;
+	ref map<string, float> m_mValues = new map<string, float>();
+
+	//------------------------------------------------------------------------------------------------
+	//! Group by value formatted as string. Empty if the aggregation was not grouped.
+	string GetKey()
+	{
+		return m_sKey;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Aggregated value by alias. Min, max and avg are 0 if the group had no numeric values for the field.
+	float Get(string alias)
+	{
+		return m_mValues.Get(alias);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationLoad(BaseSerializationLoadContext loadContext)
+	{
+		loadContext.ReadValue("key", m_sKey);
+		return loadContext.ReadValue("values", m_mValues);
+	}
+}
+
+class EDF_DbAggregateResult : EDF_DbFindResultBase
+{
+	protected ref array<ref EDF_DbAggregateGroup> m_aGroups;
+
+	//------------------------------------------------------------------------------------------------
+	array<ref EDF_DbAggregateGroup> GetGroups()
+	{
+		return m_aGroups;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get group by key. Without a group by there is only the one group with an empty key.
+	EDF_DbAggregateGroup GetGroup(string key = string.Empty)
+	{
+		if (m_aGroups)
+		{
+			foreach (EDF_DbAggregateGroup group : m_aGroups)
+			{
+				if (group.m_sKey == key)
+					return group;
+			}
+		}
+
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbAggregateResult(EDF_EDbOperationStatusCode statusCode, array<ref EDF_DbAggregateGroup> groups = null)
+	{
+		m_eStatusCode = statusCode;
+		m_aGroups = groups;
+	}
+}
+
+class EDF_DbAggregateCallback : EDF_DbOperationCallback
+{
+	//------------------------------------------------------------------------------------------------
+	void OnSuccess(array<ref EDF_DbAggregateGroup> groups, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	sealed void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbAggregateGroup> groups)
+	{
+		if (m_pInvokeInstance &&
+			m_sInvokeMethod &&
+			GetGame().GetScriptModule().Call(m_pInvokeInstance, m_sInvokeMethod, false, null, code, groups, m_pContext)) return;
+
+		if (code == EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			OnSuccess(groups, m_pContext);
+		}
+		else
+		{
+			OnFailure(code, m_pContext);
+		}
+	}
+}
+
+class EDF_DbAggregateGroupState
+{
+	int m_iCount;
+	ref array<float> m_aSums = {};
+	ref array<float> m_aMins = {};
+	ref array<float> m_aMaxs = {};
+	ref array<int> m_aValueCounts = {};
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbAggregateGroupState(int fieldCount)
+	{
+		m_aSums.Resize(fieldCount);
+		m_aMins.Resize(fieldCount);
+		m_aMaxs.Resize(fieldCount);
+		m_aValueCounts.Resize(fieldCount);
+	}
+}
+
+//! Computes an aggregation in a single pass over entities that are fed into it. Entities are only read, never copied or kept.
+class EDF_DbAggregator
+{
+	protected EDF_DbAggregation m_pAggregation;
+	protected ref array<string> m_aGroupByPath;
+	protected ref array<ref array<string>> m_aFieldPaths = {};
+	protected ref map<string, ref EDF_DbAggregateGroupState> m_mGroups = new map<string, ref EDF_DbAggregateGroupState>();
+	protected ref array<string> m_aGroupOrder = {};
+
+	//------------------------------------------------------------------------------------------------
+	//! Check the group by and aggregated field paths against the entity type once, before any entity is accumulated
+	//! \return SUCCESS or FAILURE_DATA_MALFORMED if a path does not lead to a supported field
+	EDF_EDbOperationStatusCode Validate(typename entityType)
+	{
+		if (m_aGroupByPath && !ValidateFieldPath(entityType, m_aGroupByPath, false))
+			return EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED;
+
+		foreach (array<string> fieldPath : m_aFieldPaths)
+		{
+			if (fieldPath && !ValidateFieldPath(entityType, fieldPath, true))
+				return EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED;
+		}
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Accumulate(notnull EDF_DbEntity entity)
+	{
+		string groupKey;
+		if (m_aGroupByPath)
+		{
+			float unusedNumeric;
+			ReadFieldValue(entity, m_aGroupByPath, 0, unusedNumeric, groupKey);
+		}
+
+		int fieldCount = m_aFieldPaths.Count();
+		EDF_DbAggregateGroupState state = m_mGroups.Get(groupKey);
+		if (!state)
+		{
+			state = new EDF_DbAggregateGroupState(fieldCount);
+			m_mGroups.Set(groupKey, state);
+			m_aGroupOrder.Insert(groupKey);
+		}
+
+		state.m_iCount++;
+
+		for (int nField = 0; nField < fieldCount; nField++)
+		{
+			array<string> fieldPath = m_aFieldPaths.Get(nField);
+			if (!fieldPath)
+				continue; // Count only
+
+			float value;
+			string unusedKey;
+			if (!ReadFieldValue(entity, fieldPath, 0, value, unusedKey, true))
+				continue;
+
+			int valueCount = state.m_aValueCounts.Get(nField);
+			state.m_aSums.Set(nField, state.m_aSums.Get(nField) + value);
+
+			if (valueCount == 0 || value < state.m_aMins.Get(nField))
+				state.m_aMins.Set(nField, value);
+
+			if (valueCount == 0 || value > state.m_aMaxs.Get(nField))
+				state.m_aMaxs.Set(nField, value);
+
+			state.m_aValueCounts.Set(nField, valueCount + 1);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	array<ref EDF_DbAggregateGroup> GetResults()
+	{
+		array<ref EDF_DbAggregateGroup> results();
+		results.Reserve(m_aGroupOrder.Count());
+
+		foreach (string groupKey : m_aGroupOrder)
+		{
+			EDF_DbAggregateGroupState state = m_mGroups.Get(groupKey);
+
+			EDF_DbAggregateGroup group();
+			group.m_sKey = groupKey;
+
+			foreach (int nField, EDF_DbAggregateField field : m_pAggregation.m_aFields)
+			{
+				float value;
+				switch (field.m_eOperator)
+				{
+					case EDF_EDbAggregateOperator.COUNT:
+					{
+						value = state.m_iCount;
+						break;
+					}
+
+					case EDF_EDbAggregateOperator.SUM:
+					{
+						value = state.m_aSums.Get(nField);
+						break;
+					}
+
+					case EDF_EDbAggregateOperator.MIN:
+					{
+						value = state.m_aMins.Get(nField);
+						break;
+					}
+
+					case EDF_EDbAggregateOperator.MAX:
+					{
+						value = state.m_aMaxs.Get(nField);
+						break;
+					}
+
+					case EDF_EDbAggregateOperator.AVG:
+					{
+						int valueCount = state.m_aValueCounts.Get(nField);
+						if (valueCount > 0)
+							value = state.m_aSums.Get(nField) / valueCount;
+
+						break;
+					}
+				}
+
+				group.m_mValues.Set(field.m_sAlias, value);
+			}
+
+			results.Insert(group);
+		}
+
+		// Ungrouped aggregation over nothing still has one (empty) result
+		if (results.IsEmpty() && !m_aGroupByPath)
+		{
+			EDF_DbAggregateGroup emptyGroup();
+			foreach (EDF_DbAggregateField field : m_pAggregation.m_aFields)
+			{
+				emptyGroup.m_mValues.Set(field.m_sAlias, 0);
+			}
+			results.Insert(emptyGroup);
+		}
+
+		return results;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Read primitive value at dot notation path. Numbers are returned as float, everything is also formatted into a string key.
+	protected static bool ReadFieldValue(Class instance, array<string> fieldSplits, int currentIndex, out float numericValue, out string keyValue, bool numericOnly = false)
+	{
+		if (!instance)
+			return false;
+
+		string currentFieldName = fieldSplits.Get(currentIndex);
+		EDF_ReflectionVariableInfo variableInfo = EDF_ReflectionVariableInfo.Get(instance, currentFieldName);
+		if (!variableInfo || variableInfo.m_iVariableIndex == -1)
+			return false;
+
+		typename valueType = variableInfo.m_tVaribleType;
+
+		// Expand nested object
+		if (currentIndex < fieldSplits.Count() - 1)
+		{
+			if (variableInfo.m_eCollectionType != EDF_ReflectionVariableCollectionType.NONE || !valueType.IsInherited(Class))
+				return false;
+
+			Class complexHolder;
+			if (!variableInfo.m_tHolderType.GetVariableValue(instance, variableInfo.m_iVariableIndex, complexHolder))
+				return false;
+
+			return ReadFieldValue(complexHolder, fieldSplits, currentIndex + 1, numericValue, keyValue, numericOnly);
+		}
+
+		switch (valueType)
+		{
+			case int:
+			{
+				int intValue;
+				if (!variableInfo.m_tHolderType.GetVariableValue(instance, variableInfo.m_iVariableIndex, intValue))
+					return false;
+
+				numericValue = intValue;
+				keyValue = intValue.ToString();
+				return true;
+			}
+
+			case float:
+			{
+				if (!variableInfo.m_tHolderType.GetVariableValue(instance, variableInfo.m_iVariableIndex, numericValue))
+					return false;
+
+				keyValue = numericValue.ToString();
+				return true;
+			}
+
+			case bool:
+			{
+				bool boolValue;
+				if (!variableInfo.m_tHolderType.GetVariableValue(instance, variableInfo.m_iVariableIndex, boolValue))
+					return false;
+
+				numericValue = boolValue;
+				keyValue = boolValue.ToString();
+				return true;
+			}
+		}
+
+		if (numericOnly)
+			return false;
+
+		switch (valueType)
+		{
+			case string:
+			{
+				return variableInfo.m_tHolderType.GetVariableValue(instance, variableInfo.m_iVariableIndex, keyValue);
+			}
+
+			case vector:
+			{
+				vector vectorValue;
+				if (!variableInfo.m_tHolderType.GetVariableValue(instance, variableInfo.m_iVariableIndex, vectorValue))
+					return false;
+
+				keyValue = vectorValue.ToString(false);
+				return true;
+			}
+
+			case typename:
+			{
+				typename typenameValue;
+				if (!variableInfo.m_tHolderType.GetVariableValue(instance, variableInfo.m_iVariableIndex, typenameValue))
+					return false;
+
+				keyValue = EDF_DbName.Get(typenameValue);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Same rules as ReadFieldValue, but checked on the declared types so an invalid path is reported once instead of per entity.
+	//! Nested objects can hold a subclass of their declared type, fields not found on it are left to ReadFieldValue on the runtime instance.
+	protected static bool ValidateFieldPath(typename type, array<string> fieldSplits, bool numericOnly)
+	{
+		int lastIndex = fieldSplits.Count() - 1;
+		foreach (int nSplit, string fieldName : fieldSplits)
+		{
+			int variableIndex = -1;
+			for (int vIdx = 0, count = type.GetVariableCount(); vIdx < count; vIdx++)
+			{
+				if (type.GetVariableName(vIdx) == fieldName)
+				{
+					variableIndex = vIdx;
+					break;
+				}
+			}
+
+			if (variableIndex == -1)
+			{
+				if (nSplit > 0)
+					return true;
+
+				Debug.Error(string.Format("Can not aggregate by unknown field '%1' on '%2'.", fieldName, type));
+				return false;
+			}
+
+			typename valueType = type.GetVariableType(variableIndex);
+
+			// Expand nested object
+			if (nSplit < lastIndex)
+			{
+				if (valueType.IsInherited(array) || valueType.IsInherited(set) || valueType.IsInherited(map) || !valueType.IsInherited(Class))
+				{
+					Debug.Error(string.Format("Can not aggregate by field '%1' of type '%2' on '%3'. Only nested objects can be expanded.", fieldName, valueType, type));
+					return false;
+				}
+
+				type = valueType;
+				continue;
+			}
+
+			switch (valueType)
+			{
+				case int:
+				case float:
+				case bool:
+					return true;
+			}
+
+			if (numericOnly)
+			{
+				Debug.Error(string.Format("Can not aggregate non numeric field '%1' of type '%2'.", fieldName, valueType));
+				return false;
+			}
+
+			switch (valueType)
+			{
+				case string:
+				case vector:
+				case typename:
+					return true;
+			}
+
+			Debug.Error(string.Format("Can not group by field '%1' with unsupported type '%2'.", fieldName, valueType));
+			return false;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbAggregator(notnull EDF_DbAggregation aggregation)
+	{
+		m_pAggregation = aggregation;
+
+		if (aggregation.m_sGroupByFieldPath)
+		{
+			m_aGroupByPath = {};
+			aggregation.m_sGroupByFieldPath.Split(EDF_DbFindFieldAnnotations.SEPERATOR, m_aGroupByPath, true);
+		}
+
+		m_aFieldPaths.Reserve(aggregation.m_aFields.Count());
+		foreach (EDF_DbAggregateField field : aggregation.m_aFields)
+		{
+			array<string> fieldPath;
+			if (field.m_eOperator != EDF_EDbAggregateOperator.COUNT && field.m_sFieldPath)
+			{
+				fieldPath = {};
+				field.m_sFieldPath.Split(EDF_DbFindFieldAnnotations.SEPERATOR, fieldPath, true);
+			}
+
+			m_aFieldPaths.Insert(fieldPath);
+		}
+	}
+}
@@ -36,6 +36,111 @@ class EDF_DbContext
 		return m_Driver.Remove(entityType, entityId);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Adds or updates multiple entries in as few driver operations as possible
+	//! \param entities database entities to add or update, may be of mixed types
+	//! \return status code of the operation, the first failure if any entity could not be saved
+	EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref EDF_DbEntity> entities)
+	{
+		AssignMissingIds(entities);
+		return m_Driver.AddOrUpdateMany(entities);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Remove multiple existing database entities of the same type
+	//! \param entityType typename of the database entities
+	//! \param entityIds unique ids of the entities to remove
+	//! \return status code of the operation, the first failure if any entity could not be removed
+	EDF_EDbOperationStatusCode RemoveMany(typename entityType, notnull array<string> entityIds)
+	{
+		return m_Driver.RemoveMany(entityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Change individual fields of an existing entity without saving the entire entity
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param patch new field values e.g. EDF_DbPatch.Create().Set("m_iMoney", 500)
+	//! \param condition optional condition the entity must match for the patch to be applied
+	//! \return status code of the operation, will fail if entity did not exist, did not match or a field could not be set
+	EDF_EDbOperationStatusCode Patch(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		return m_Driver.Patch(entityType, entityId, patch, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically add the delta to a numeric field of an existing entity
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param delta value to add, can be negative
+	//! \return status code of the operation
+	EDF_EDbOperationStatusCode Increment(typename entityType, string entityId, string fieldPath, int delta)
+	{
+		return m_Driver.Increment(entityType, entityId, fieldPath, delta);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically add the delta to a numeric field of an existing entity
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param delta value to add, can be negative
+	//! \return status code of the operation
+	EDF_EDbOperationStatusCode Increment(typename entityType, string entityId, string fieldPath, float delta)
+	{
+		return m_Driver.Increment(entityType, entityId, fieldPath, delta);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity only if it still has the expected value
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param expectedValue value the field must currently have
+	//! \param newValue value to set
+	//! \return status code of the operation, FAILURE_CONDITION_NOT_MET if the current value was different
+	EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, int expectedValue, int newValue)
+	{
+		return m_Driver.CompareAndSet(entityType, entityId, fieldPath, expectedValue, newValue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity only if it still has the expected value
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param expectedValue value the field must currently have
+	//! \param newValue value to set
+	//! \return status code of the operation, FAILURE_CONDITION_NOT_MET if the current value was different
+	EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, bool expectedValue, bool newValue)
+	{
+		return m_Driver.CompareAndSet(entityType, entityId, fieldPath, expectedValue, newValue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity only if it still has the expected value
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param expectedValue value the field must currently have
+	//! \param newValue value to set
+	//! \return status code of the operation, FAILURE_CONDITION_NOT_MET if the current value was different
+	EDF_EDbOperationStatusCode CompareAndSet(typename entityType, string entityId, string fieldPath, string expectedValue, string newValue)
+	{
+		return m_Driver.CompareAndSet(entityType, entityId, fieldPath, expectedValue, newValue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Remove all database entities matching the condition without loading them into a result first
+	//! \param entityType typename of the database entities
+	//! \param condition find condition the entities to remove must match
+	//! \return status code of the operation
+	EDF_EDbOperationStatusCode RemoveWhere(typename entityType, notnull EDF_DbFindCondition condition)
+	{
+		return m_Driver.RemoveWhere(entityType, condition);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	//! Find database entities
 	//! \param entityType typename of the database entity
@@ -49,6 +154,57 @@ class EDF_DbContext
 		return m_Driver.FindAll(entityType, condition, orderBy, limit, offset);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Find a database entity by its id. Cheaper than FindAll with an id condition.
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity
+	//! \return find result containing status code and the entity on success, null if it does not exist
+	EDF_DbFindResultSingle<EDF_DbEntity> FindById(typename entityType, string entityId)
+	{
+		return m_Driver.FindById(entityType, entityId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Find multiple database entities by their ids. Cheaper than FindAll with an id condition.
+	//! \param entityType typename of the database entity
+	//! \param entityIds unique ids of the entities
+	//! \return find result containing status code and the entities in the order of the ids on success. Unknown ids are skipped.
+	EDF_DbFindResultMultiple<EDF_DbEntity> FindByIds(typename entityType, notnull array<string> entityIds)
+	{
+		return m_Driver.FindByIds(entityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count database entities without loading them into the result
+	//! \param entityType typename of the database entity
+	//! \param condition find condition to search by. Counts the entire collection if not set.
+	//! \return count result containing status code and the amount of matching entities on success
+	EDF_DbCountResult Count(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return m_Driver.Count(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Check if at least one database entity matches without loading it into the result
+	//! \param entityType typename of the database entity
+	//! \param condition find condition to search by. Checks if the collection has any entries if not set.
+	//! \return exists result containing status code and if there was a match on success
+	EDF_DbExistsResult Exists(typename entityType, EDF_DbFindCondition condition = null)
+	{
+		return m_Driver.Exists(entityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Aggregate values of database entities without loading them into the result
+	//! \param entityType typename of the database entity
+	//! \param aggregation values to compute e.g. EDF_DbAggregation.Create().GroupBy("m_sFaction").Sum("m_fMoney", "money")
+	//! \param condition find condition to filter the aggregated entities by
+	//! \return aggregate result containing status code and one group per distinct group by value on success
+	EDF_DbAggregateResult Aggregate(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		return m_Driver.Aggregate(entityType, aggregation, condition);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	//! Adds a new entry to the database or updates an existing one asynchronously
 	//! \param entity database entity to add or update
@@ -84,6 +240,111 @@ class EDF_DbContext
 		m_Driver.RemoveAsync(entityType, entityId, callback);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Adds or updates multiple entries asynchronously in as few driver operations as possible
+	//! \param entities database entities to add or update, may be of mixed types
+	//! \param callback optional callback to handle the operation result, invoked once for the whole batch
+	void AddOrUpdateManyAsync(notnull array<ref EDF_DbEntity> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		AssignMissingIds(entities);
+		m_Driver.AddOrUpdateManyAsync(entities, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Remove multiple existing database entities of the same type asynchronously
+	//! \param entityType typename of the database entities
+	//! \param entityIds unique ids of the entities to remove
+	//! \param callback optional callback to handle the operation result, invoked once for the whole batch
+	void RemoveManyAsync(typename entityType, notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_Driver.RemoveManyAsync(entityType, entityIds, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Change individual fields of an existing entity asynchronously without saving the entire entity
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param patch new field values e.g. EDF_DbPatch.Create().Set("m_iMoney", 500)
+	//! \param condition optional condition the entity must match for the patch to be applied
+	//! \param callback optional callback to handle the operation result
+	void PatchAsync(typename entityType, string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		m_Driver.PatchAsync(entityType, entityId, patch, callback, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically add the delta to a numeric field of an existing entity asynchronously
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param delta value to add, can be negative
+	//! \param callback optional callback to handle the operation result
+	void IncrementAsync(typename entityType, string entityId, string fieldPath, int delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_Driver.IncrementAsync(entityType, entityId, fieldPath, delta, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically add the delta to a numeric field of an existing entity asynchronously
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param delta value to add, can be negative
+	//! \param callback optional callback to handle the operation result
+	void IncrementAsync(typename entityType, string entityId, string fieldPath, float delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_Driver.IncrementAsync(entityType, entityId, fieldPath, delta, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity asynchronously only if it still has the expected value
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param expectedValue value the field must currently have
+	//! \param newValue value to set
+	//! \param callback optional callback to handle the operation result, FAILURE_CONDITION_NOT_MET if the current value was different
+	void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, int expectedValue, int newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_Driver.CompareAndSetAsync(entityType, entityId, fieldPath, expectedValue, newValue, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity asynchronously only if it still has the expected value
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param expectedValue value the field must currently have
+	//! \param newValue value to set
+	//! \param callback optional callback to handle the operation result, FAILURE_CONDITION_NOT_MET if the current value was different
+	void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, bool expectedValue, bool newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_Driver.CompareAndSetAsync(entityType, entityId, fieldPath, expectedValue, newValue, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Atomically set a field of an existing entity asynchronously only if it still has the expected value
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity to change
+	//! \param fieldPath field path in dotnotation e.g. "m_pStats.m_iKills"
+	//! \param expectedValue value the field must currently have
+	//! \param newValue value to set
+	//! \param callback optional callback to handle the operation result, FAILURE_CONDITION_NOT_MET if the current value was different
+	void CompareAndSetAsync(typename entityType, string entityId, string fieldPath, string expectedValue, string newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_Driver.CompareAndSetAsync(entityType, entityId, fieldPath, expectedValue, newValue, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Remove all database entities matching the condition asynchronously without loading them into a result first
+	//! \param entityType typename of the database entities
+	//! \param condition find condition the entities to remove must match
+	//! \param callback optional callback to handle the operation result
+	void RemoveWhereAsync(typename entityType, notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_Driver.RemoveWhereAsync(entityType, condition, callback);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	//! Find database entities asynchronously
 	//! \param entityType typename of the database entity
@@ -97,6 +358,67 @@ class EDF_DbContext
 		m_Driver.FindAllAsync(entityType, condition, orderBy, limit, offset, callback);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Find a database entity by its id asynchronously. Cheaper than FindAllAsync with an id condition.
+	//! \param entityType typename of the database entity
+	//! \param entityId unique id of the entity
+	//! \param callback optional callback to handle the operation result
+	void FindByIdAsync(typename entityType, string entityId, EDF_DbFindCallbackBase callback = null)
+	{
+		m_Driver.FindByIdAsync(entityType, entityId, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Find multiple database entities by their ids asynchronously. Cheaper than FindAllAsync with an id condition.
+	//! \param entityType typename of the database entity
+	//! \param entityIds unique ids of the entities
+	//! \param callback optional callback to handle the operation result. Results are in the order of the ids, unknown ids are skipped.
+	void FindByIdsAsync(typename entityType, notnull array<string> entityIds, EDF_DbFindCallbackBase callback = null)
+	{
+		m_Driver.FindByIdsAsync(entityType, entityIds, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count database entities asynchronously without loading them into the result
+	//! \param entityType typename of the database entity
+	//! \param condition find condition to search by. Counts the entire collection if not set.
+	//! \param callback optional callback to handle the operation result
+	void CountAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		m_Driver.CountAsync(entityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Check asynchronously if at least one database entity matches without loading it into the result
+	//! \param entityType typename of the database entity
+	//! \param condition find condition to search by. Checks if the collection has any entries if not set.
+	//! \param callback optional callback to handle the operation result
+	void ExistsAsync(typename entityType, EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		m_Driver.ExistsAsync(entityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Aggregate values of database entities asynchronously without loading them into the result
+	//! \param entityType typename of the database entity
+	//! \param aggregation values to compute e.g. EDF_DbAggregation.Create().GroupBy("m_sFaction").Sum("m_fMoney", "money")
+	//! \param condition find condition to filter the aggregated entities by
+	//! \param callback optional callback to handle the operation result
+	void AggregateAsync(typename entityType, notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		m_Driver.AggregateAsync(entityType, aggregation, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void AssignMissingIds(notnull array<ref EDF_DbEntity> entities)
+	{
+		foreach (EDF_DbEntity entity : entities)
+		{
+			if (!entity.HasId())
+				entity.SetId(EDF_DbEntityIdGenerator.Generate());
+		}
+	}
+
 	//------------------------------------------------------------------------------------------------
 	static EDF_DbContext Create(notnull EDF_DbConnectionInfoBase connectionInfo)
 	{
@@ -108,6 +430,16 @@ class EDF_DbContext
 			return null;
 		}
 
+		if (EDF_DbDriverSingleFlightWrapper.s_bEnabled)
+			driver = new EDF_DbDriverSingleFlightWrapper(driver);
+
+		if (EDF_DbMetrics.IsEnabled())
+			driver = new EDF_DbDriverMetricsWrapper(driver);
+
+		string tracePath = EDF_DbDriverRecordingWrapper.GetRecordingPath();
+		if (tracePath)
+			driver = new EDF_DbDriverRecordingWrapper(driver, tracePath);
+
 		return new EDF_DbContext(driver);
 	}
 
@@ -15,4 +15,72 @@ class EDF_DbEntityUtils
 
 		return reader.ReadValue("", to);
 	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Compact json of the instance, floats limited to 5 decimal places. Equal instances give the same string.
+	static string ToJson(notnull Managed data)
+	{
+		ContainerSerializationSaveContext writer();
+		JsonSaveContainer jsonContainer = new JsonSaveContainer();
+		jsonContainer.SetMaxDecimalPlaces(5);
+		writer.SetContainer(jsonContainer);
+		writer.WriteValue("", data);
+		return jsonContainer.ExportToString();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Create a new instance of the same type with all values copied
+	static EDF_DbEntity DeepCopy(EDF_DbEntity entity)
+	{
+		if (!entity)
+			return null;
+
+		EDF_DbEntity deepCopy = EDF_DbEntity.Cast(entity.Type().Spawn());
+		StructAutoCopy(entity, deepCopy);
+		return deepCopy;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Arrange entities in the order of the given ids. Ids without a matching entity are skipped.
+	static array<ref EDF_DbEntity> OrderByIds(notnull array<ref EDF_DbEntity> entities, notnull array<string> entityIds)
+	{
+		map<string, EDF_DbEntity> entitiesById();
+		foreach (EDF_DbEntity entity : entities)
+		{
+			entitiesById.Set(entity.GetId(), entity);
+		}
+
+		array<ref EDF_DbEntity> result();
+		result.Reserve(entityIds.Count());
+		foreach (string entityId : entityIds)
+		{
+			EDF_DbEntity entity = entitiesById.Get(entityId);
+			if (entity)
+				result.Insert(entity);
+		}
+
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Split mixed entities into one array per entity type, keeping their relative order
+	static map<typename, ref array<ref EDF_DbEntity>> GroupByType(notnull array<ref EDF_DbEntity> entities)
+	{
+		map<typename, ref array<ref EDF_DbEntity>> result();
+
+		foreach (EDF_DbEntity entity : entities)
+		{
+			typename entityType = entity.Type();
+			array<ref EDF_DbEntity> typeEntities = result.Get(entityType);
+			if (!typeEntities)
+			{
+				typeEntities = {};
+				result.Set(entityType, typeEntities);
+			}
+
+			typeEntities.Insert(entity);
+		}
+
+		return result;
+	}
 };
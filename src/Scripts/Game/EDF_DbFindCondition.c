@@ -38,6 +38,13 @@ class EDF_DbFindCondition
 
 	//------------------------------------------------------------------------------------------------
 	string GetDebugString();
+
+	//------------------------------------------------------------------------------------------------
+	//! \return copy that later changes to this condition do not reach. Custom conditions without an override return themselves.
+	EDF_DbFindCondition Copy()
+	{
+		return this;
+	}
 }
 
 class EDF_DbFindConditionWithChildren : EDF_DbFindCondition
@@ -79,6 +86,22 @@ class EDF_DbFindConditionWithChildren : EDF_DbFindCondition
 
 		return dbg + ")";
 	}
+
+	//------------------------------------------------------------------------------------------------
+	protected array<ref EDF_DbFindCondition> CopyConditions()
+	{
+		array<ref EDF_DbFindCondition> conditions();
+		if (!m_aConditions)
+			return conditions;
+
+		conditions.Reserve(m_aConditions.Count());
+		foreach (EDF_DbFindCondition condition : m_aConditions)
+		{
+			conditions.Insert(condition.Copy());
+		}
+
+		return conditions;
+	}
 }
 
 class EDF_DbFindAnd : EDF_DbFindConditionWithChildren
@@ -97,6 +120,12 @@ class EDF_DbFindAnd : EDF_DbFindConditionWithChildren
 		return true;
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindCondition Copy()
+	{
+		return Create(CopyConditions());
+	}
+
 	//------------------------------------------------------------------------------------------------
 	static EDF_DbFindAnd Create(notnull array<ref EDF_DbFindCondition> conditions)
 	{
@@ -125,6 +154,12 @@ class EDF_DbFindOr : EDF_DbFindConditionWithChildren
 		return true;
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindCondition Copy()
+	{
+		return Create(CopyConditions());
+	}
+
 	//------------------------------------------------------------------------------------------------
 	static EDF_DbFindOr Create(notnull array<ref EDF_DbFindCondition> conditions)
 	{
@@ -207,6 +242,14 @@ class EDF_DbFindCheckFieldNullOrDefault : EDF_DbFindFieldCondition
 		return true;
 	}
 
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbFindCondition Copy()
+	{
+		EDF_DbFindCheckFieldNullOrDefault copy = Create(m_sFieldPath, m_ShouldBeNullOrDefault);
+		copy.m_bUsesTypename = m_bUsesTypename;
+		return copy;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	static EDF_DbFindCheckFieldNullOrDefault Create(string fieldPath, bool shouldBeNullOrDefault)
 	{
@@ -503,6 +546,18 @@ class EDF_DbFindCompareFieldValues<Class ValueType> : EDF_DbFindFieldCondition
 		m_aComparisonValuesReferences.Insert(value);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Array comparison values are copied as a list, the arrays in it are still shared
+	override EDF_DbFindCondition Copy()
+	{
+		array<ValueType> comparisonValues();
+		comparisonValues.Copy(m_aComparisonValues);
+
+		EDF_DbFindCompareFieldValues<ValueType> copy = Create(m_sFieldPath, m_eComparisonOperator, comparisonValues, m_bStringsInvariant, m_bStringsPartialMatches);
+		copy.m_bUsesTypename = m_bUsesTypename;
+		return copy;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	static typename GetValueType()
 	{
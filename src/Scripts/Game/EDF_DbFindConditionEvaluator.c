@@ -656,6 +656,68 @@ class EDF_DbFindConditionEvaluator
 		// TODO: Can be optimized to check if id field is part of AND, and there are no other toplevel ORs, so we can know that only specific ids need to be loaded and then filters applied.
 		return false;
 	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Collects the ids of a lone exact Id().Equals/EqualsAnyOf condition
+	//! \return true if the condition matches exactly the collected ids and nothing else needs to be evaluated
+	static bool CollectEqualIds(EDF_DbFindCondition condition, out set<string> ids)
+	{
+		EDF_DbFindFieldString idCondition = GetExactIdCondition(condition, EDF_EDbFindOperator.EQUAL);
+		if (!idCondition)
+			return false;
+
+		foreach (string id : idCondition.m_aComparisonValues)
+		{
+			ids.Insert(id);
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Collects the ids of an exact Id().Not().Equals/EqualsAnyOf condition or an AND made up only of those
+	//! \return true if the condition matches every entity except the collected ids
+	static bool CollectSkipIds(EDF_DbFindCondition condition, out set<string> skipIds)
+	{
+		EDF_DbFindFieldString idCondition = GetExactIdCondition(condition, EDF_EDbFindOperator.NOT_EQUAL);
+		if (idCondition)
+		{
+			foreach (string id : idCondition.m_aComparisonValues)
+			{
+				skipIds.Insert(id);
+			}
+
+			return true;
+		}
+
+		EDF_DbFindAnd andCondition = EDF_DbFindAnd.Cast(condition);
+		if (!andCondition || andCondition.m_aConditions.IsEmpty())
+			return false;
+
+		foreach (EDF_DbFindCondition childCondition : andCondition.m_aConditions)
+		{
+			if (!CollectSkipIds(childCondition, skipIds))
+				return false;
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static EDF_DbFindFieldString GetExactIdCondition(EDF_DbFindCondition condition, EDF_EDbFindOperator comparisonOperator)
+	{
+		EDF_DbFindFieldString idCondition = EDF_DbFindFieldString.Cast(condition);
+		if (!idCondition ||
+			idCondition.m_sFieldPath != EDF_DbEntity.FIELD_ID ||
+			idCondition.m_eComparisonOperator != comparisonOperator ||
+			idCondition.m_bStringsInvariant ||
+			idCondition.m_bStringsPartialMatches)
+		{
+			return null;
+		}
+
+		return idCondition;
+	}
 }
 
 class EDF_DbFindFieldFieldNullOrDefaultChecker<Class TValueType>
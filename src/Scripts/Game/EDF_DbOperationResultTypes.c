@@ -15,7 +15,10 @@ enum EDF_EDbOperationStatusCode
 	FAILURE_ID_NOT_FOUND,
 
 	// Unknown
-	FAILURE_UNKNOWN
+	FAILURE_UNKNOWN,
+
+	// Appended to keep the values above unchanged
+	FAILURE_CONDITION_NOT_MET
 };
 
 class EDF_DbFindResultBase
@@ -71,6 +74,42 @@ class EDF_DbFindResultSingle<Class TEntityType> : EDF_DbFindResultBase
 	}
 };
 
+class EDF_DbCountResult : EDF_DbFindResultBase
+{
+	protected int m_iCount;
+
+	//------------------------------------------------------------------------------------------------
+	int GetCount()
+	{
+		return m_iCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbCountResult(EDF_EDbOperationStatusCode statusCode, int count = 0)
+	{
+		m_eStatusCode = statusCode;
+		m_iCount = count;
+	}
+};
+
+class EDF_DbExistsResult : EDF_DbFindResultBase
+{
+	protected bool m_bExists;
+
+	//------------------------------------------------------------------------------------------------
+	bool Exists()
+	{
+		return m_bExists;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbExistsResult(EDF_EDbOperationStatusCode statusCode, bool exists = false)
+	{
+		m_eStatusCode = statusCode;
+		m_bExists = exists;
+	}
+};
+
 class EDF_DbOperationCallback : EDF_Callback
 {
 };
@@ -101,12 +140,81 @@ class EDF_DbOperationStatusOnlyCallback : EDF_DbOperationCallback
 	}
 };
 
+//! Combines the results of multiple status only operations into one callback invoke once all of them completed.
+//! The first failure status code is reported if any of them failed.
+class EDF_DbOperationStatusMultiCallback : EDF_DbOperationStatusOnlyCallback
+{
+	protected int m_iPending;
+	protected EDF_EDbOperationStatusCode m_eStatusCode;
+	protected ref EDF_DbOperationStatusOnlyCallback m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		Complete(EDF_EDbOperationStatusCode.SUCCESS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		Complete(statusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Complete(EDF_EDbOperationStatusCode statusCode)
+	{
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS && m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS)
+			m_eStatusCode = statusCode;
+
+		if (--m_iPending == 0 && m_pCallback)
+			m_pCallback.Invoke(m_eStatusCode);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param pending amount of operations that will report into this callback. Invokes immediately on 0.
+	//! \param callback to invoke with the combined status code
+	void EDF_DbOperationStatusMultiCallback(int pending, EDF_DbOperationStatusOnlyCallback callback)
+	{
+		m_iPending = pending;
+		m_pCallback = callback;
+
+		if (m_iPending == 0 && m_pCallback)
+			m_pCallback.Invoke(EDF_EDbOperationStatusCode.SUCCESS);
+	}
+};
+
 class EDF_DbFindCallbackBase : EDF_DbOperationCallback
 {
 	//------------------------------------------------------------------------------------------------
 	void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults);
 };
 
+//! Forwards find results arranged in the order of the requested ids
+class EDF_DbFindByIdsOrderCallback : EDF_DbFindCallbackBase
+{
+	protected ref array<string> m_aEntityIds;
+	protected ref EDF_DbFindCallbackBase m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		if (!m_pCallback)
+			return;
+
+		if (code == EDF_EDbOperationStatusCode.SUCCESS && findResults)
+			findResults = EDF_DbEntityUtils.OrderByIds(findResults, m_aEntityIds);
+
+		m_pCallback.Invoke(code, findResults);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbFindByIdsOrderCallback(array<string> entityIds, EDF_DbFindCallbackBase callback)
+	{
+		m_aEntityIds = entityIds;
+		m_pCallback = callback;
+	}
+};
+
 class EDF_DbFindCallbackMultipleUntyped : EDF_DbFindCallbackBase
 {
 	//------------------------------------------------------------------------------------------------
@@ -192,6 +300,38 @@ class EDF_DbFindCallbackSingle<Class TEntityType> : EDF_DbFindCallbackBase
 	}
 };
 
+//! Receives the results of large finds in parts. Drivers that stream their results hand over one chunk at a time, all others one chunk with everything.
+class EDF_DbFindCallbackChunked : EDF_DbFindCallbackBase
+{
+	//------------------------------------------------------------------------------------------------
+	void OnChunk(array<ref EDF_DbEntity> chunk, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	//! Called once after the last chunk or on failure
+	void OnComplete(EDF_EDbOperationStatusCode statusCode, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	sealed override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		if (code == EDF_EDbOperationStatusCode.SUCCESS && findResults && !findResults.IsEmpty())
+			OnChunk(findResults, m_pContext);
+
+		OnComplete(code, m_pContext);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	sealed void InvokeChunk(notnull array<ref EDF_DbEntity> chunk)
+	{
+		OnChunk(chunk, m_pContext);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	sealed void InvokeComplete(EDF_EDbOperationStatusCode code)
+	{
+		OnComplete(code, m_pContext);
+	}
+};
+
 class EDF_DbFindCallbackSingleton<Class TEntityType> : EDF_DbFindCallbackBase
 {
 	//------------------------------------------------------------------------------------------------
@@ -229,3 +369,55 @@ class EDF_DbFindCallbackSingleton<Class TEntityType> : EDF_DbFindCallbackBase
 		}
 	}
 };
+
+class EDF_DbCountCallback : EDF_DbOperationCallback
+{
+	//------------------------------------------------------------------------------------------------
+	void OnSuccess(int count, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	sealed void Invoke(EDF_EDbOperationStatusCode code, int count)
+	{
+		if (m_pInvokeInstance &&
+			m_sInvokeMethod &&
+			GetGame().GetScriptModule().Call(m_pInvokeInstance, m_sInvokeMethod, false, null, code, count, m_pContext)) return;
+
+		if (code == EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			OnSuccess(count, m_pContext);
+		}
+		else
+		{
+			OnFailure(code, m_pContext);
+		}
+	}
+};
+
+class EDF_DbExistsCallback : EDF_DbOperationCallback
+{
+	//------------------------------------------------------------------------------------------------
+	void OnSuccess(bool exists, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context);
+
+	//------------------------------------------------------------------------------------------------
+	sealed void Invoke(EDF_EDbOperationStatusCode code, bool exists)
+	{
+		if (m_pInvokeInstance &&
+			m_sInvokeMethod &&
+			GetGame().GetScriptModule().Call(m_pInvokeInstance, m_sInvokeMethod, false, null, code, exists, m_pContext)) return;
+
+		if (code == EDF_EDbOperationStatusCode.SUCCESS)
+		{
+			OnSuccess(exists, m_pContext);
+		}
+		else
+		{
+			OnFailure(code, m_pContext);
+		}
+	}
+};
@@ -0,0 +1,293 @@
+class EDF_DbPatchField
+{
+	string m_sFieldPath;
+	ref array<string> m_aFieldPathSplits = {};
+
+	//------------------------------------------------------------------------------------------------
+	//! Resolve the instance holding the patched field. Returns null if the path can not be set on the entity.
+	Class GetHolder(notnull EDF_DbEntity entity)
+	{
+		if (m_aFieldPathSplits.IsEmpty())
+			return null;
+
+		Class holder = EDF_ReflectionUtils.GetPathHolder(entity, m_aFieldPathSplits);
+		if (!holder || !CanSet(holder))
+			return null;
+
+		return holder;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool CanSet(notnull Class holder);
+
+	//------------------------------------------------------------------------------------------------
+	//! Set the new value on the holder returned by GetHolder()
+	bool Apply(notnull Class holder);
+
+	//------------------------------------------------------------------------------------------------
+	//! Update operator the field is sent with e.g. "$set"
+	string GetOperator();
+
+	//------------------------------------------------------------------------------------------------
+	//! Write the field as "fieldPath": value into the currently open object
+	void Write(notnull BaseSerializationSaveContext saveContext);
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatchField Copy();
+
+	//------------------------------------------------------------------------------------------------
+	protected void SetFieldPath(string fieldPath)
+	{
+		m_sFieldPath = fieldPath;
+		fieldPath.Split(".", m_aFieldPathSplits, true);
+	}
+}
+
+class EDF_DbPatchFieldValue<Class ValueType> : EDF_DbPatchField
+{
+	ValueType m_Value;
+
+	//------------------------------------------------------------------------------------------------
+	override protected bool CanSet(notnull Class holder)
+	{
+		EDF_ReflectionVariableInfo info = EDF_ReflectionVariableInfo.Get(holder, m_aFieldPathSplits.Get(m_aFieldPathSplits.Count() - 1));
+		typename valueType = ValueType;
+		return info && info.m_iVariableIndex != -1 && info.m_tVaribleType == valueType;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Apply(notnull Class holder)
+	{
+		return EDF_ReflectionUtilsT<ValueType>.Set(holder, m_aFieldPathSplits.Get(m_aFieldPathSplits.Count() - 1), m_Value);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override string GetOperator()
+	{
+		return "$set";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void Write(notnull BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue(m_sFieldPath, m_Value);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbPatchField Copy()
+	{
+		return new EDF_DbPatchFieldValue<ValueType>(m_sFieldPath, m_Value);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbPatchFieldValue(string fieldPath, ValueType value)
+	{
+		SetFieldPath(fieldPath);
+		m_Value = value;
+	}
+}
+
+class EDF_DbPatchFieldIncrement<Class ValueType> : EDF_DbPatchField
+{
+	ValueType m_Delta;
+
+	//------------------------------------------------------------------------------------------------
+	override protected bool CanSet(notnull Class holder)
+	{
+		EDF_ReflectionVariableInfo info = EDF_ReflectionVariableInfo.Get(holder, m_aFieldPathSplits.Get(m_aFieldPathSplits.Count() - 1));
+		typename valueType = ValueType;
+		return info && info.m_iVariableIndex != -1 && info.m_tVaribleType == valueType;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Apply(notnull Class holder)
+	{
+		string fieldName = m_aFieldPathSplits.Get(m_aFieldPathSplits.Count() - 1);
+
+		ValueType currentValue;
+		if (!EDF_ReflectionUtilsT<ValueType>.Get(holder, fieldName, currentValue))
+			return false;
+
+		return EDF_ReflectionUtilsT<ValueType>.Set(holder, fieldName, currentValue + m_Delta);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override string GetOperator()
+	{
+		return "$inc";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void Write(notnull BaseSerializationSaveContext saveContext)
+	{
+		saveContext.WriteValue(m_sFieldPath, m_Delta);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override EDF_DbPatchField Copy()
+	{
+		return new EDF_DbPatchFieldIncrement<ValueType>(m_sFieldPath, m_Delta);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbPatchFieldIncrement(string fieldPath, ValueType delta)
+	{
+		SetFieldPath(fieldPath);
+		m_Delta = delta;
+	}
+}
+
+//! Serializes all patched fields of one operator as one object of "fieldPath": value pairs
+class EDF_DbPatchOperatorValues
+{
+	protected array<ref EDF_DbPatchField> m_aFields;
+	protected string m_sOperator;
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		foreach (EDF_DbPatchField field : m_aFields)
+		{
+			if (field.GetOperator() == m_sOperator)
+				field.Write(saveContext);
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbPatchOperatorValues(array<ref EDF_DbPatchField> fields, string operator)
+	{
+		m_aFields = fields;
+		m_sOperator = operator;
+	}
+}
+
+//! Describes new values for individual fields of an entity, so only they need to be changed instead of saving the entire entity.
+//! Use like: EDF_DbPatch.Create().Set("m_sName", "Bob").Increment("m_iMoney", 500).Set("m_pStats.m_fPlaytime", 12.5)
+//! The value type must match the field type exactly e.g. use 1.0 instead of 1 for float fields.
+class EDF_DbPatch
+{
+	ref array<ref EDF_DbPatchField> m_aFields = {};
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatch Set(string fieldPath, int value)
+	{
+		m_aFields.Insert(new EDF_DbPatchFieldValue<int>(fieldPath, value));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatch Set(string fieldPath, float value)
+	{
+		m_aFields.Insert(new EDF_DbPatchFieldValue<float>(fieldPath, value));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatch Set(string fieldPath, bool value)
+	{
+		m_aFields.Insert(new EDF_DbPatchFieldValue<bool>(fieldPath, value));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatch Set(string fieldPath, string value)
+	{
+		m_aFields.Insert(new EDF_DbPatchFieldValue<string>(fieldPath, value));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatch Set(string fieldPath, vector value)
+	{
+		m_aFields.Insert(new EDF_DbPatchFieldValue<vector>(fieldPath, value));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Add the delta to the current value of the field
+	EDF_DbPatch Increment(string fieldPath, int delta)
+	{
+		m_aFields.Insert(new EDF_DbPatchFieldIncrement<int>(fieldPath, delta));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Add the delta to the current value of the field
+	EDF_DbPatch Increment(string fieldPath, float delta)
+	{
+		m_aFields.Insert(new EDF_DbPatchFieldIncrement<float>(fieldPath, delta));
+		return this;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Apply all field changes in place. Nothing is changed if any of the fields can not be set.
+	//! \return true if all fields were set
+	bool Apply(notnull EDF_DbEntity entity)
+	{
+		// Resolve all targets first so an invalid path does not leave the entity half patched
+		array<Class> holders();
+		holders.Reserve(m_aFields.Count());
+		foreach (EDF_DbPatchField field : m_aFields)
+		{
+			Class holder = field.GetHolder(entity);
+			if (!holder)
+				return false;
+
+			holders.Insert(holder);
+		}
+
+		foreach (int idx, EDF_DbPatchField field : m_aFields)
+		{
+			if (!field.Apply(holders.Get(idx)))
+				return false;
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Write one {"fieldPath": value} object per used operator e.g. "$set" and "$inc" into the currently open object
+	void WriteOperators(notnull BaseSerializationSaveContext saveContext)
+	{
+		set<string> operators();
+		foreach (EDF_DbPatchField field : m_aFields)
+		{
+			string operator = field.GetOperator();
+			if (operators.Contains(operator))
+				continue;
+
+			operators.Insert(operator);
+
+			EDF_DbPatchOperatorValues operatorValues(m_aFields, operator);
+			saveContext.WriteValue(operator, operatorValues);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool SerializationSave(BaseSerializationSaveContext saveContext)
+	{
+		WriteOperators(saveContext);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbPatch Copy()
+	{
+		EDF_DbPatch copy();
+		copy.m_aFields.Reserve(m_aFields.Count());
+		foreach (EDF_DbPatchField field : m_aFields)
+		{
+			copy.m_aFields.Insert(field.Copy());
+		}
+
+		return copy;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_DbPatch Create()
+	{
+		return new EDF_DbPatch();
+	}
+}
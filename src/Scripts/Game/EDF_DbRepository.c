@@ -42,10 +42,72 @@ class EDF_DbRepository<Class TEntityType> : EDF_DbRepositoryBase
 		return m_DbContext.Remove(TEntityType, entity.GetId());
 	}
 
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode AddOrUpdateMany(notnull array<ref TEntityType> entities)
+	{
+		return m_DbContext.AddOrUpdateMany(EDF_RefArrayCaster<TEntityType, EDF_DbEntity>.Convert(entities));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode RemoveMany(notnull array<string> entityIds)
+	{
+		return m_DbContext.RemoveMany(TEntityType, entityIds);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode Patch(string entityId, notnull EDF_DbPatch patch, EDF_DbFindCondition condition = null)
+	{
+		return m_DbContext.Patch(TEntityType, entityId, patch, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode Increment(string entityId, string fieldPath, int delta)
+	{
+		return m_DbContext.Increment(TEntityType, entityId, fieldPath, delta);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode Increment(string entityId, string fieldPath, float delta)
+	{
+		return m_DbContext.Increment(TEntityType, entityId, fieldPath, delta);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode CompareAndSet(string entityId, string fieldPath, int expectedValue, int newValue)
+	{
+		return m_DbContext.CompareAndSet(TEntityType, entityId, fieldPath, expectedValue, newValue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode CompareAndSet(string entityId, string fieldPath, bool expectedValue, bool newValue)
+	{
+		return m_DbContext.CompareAndSet(TEntityType, entityId, fieldPath, expectedValue, newValue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode CompareAndSet(string entityId, string fieldPath, string expectedValue, string newValue)
+	{
+		return m_DbContext.CompareAndSet(TEntityType, entityId, fieldPath, expectedValue, newValue);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_EDbOperationStatusCode RemoveWhere(notnull EDF_DbFindCondition condition)
+	{
+		return m_DbContext.RemoveWhere(TEntityType, condition);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	EDF_DbFindResultSingle<TEntityType> Find(string entityId)
 	{
-		return FindFirst(EDF_DbFind.Id().Equals(entityId));
+		EDF_DbFindResultSingle<EDF_DbEntity> findResult = m_DbContext.FindById(TEntityType, entityId);
+		return new EDF_DbFindResultSingle<TEntityType>(findResult.GetStatusCode(), TEntityType.Cast(findResult.GetEntity()));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbFindResultMultiple<TEntityType> Find(notnull array<string> entityIds)
+	{
+		EDF_DbFindResultMultiple<EDF_DbEntity> findResults = m_DbContext.FindByIds(TEntityType, entityIds);
+		return new EDF_DbFindResultMultiple<TEntityType>(findResults.GetStatusCode(), EDF_RefArrayCaster<EDF_DbEntity, TEntityType>.Convert(findResults.GetEntities()));
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -82,6 +144,24 @@ class EDF_DbRepository<Class TEntityType> : EDF_DbRepositoryBase
 		return new EDF_DbFindResultMultiple<TEntityType>(findResults.GetStatusCode(), EDF_RefArrayCaster<EDF_DbEntity, TEntityType>.Convert(findResults.GetEntities()));
 	}
 
+	//------------------------------------------------------------------------------------------------
+	EDF_DbCountResult Count(EDF_DbFindCondition condition = null)
+	{
+		return m_DbContext.Count(TEntityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbExistsResult Exists(EDF_DbFindCondition condition = null)
+	{
+		return m_DbContext.Exists(TEntityType, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	EDF_DbAggregateResult Aggregate(notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null)
+	{
+		return m_DbContext.Aggregate(TEntityType, aggregation, condition);
+	}
+
 	// ------------------------------------------ ASYNC API ------------------------------------------
 
 	//------------------------------------------------------------------------------------------------
@@ -102,10 +182,70 @@ class EDF_DbRepository<Class TEntityType> : EDF_DbRepositoryBase
 		m_DbContext.RemoveAsync(TEntityType, entity.GetId(), callback);
 	}
 
+	//------------------------------------------------------------------------------------------------
+	void AddOrUpdateManyAsync(notnull array<ref TEntityType> entities, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.AddOrUpdateManyAsync(EDF_RefArrayCaster<TEntityType, EDF_DbEntity>.Convert(entities), callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void RemoveManyAsync(notnull array<string> entityIds, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.RemoveManyAsync(TEntityType, entityIds, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void PatchAsync(string entityId, notnull EDF_DbPatch patch, EDF_DbOperationStatusOnlyCallback callback = null, EDF_DbFindCondition condition = null)
+	{
+		m_DbContext.PatchAsync(TEntityType, entityId, patch, callback, condition);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void IncrementAsync(string entityId, string fieldPath, int delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.IncrementAsync(TEntityType, entityId, fieldPath, delta, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void IncrementAsync(string entityId, string fieldPath, float delta, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.IncrementAsync(TEntityType, entityId, fieldPath, delta, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CompareAndSetAsync(string entityId, string fieldPath, int expectedValue, int newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.CompareAndSetAsync(TEntityType, entityId, fieldPath, expectedValue, newValue, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CompareAndSetAsync(string entityId, string fieldPath, bool expectedValue, bool newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.CompareAndSetAsync(TEntityType, entityId, fieldPath, expectedValue, newValue, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CompareAndSetAsync(string entityId, string fieldPath, string expectedValue, string newValue, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.CompareAndSetAsync(TEntityType, entityId, fieldPath, expectedValue, newValue, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void RemoveWhereAsync(notnull EDF_DbFindCondition condition, EDF_DbOperationStatusOnlyCallback callback = null)
+	{
+		m_DbContext.RemoveWhereAsync(TEntityType, condition, callback);
+	}
+
 	//------------------------------------------------------------------------------------------------
 	void FindAsync(string entityId, notnull EDF_DbFindCallbackSingle<TEntityType> callback)
 	{
-		m_DbContext.FindAllAsync(TEntityType, EDF_DbFind.Id().Equals(entityId), null, 1, -1, callback);
+		m_DbContext.FindByIdAsync(TEntityType, entityId, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void FindAsync(notnull array<string> entityIds, notnull EDF_DbFindCallbackMultiple<TEntityType> callback)
+	{
+		m_DbContext.FindByIdsAsync(TEntityType, entityIds, callback);
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -125,6 +265,24 @@ class EDF_DbRepository<Class TEntityType> : EDF_DbRepositoryBase
 	{
 		m_DbContext.FindAllAsync(TEntityType, condition, orderBy, limit, offset, callback);
 	}
+
+	//------------------------------------------------------------------------------------------------
+	void CountAsync(EDF_DbFindCondition condition = null, EDF_DbCountCallback callback = null)
+	{
+		m_DbContext.CountAsync(TEntityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ExistsAsync(EDF_DbFindCondition condition = null, EDF_DbExistsCallback callback = null)
+	{
+		m_DbContext.ExistsAsync(TEntityType, condition, callback);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AggregateAsync(notnull EDF_DbAggregation aggregation, EDF_DbFindCondition condition = null, EDF_DbAggregateCallback callback = null)
+	{
+		m_DbContext.AggregateAsync(TEntityType, aggregation, condition, callback);
+	}
 	
 	//------------------------------------------------------------------------------------------------
 	/*sealed*/ static typename GetEntityType()
@@ -8,6 +8,33 @@ class EDF_ReflectionUtils
 		int stopRead = callStack.IndexOfFrom(startRead, "(");
 		return callStack.Substring(startRead, stopRead - startRead).ToType();
 	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get the instance holding the last field of a dot notation path e.g. "child.subField" returns the child.
+	//! Returns null if any field along the way is unknown, null, a collection or a primitive.
+	static Class GetPathHolder(notnull Class instance, notnull array<string> fieldPath)
+	{
+		Class holder = instance;
+		for (int nField = 0, count = fieldPath.Count() - 1; nField < count; nField++)
+		{
+			EDF_ReflectionVariableInfo info = EDF_ReflectionVariableInfo.Get(holder, fieldPath.Get(nField));
+			if (!info ||
+				info.m_iVariableIndex == -1 ||
+				info.m_eCollectionType != EDF_ReflectionVariableCollectionType.NONE ||
+				!info.m_tVaribleType.IsInherited(Class))
+			{
+				return null;
+			}
+
+			Class nestedHolder;
+			if (!info.m_tHolderType.GetVariableValue(holder, info.m_iVariableIndex, nestedHolder) || !nestedHolder)
+				return null;
+
+			holder = nestedHolder;
+		}
+
+		return holder;
+	}
 };
 
 class EDF_ReflectionUtilsT<Class T>
@@ -22,7 +49,20 @@ class EDF_ReflectionUtilsT<Class T>
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//TODO: Add Set() via Json serializer
+	//! Set a variable in place. The variable type must match exactly, no conversion is done.
+	static bool Set(notnull Class instance, string variableName, T value)
+	{
+		EDF_ReflectionVariableInfo info = EDF_ReflectionVariableInfo.Get(instance, variableName);
+		if (!info || info.m_iVariableIndex == -1)
+			return false;
+
+		typename valueType = T;
+		if (info.m_tVaribleType != valueType)
+			return false;
+
+		EnScript.SetClassVar(instance, variableName, 0, value);
+		return true;
+	}
 };
 
 enum EDF_ReflectionVariableCollectionType
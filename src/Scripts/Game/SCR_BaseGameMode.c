@@ -3,8 +3,9 @@ modded class SCR_BaseGameMode
 	//------------------------------------------------------------------------------------------------
 	override void OnGameEnd()
 	{
-		// On game end before any final flushes, hard map the async api into sync to make those operations blocking and not loose data
-		EDF_DbDriver.s_bForceBlocking = true;
+		// On game end before any final flushes, collect async writes and drain them in batches until the deadline.
+		// Afterwards the async api is hard mapped into sync to make those operations blocking and not loose data.
+		EDF_DbShutdownFlush.Begin();
 		super.OnGameEnd();
 	}
 
@@ -12,6 +13,7 @@ modded class SCR_BaseGameMode
 	void ~SCR_BaseGameMode()
 	{
 		// TODO: Find better event for "session" teardown that works on dedicated servers, workbench and player hosted missions.
+		EDF_DbShutdownFlush.Finish(); // Session ends before the drain completed, write the rest now
 		EDF_DbDriver.s_bForceBlocking = false;
 		EDF_DbEntityIdGenerator.Reset();
 		EDF_WebProxyDbDriverCallback.Reset();
@@ -0,0 +1,286 @@
+//! Base of generated entities. Fills itself with random data drawn from the generator.
+class EDF_Test_DatasetEntity : EDF_DbEntity
+{
+	//------------------------------------------------------------------------------------------------
+	void Randomize(EDF_DbDatasetGenerator generator, int index);
+};
+
+class EDF_Test_DatasetItem
+{
+	string m_sPrefab;
+	int m_iQuantity;
+	float m_fCondition;
+	ref array<string> m_aAttachments;
+
+	//------------------------------------------------------------------------------------------------
+	void Randomize(EDF_DbDatasetGenerator generator)
+	{
+		m_sPrefab = generator.Pick(EDF_DbDatasetGenerator.ITEM_PREFABS);
+		m_iQuantity = generator.RandSkewed(1, 60, 3);
+		m_fCondition = generator.RandFloat(0.1, 1);
+
+		int attachments = generator.RandSkewed(0, 4, 2);
+		if (attachments > 0)
+		{
+			m_aAttachments = {};
+			for (int nAttachment = 0; nAttachment < attachments; nAttachment++)
+			{
+				m_aAttachments.Insert(generator.Pick(EDF_DbDatasetGenerator.ATTACHMENT_PREFABS));
+			}
+		}
+	}
+};
+
+class EDF_Test_DatasetDamage
+{
+	float m_fHealth;
+	ref map<string, float> m_mHitZones = new map<string, float>();
+
+	//------------------------------------------------------------------------------------------------
+	void Randomize(EDF_DbDatasetGenerator generator, array<string> hitZones)
+	{
+		m_fHealth = 1;
+		foreach (string hitZone : hitZones)
+		{
+			// Most hit zones are untouched
+			if (generator.Chance(0.7))
+				continue;
+
+			float health = generator.RandFloat(0, 1);
+			m_mHitZones.Set(hitZone, health);
+			m_fHealth = Math.Min(m_fHealth, health);
+		}
+	}
+};
+
+class EDF_Test_DatasetCharacter : EDF_Test_DatasetEntity
+{
+	string m_sName;
+	string m_sFaction;
+	int m_iLevel;
+	float m_fMoney;
+	bool m_bActive;
+	vector m_vPosition;
+	vector m_vAngles;
+	ref EDF_Test_DatasetDamage m_pDamage = new EDF_Test_DatasetDamage();
+	ref array<ref EDF_Test_DatasetItem> m_aInventory = {};
+	ref map<string, int> m_mStats = new map<string, int>();
+
+	//------------------------------------------------------------------------------------------------
+	override void Randomize(EDF_DbDatasetGenerator generator, int index)
+	{
+		m_sName = string.Format("%1 %2", generator.Pick(EDF_DbDatasetGenerator.NAMES), index);
+		m_sFaction = generator.PickWeighted(EDF_DbDatasetGenerator.FACTIONS, EDF_DbDatasetGenerator.FACTION_WEIGHTS);
+		m_iLevel = generator.RandSkewed(1, 100, 2);
+		m_fMoney = generator.RandSkewed(0, 1000000, 4);
+		m_bActive = generator.Chance(0.8);
+		m_vPosition = generator.RandPosition();
+		m_vAngles = Vector(0, generator.RandFloat(0, 360), 0);
+		m_pDamage.Randomize(generator, EDF_DbDatasetGenerator.CHARACTER_HIT_ZONES);
+
+		int items = generator.RandSkewed(0, generator.m_iMaxInventoryItems, 2);
+		for (int nItem = 0; nItem < items; nItem++)
+		{
+			EDF_Test_DatasetItem item();
+			item.Randomize(generator);
+			m_aInventory.Insert(item);
+		}
+
+		foreach (string stat : EDF_DbDatasetGenerator.STATS)
+		{
+			if (generator.Chance(0.6))
+				m_mStats.Set(stat, generator.RandSkewed(0, 5000, 3));
+		}
+	}
+};
+
+class EDF_Test_DatasetVehicle : EDF_Test_DatasetEntity
+{
+	string m_sPrefab;
+	string m_sOwnerId;
+	float m_fFuel;
+	bool m_bLocked;
+	vector m_vPosition;
+	vector m_vAngles;
+	ref EDF_Test_DatasetDamage m_pDamage = new EDF_Test_DatasetDamage();
+	ref array<ref EDF_Test_DatasetItem> m_aCargo = {};
+
+	//------------------------------------------------------------------------------------------------
+	override void Randomize(EDF_DbDatasetGenerator generator, int index)
+	{
+		m_sPrefab = generator.Pick(EDF_DbDatasetGenerator.VEHICLE_PREFABS);
+		if (generator.Chance(0.6))
+			m_sOwnerId = generator.GetId(EDF_Test_DatasetCharacter, generator.RandSkewed(0, 1000, 1));
+
+		m_fFuel = generator.RandFloat(0, 1);
+		m_bLocked = generator.Chance(0.3);
+		m_vPosition = generator.RandPosition();
+		m_vAngles = Vector(generator.RandFloat(-5, 5), generator.RandFloat(0, 360), generator.RandFloat(-5, 5));
+		m_pDamage.Randomize(generator, EDF_DbDatasetGenerator.VEHICLE_HIT_ZONES);
+
+		int items = generator.RandSkewed(0, generator.m_iMaxInventoryItems * 2, 3);
+		for (int nItem = 0; nItem < items; nItem++)
+		{
+			EDF_Test_DatasetItem item();
+			item.Randomize(generator);
+			m_aCargo.Insert(item);
+		}
+	}
+};
+
+//! Creates reproducible datasets of entities shaped like real saves, with nested objects, arrays, maps and vectors.
+//! Every entity only depends on the seed, its type and index, so any range of a dataset can be regenerated on its own.
+class EDF_DbDatasetGenerator
+{
+	static const ref array<string> NAMES = {"Anderson", "Baker", "Carter", "Dmitri", "Evans", "Fedorov", "Garcia", "Hughes", "Ivanov", "Jensen", "Kowalski", "Lebedev"};
+	static const ref array<string> FACTIONS = {"US", "USSR", "FIA"};
+	static const ref array<float> FACTION_WEIGHTS = {0.45, 0.45, 0.1};
+	static const ref array<string> STATS = {"kills", "deaths", "distance", "shots", "hits", "revives", "captures", "playtime"};
+	static const ref array<string> CHARACTER_HIT_ZONES = {"Head", "Chest", "Abdomen", "LeftArm", "RightArm", "LeftLeg", "RightLeg"};
+	static const ref array<string> VEHICLE_HIT_ZONES = {"Hull", "Engine", "FuelTank", "Wheel_1", "Wheel_2", "Wheel_3", "Wheel_4"};
+	static const ref array<string> ITEM_PREFABS = {"{3E413771E1834D2F}Prefabs/Weapons/Rifles/M16/Rifle_M16A2.et", "{FA5C25BF66A53DCF}Prefabs/Weapons/Rifles/AK74/Rifle_AK74.et", "{A9A385FE1F7BF4BD}Prefabs/Weapons/Magazines/Magazine_556x45_STANAG_30rnd_Ball.et", "{0A84AA5A3884176F}Prefabs/Weapons/Magazines/Magazine_545x39_AK_30rnd_Last_5Tracer.et", "{A81F501D3EF6F38E}Prefabs/Items/Medicine/FieldDressing_01/FieldDressing_US_01.et", "{9C5C20FB0E01E64F}Prefabs/Items/Equipment/Compass/Compass_Adrianov.et"};
+	static const ref array<string> ATTACHMENT_PREFABS = {"{D3D0E8C1F4A9C70B}Prefabs/Weapons/Attachments/Optics/Optic_ARTII.et", "{A7E7C8E6F3C4D1B2}Prefabs/Weapons/Attachments/Muzzle/Suppressor_M16.et", "{F1B2C3D4E5A60718}Prefabs/Weapons/Attachments/Underbarrel/UGL_M203.et"};
+	static const ref array<string> VEHICLE_PREFABS = {"{47D94E1193A88497}Prefabs/Vehicles/Wheeled/M998/M1025_armed_M2HB.et", "{259EE7B78C51B624}Prefabs/Vehicles/Wheeled/UAZ469/UAZ469.et", "{81FDAD5EB644CC3D}Prefabs/Vehicles/Wheeled/M923A1/M923A1_transport.et", "{16C1F16C9B053801}Prefabs/Vehicles/Wheeled/Ural4320/Ural4320_transport.et"};
+
+	int m_iMaxInventoryItems = 40;
+	float m_fWorldSize = 12800;
+
+	protected int m_iSeed;
+	protected ref RandomGenerator m_pRandom = new RandomGenerator();
+
+	//------------------------------------------------------------------------------------------------
+	//! Deterministic id of the entity at index of the dataset, e.g. to reference it from other entities
+	string GetId(typename entityType, int index)
+	{
+		string indexHex = EDF_HexHelper.Convert(index, false, 8);
+		return string.Format("%1-%2-%3-%4-000000000000",
+			EDF_HexHelper.Convert(m_iSeed, false, 8),
+			indexHex.Substring(0, 4),
+			indexHex.Substring(4, 4),
+			EDF_HexHelper.Convert(HashType(entityType), false, 8).Substring(4, 4));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Create count entities starting at index offset
+	array<ref EDF_DbEntity> Generate(typename entityType, int count, int offset = 0)
+	{
+		array<ref EDF_DbEntity> entities();
+		entities.Reserve(count);
+
+		for (int index = offset, until = offset + count; index < until; index++)
+		{
+			EDF_Test_DatasetEntity entity = EDF_Test_DatasetEntity.Cast(entityType.Spawn());
+			if (!entity)
+			{
+				Debug.Error(string.Format("Can not generate '%1', it does not inherit from EDF_Test_DatasetEntity.", entityType));
+				return entities;
+			}
+
+			// Seeded per entity so it does not depend on what was generated before
+			m_pRandom.SetSeed(m_iSeed + HashType(entityType) + index * 7919);
+			entity.SetId(GetId(entityType, index));
+			entity.Randomize(this, index);
+			entities.Insert(entity);
+		}
+
+		return entities;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Generate and store entities batch by batch through the driver API
+	EDF_EDbOperationStatusCode WriteTo(notnull EDF_DbDriver driver, typename entityType, int count, int batchSize = 1000)
+	{
+		for (int offset = 0; offset < count; offset += batchSize)
+		{
+			EDF_EDbOperationStatusCode statusCode = driver.AddOrUpdateMany(Generate(entityType, Math.Min(batchSize, count - offset), offset));
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+				return statusCode;
+		}
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Generate entities straight into the storage files of a file driver, bypassing its caches
+	EDF_EDbOperationStatusCode ImportTo(notnull EDF_FileDbDriverBase driver, typename entityType, int count, int batchSize = 1000)
+	{
+		for (int offset = 0; offset < count; offset += batchSize)
+		{
+			EDF_EDbOperationStatusCode statusCode = driver.Import(Generate(entityType, Math.Min(batchSize, count - offset), offset));
+			if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+				return statusCode;
+		}
+
+		return EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float RandFloat(float min, float max)
+	{
+		return m_pRandom.RandFloatXY(min, max);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Random int between min and max (inclusive). Higher power makes values close to min more likely.
+	int RandSkewed(int min, int max, float power)
+	{
+		float value = Math.Pow(m_pRandom.RandFloat01(), power);
+		int offset = Math.Floor(value * (max - min + 1));
+		return Math.Min(min + offset, max);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool Chance(float probability)
+	{
+		return m_pRandom.RandFloat01() < probability;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	vector RandPosition()
+	{
+		float x = RandFloat(0, m_fWorldSize);
+		float z = RandFloat(0, m_fWorldSize);
+		return Vector(x, RandFloat(0, 400), z);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	string Pick(notnull array<string> values)
+	{
+		int index = Math.Floor(m_pRandom.RandFloat01() * values.Count());
+		return values.Get(Math.Min(index, values.Count() - 1));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \param weights same amount as values, summing up to 1
+	string PickWeighted(notnull array<string> values, notnull array<float> weights)
+	{
+		float roll = m_pRandom.RandFloat01();
+		foreach (int nValue, float weight : weights)
+		{
+			roll -= weight;
+			if (roll < 0)
+				return values.Get(nValue);
+		}
+
+		return values.Get(values.Count() - 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static int HashType(typename entityType)
+	{
+		string typeName = entityType.ToString();
+		int hash = 5381;
+		for (int nChar = 0, length = typeName.Length(); nChar < length; nChar++)
+		{
+			hash = hash * 33 + typeName.ToAscii(nChar);
+		}
+
+		return hash & 0x7FFFFFFF;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbDatasetGenerator(int seed = 0)
+	{
+		m_iSeed = seed;
+	}
+};
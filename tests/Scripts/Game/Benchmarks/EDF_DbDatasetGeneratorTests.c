@@ -0,0 +1,37 @@
+class EDF_DbDatasetGeneratorTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDatasetGeneratorTests")]
+TestResultBase EDF_Test_DbDatasetGenerator_Generate_SameSeedDifferentBatches_IdenticalEntities()
+{
+	// Arrange
+	EDF_DbDatasetGenerator generator(42);
+	array<ref EDF_DbEntity> all = generator.Generate(EDF_Test_DatasetCharacter, 10);
+
+	// Act
+	EDF_DbDatasetGenerator otherGenerator(42);
+	array<ref EDF_DbEntity> tail = otherGenerator.Generate(EDF_Test_DatasetCharacter, 5, 5);
+
+	// Assert
+	bool identical = tail.Count() == 5;
+	foreach (int nEntity, EDF_DbEntity entity : tail)
+	{
+		if (EDF_DbEntityUtils.ToJson(entity) != EDF_DbEntityUtils.ToJson(all.Get(nEntity + 5)))
+			identical = false;
+	}
+
+	return new EDF_TestResult(identical && all.Get(7).GetId() == generator.GetId(EDF_Test_DatasetCharacter, 7));
+};
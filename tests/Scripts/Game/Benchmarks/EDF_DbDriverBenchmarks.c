@@ -0,0 +1,488 @@
+class EDF_DbDriverBenchmarks : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_BenchmarkEntity : EDF_DbEntity
+{
+	int m_iIndex;
+	int m_iBucket;
+	float m_fValue;
+	string m_sName;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_Test_BenchmarkEntity Create(int index)
+	{
+		EDF_Test_BenchmarkEntity instance();
+		instance.SetId(EDF_DbEntityIdGenerator.Generate());
+		instance.m_iIndex = index;
+		instance.m_iBucket = index % EDF_DbBenchmark.BUCKETS;
+		instance.m_fValue = (index * 7919) % 100003;
+		instance.m_sName = string.Format("Entity %1", index);
+		return instance;
+	}
+};
+
+//! Runs the same workloads against every registered driver and collects throughput and latency percentiles.
+//! Only active with the -DbBenchmark CLI param, optionally limited to some sizes e.g. -DbBenchmark=1000,10000.
+//! The results are printed and added as csv to the test results report by EDF_AutoTestEntity.
+class EDF_DbBenchmark
+{
+	static const int BUCKETS = 10;
+	static const int BATCH_SIZE = 1000;
+	static const int MAX_POINT_READS = 10000;
+	static const int PAGE_SIZE = 50;
+	static const int PAGES = 10;
+	static const string DB_NAME = "EDF_Benchmark";
+
+	protected static ref array<ref EDF_DbBenchmarkResult> s_aResults;
+
+	//------------------------------------------------------------------------------------------------
+	//! \param entityCount size of the workload, 0 to check if benchmarks are enabled at all
+	static bool IsEnabled(int entityCount = 0)
+	{
+		string sizes;
+		if (!System.GetCLIParam("DbBenchmark", sizes))
+			return false;
+
+		if (entityCount == 0 || sizes.IsEmpty())
+			return true;
+
+		array<string> sizeValues();
+		sizes.Split(",", sizeValues, true);
+		foreach (string sizeValue : sizeValues)
+		{
+			if (sizeValue.Trim().ToInt() == entityCount)
+				return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static array<ref EDF_DbBenchmarkResult> GetResults()
+	{
+		if (!s_aResults)
+			s_aResults = {};
+
+		return s_aResults;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Connection strings of all registered drivers. Drivers that wrap others are benchmarked in front of the in-memory driver.
+	static array<string> GetConnectionStrings()
+	{
+		array<string> connectionStrings();
+		foreach (typename driverType : EDF_DbDriverRegistry.GetAll())
+		{
+			string connectionString = string.Format("%1://%2", driverType, DB_NAME);
+
+			if (driverType.IsInherited(EDF_TieredDbDriver))
+				connectionString += "?cold=InMemory";
+
+			if (driverType.IsInherited(EDF_ShardedDbDriver))
+				connectionString += "?shard=InMemory&shards=4";
+
+			if (driverType.IsInherited(EDF_LatencyDbDriver))
+				connectionString += "?inner=InMemory";
+
+			// One canned result to keep the reads successful
+			if (driverType.IsInherited(EDF_NullDbDriver))
+				connectionString += "?results=1";
+
+			connectionStrings.Insert(connectionString);
+		}
+
+		return connectionStrings;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Run all workloads against all drivers
+	//! \return false if any workload failed on a driver that accepted the initial insert
+	static bool Run(int entityCount)
+	{
+		bool success = true;
+		foreach (string connectionString : GetConnectionStrings())
+		{
+			if (!RunDriver(connectionString, entityCount))
+				success = false;
+		}
+
+		return success;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static bool RunDriver(string connectionString, int entityCount)
+	{
+		EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse(connectionString);
+		if (!connectInfo)
+			return true;
+
+		connectInfo.m_sDatabaseName = string.Format("%1_%2", DB_NAME, entityCount);
+
+		typename driverType = EDF_DbConnectionInfoDriverType.GetDriverType(connectInfo.Type());
+		EDF_DbDriver driver = EDF_DbDriver.Cast(driverType.Spawn());
+		if (!driver || !driver.Initialize(connectInfo))
+		{
+			PrintFormat("Benchmark skipped %1, driver could not be initialized.", driverType);
+			return true;
+		}
+
+		// Blocking writes of the web proxy driver can not tell if the proxy answered, e.g. tools/reference-proxy is not running
+		if (driver.Count(EDF_Test_BenchmarkEntity).GetStatusCode() == EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE)
+		{
+			PrintFormat("Benchmark skipped %1, database is not reachable.", driverType);
+			return true;
+		}
+
+		array<ref EDF_DbEntity> entities();
+		entities.Reserve(entityCount);
+		array<string> ids();
+		ids.Reserve(entityCount);
+		for (int nEntity = 0; nEntity < entityCount; nEntity++)
+		{
+			EDF_Test_BenchmarkEntity entity = EDF_Test_BenchmarkEntity.Create(nEntity);
+			entities.Insert(entity);
+			ids.Insert(entity.GetId());
+		}
+
+		EDF_DbBenchmarkResult insert = BulkInsert(driver, driverType, entities);
+		if (!insert)
+			return true;
+
+		EDF_DbBenchmarkResult pointRead = PointRead(driver, driverType, ids);
+		EDF_DbBenchmarkResult scan = FilteredScan(driver, driverType, entityCount);
+		EDF_DbBenchmarkResult sortedPage = SortedPage(driver, driverType, entityCount);
+		EDF_DbBenchmarkResult repositoryScan = RepositoryScan(connectInfo, driverType, entityCount);
+		EDF_DbBenchmarkResult remove = Delete(driver, driverType, ids);
+		return insert.IsSuccess() && pointRead.IsSuccess() && scan.IsSuccess() && sortedPage.IsSuccess() && repositoryScan.IsSuccess() && remove.IsSuccess();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! \return null if the driver is not usable
+	protected static EDF_DbBenchmarkResult BulkInsert(EDF_DbDriver driver, typename driverType, array<ref EDF_DbEntity> entities)
+	{
+		int entityCount = entities.Count();
+		EDF_DbBenchmarkResult result = Begin(driverType, "BulkInsert", entityCount);
+		for (int nBatch = 0; nBatch < entityCount; nBatch += BATCH_SIZE)
+		{
+			array<ref EDF_DbEntity> batch();
+			int until = Math.Min(nBatch + BATCH_SIZE, entityCount);
+			for (int nEntity = nBatch; nEntity < until; nEntity++)
+			{
+				batch.Insert(entities.Get(nEntity));
+			}
+
+			EDF_EDbOperationStatusCode statusCode = driver.AddOrUpdateMany(batch);
+			result.Record(statusCode, batch.Count());
+
+			// Nothing to measure against a database that is not reachable
+			if (nBatch == 0 && statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			{
+				GetResults().RemoveItem(result);
+				PrintFormat("Benchmark skipped %1, initial insert failed with %2.", driverType, typename.EnumToString(EDF_EDbOperationStatusCode, statusCode));
+				return null;
+			}
+		}
+
+		Finish(result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Reads spread over the whole id range
+	protected static EDF_DbBenchmarkResult PointRead(EDF_DbDriver driver, typename driverType, array<string> ids)
+	{
+		int entityCount = ids.Count();
+		int reads = Math.Min(entityCount, MAX_POINT_READS);
+		EDF_DbBenchmarkResult result = Begin(driverType, "PointRead", entityCount);
+		for (int nRead = 0; nRead < reads; nRead++)
+		{
+			EDF_DbFindResultSingle<EDF_DbEntity> findResult = driver.FindById(EDF_Test_BenchmarkEntity, ids.Get((nRead * 7919) % entityCount));
+			EDF_EDbOperationStatusCode statusCode = findResult.GetStatusCode();
+			if (statusCode == EDF_EDbOperationStatusCode.SUCCESS && !findResult.GetEntity())
+				statusCode = EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND;
+
+			result.Record(statusCode, 1);
+		}
+
+		Finish(result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Scans that each return one bucket of entities
+	protected static EDF_DbBenchmarkResult FilteredScan(EDF_DbDriver driver, typename driverType, int entityCount)
+	{
+		EDF_DbBenchmarkResult result = Begin(driverType, "FilteredScan", entityCount);
+		for (int nBucket = 0; nBucket < BUCKETS; nBucket++)
+		{
+			EDF_DbFindResultMultiple<EDF_DbEntity> findResults = driver.FindAll(EDF_Test_BenchmarkEntity, EDF_DbFind.Field("m_iBucket").Equals(nBucket));
+			result.Record(findResults.GetStatusCode(), 1);
+		}
+
+		Finish(result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Consecutive pages over the full collection
+	protected static EDF_DbBenchmarkResult SortedPage(EDF_DbDriver driver, typename driverType, int entityCount)
+	{
+		EDF_DbBenchmarkResult result = Begin(driverType, "SortedPage", entityCount);
+		for (int nPage = 0; nPage < PAGES; nPage++)
+		{
+			EDF_DbFindResultMultiple<EDF_DbEntity> findResults = driver.FindAll(EDF_Test_BenchmarkEntity, null, {{"m_fValue", EDF_EDbEntitySortDirection.DESCENDING}}, PAGE_SIZE, nPage * PAGE_SIZE);
+			result.Record(findResults.GetStatusCode(), 1);
+		}
+
+		Finish(result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Same scans as FilteredScan but through context and repository. Against the Null driver this is the pure framework overhead.
+	protected static EDF_DbBenchmarkResult RepositoryScan(EDF_DbConnectionInfoBase connectInfo, typename driverType, int entityCount)
+	{
+		EDF_DbBenchmarkResult result = Begin(driverType, "RepositoryScan", entityCount);
+		EDF_DbContext context = EDF_DbContext.Create(connectInfo);
+		if (!context)
+		{
+			result.Record(EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE, 0);
+			Finish(result);
+			return result;
+		}
+
+		EDF_DbRepository<EDF_Test_BenchmarkEntity> repository = EDF_DbEntityHelper<EDF_Test_BenchmarkEntity>.GetRepository(context);
+		for (int nBucket = 0; nBucket < BUCKETS; nBucket++)
+		{
+			EDF_DbFindResultMultiple<EDF_Test_BenchmarkEntity> findResults = repository.FindAll(EDF_DbFind.Field("m_iBucket").Equals(nBucket));
+			result.Record(findResults.GetStatusCode(), 1);
+		}
+
+		Finish(result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Batched deletes, which also clean up the benchmark database
+	protected static EDF_DbBenchmarkResult Delete(EDF_DbDriver driver, typename driverType, array<string> ids)
+	{
+		int entityCount = ids.Count();
+		EDF_DbBenchmarkResult result = Begin(driverType, "Delete", entityCount);
+		for (int nBatch = 0; nBatch < entityCount; nBatch += BATCH_SIZE)
+		{
+			array<string> batchIds();
+			int until = Math.Min(nBatch + BATCH_SIZE, entityCount);
+			for (int nEntity = nBatch; nEntity < until; nEntity++)
+			{
+				batchIds.Insert(ids.Get(nEntity));
+			}
+
+			result.Record(driver.RemoveMany(EDF_Test_BenchmarkEntity, batchIds), batchIds.Count());
+		}
+
+		Finish(result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static EDF_DbBenchmarkResult Begin(typename driverType, string workload, int entityCount)
+	{
+		EDF_DbBenchmarkResult result(driverType.ToString(), workload, entityCount);
+		GetResults().Insert(result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void Finish(EDF_DbBenchmarkResult result)
+	{
+		result.Stop();
+		Print(result.Format(), LogLevel.NORMAL);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! All results collected so far as csv inside a test suite element of their own
+	//! \return empty if nothing was benchmarked
+	static string GetReportXml()
+	{
+		if (!s_aResults || s_aResults.IsEmpty())
+			return string.Empty;
+
+		string csv = "driver,workload,entities,operations,errors,elapsedMs,opsPerSecond,avgMs,groupP50Ms,groupP95Ms,groupP99Ms,groupMaxMs\n";
+		foreach (EDF_DbBenchmarkResult result : s_aResults)
+		{
+			csv += result.ToCsv() + "\n";
+		}
+
+		return string.Format("<testsuite name=\"EDF_DbBenchmarkResults\" tests=\"0\" failures=\"0\" errors=\"0\"><system-out><![CDATA[\n%1]]></system-out></testsuite>\n", csv);
+	}
+};
+
+class EDF_DbBenchmarkResult
+{
+	static const int MIN_SAMPLE_MS = 10;
+
+	string m_sDriver;
+	string m_sWorkload;
+	int m_iEntities;
+	int m_iCalls;
+	int m_iOperations;
+	int m_iErrors;
+	int m_iStartTime;
+	int m_iElapsedMs;
+	ref array<float> m_aLatencies = {}; //!< Average ms per call of each group of calls timed together, percentiles are taken over these group averages
+
+	protected int m_iSampleStart;
+	protected int m_iSampleCalls;
+	protected int m_iSampledMs;
+
+	//------------------------------------------------------------------------------------------------
+	//! Count a finished driver call. The tick count only has millisecond resolution, so consecutive calls are timed
+	//! together until at least MIN_SAMPLE_MS passed and each latency sample is the average of its calls.
+	//! \param operations amount of entities handled by the call
+	void Record(EDF_EDbOperationStatusCode statusCode, int operations)
+	{
+		if (statusCode != EDF_EDbOperationStatusCode.SUCCESS)
+			m_iErrors++;
+
+		m_iCalls++;
+		m_iOperations += operations;
+		m_iSampleCalls++;
+		if (System.GetTickCount() - m_iSampleStart >= MIN_SAMPLE_MS)
+			CloseSample();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Take the last calls as a sample, even if they were faster than MIN_SAMPLE_MS together
+	void Stop()
+	{
+		if (m_iSampleCalls > 0)
+			CloseSample();
+
+		m_iElapsedMs = System.GetTickCount() - m_iStartTime;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsSuccess()
+	{
+		return m_iErrors == 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetOpsPerSecond()
+	{
+		float operations = m_iOperations * 1000;
+		return operations / Math.Max(m_iElapsedMs, 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetAverageLatency()
+	{
+		if (m_iCalls == 0)
+			return 0;
+
+		float sampledMs = m_iSampledMs;
+		return sampledMs / m_iCalls;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Percentile of the group averages, not of single calls. Calls slower than MIN_SAMPLE_MS are a group of their own, faster outliers are averaged out.
+	//! \param percentile between 0 and 1, 1 for the slowest group
+	float GetLatencyPercentile(float percentile)
+	{
+		if (m_aLatencies.IsEmpty())
+			return 0;
+
+		array<float> sorted();
+		sorted.Copy(m_aLatencies);
+		sorted.Sort();
+
+		int index = Math.Ceil(sorted.Count() * percentile) - 1;
+		return sorted.Get(Math.ClampInt(index, 0, sorted.Count() - 1));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	string Format()
+	{
+		return string.Format("Benchmark %1 %2 @%3: %4 ops/s, avg=%5ms, group averages p50=%6ms p95=%7ms p99=%8ms max=%9ms",
+			m_sDriver,
+			m_sWorkload,
+			m_iEntities,
+			GetOpsPerSecond(),
+			GetAverageLatency(),
+			GetLatencyPercentile(0.5),
+			GetLatencyPercentile(0.95),
+			GetLatencyPercentile(0.99),
+			GetLatencyPercentile(1));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	string ToCsv()
+	{
+		return string.Format("%1,%2,%3,%4,%5,%6,%7,%8,%9,", m_sDriver, m_sWorkload, m_iEntities, m_iOperations, m_iErrors, m_iElapsedMs, GetOpsPerSecond(), GetAverageLatency(), GetLatencyPercentile(0.5)) +
+			string.Format("%1,%2,%3", GetLatencyPercentile(0.95), GetLatencyPercentile(0.99), GetLatencyPercentile(1));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void CloseSample()
+	{
+		int now = System.GetTickCount();
+		int elapsedMs = now - m_iSampleStart;
+		float sampleMs = elapsedMs;
+		m_aLatencies.Insert(sampleMs / m_iSampleCalls);
+		m_iSampledMs += elapsedMs;
+		m_iSampleStart = now;
+		m_iSampleCalls = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_DbBenchmarkResult(string driver, string workload, int entities)
+	{
+		m_sDriver = driver;
+		m_sWorkload = workload;
+		m_iEntities = entities;
+		m_iStartTime = System.GetTickCount();
+		m_iSampleStart = m_iStartTime;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverBenchmarks")]
+TestResultBase EDF_Test_DbDriverBenchmark_AllDrivers_1kEntities_NoErrors()
+{
+	if (!EDF_DbBenchmark.IsEnabled(1000))
+		return new EDF_TestResult(true);
+
+	return new EDF_TestResult(EDF_DbBenchmark.Run(1000));
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverBenchmarks")]
+TestResultBase EDF_Test_DbDriverBenchmark_AllDrivers_10kEntities_NoErrors()
+{
+	if (!EDF_DbBenchmark.IsEnabled(10000))
+		return new EDF_TestResult(true);
+
+	return new EDF_TestResult(EDF_DbBenchmark.Run(10000));
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverBenchmarks")]
+TestResultBase EDF_Test_DbDriverBenchmark_AllDrivers_100kEntities_NoErrors()
+{
+	if (!EDF_DbBenchmark.IsEnabled(100000))
+		return new EDF_TestResult(true);
+
+	return new EDF_TestResult(EDF_DbBenchmark.Run(100000));
+};
@@ -0,0 +1,103 @@
+class EDF_WebProxyPayloadBenchmarks : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+//! Rewrites of the type discriminators on large polymorphic documents, as the web proxy driver does for every entity it sends or receives.
+//! Uses the same -DbBenchmark CLI param and result collection as EDF_DbBenchmark.
+class EDF_WebProxyPayloadBenchmark : EDF_DbBenchmark
+{
+	static const int ITEMS_PER_CHUNK = 100;
+	static const int ROUNDS = 5;
+
+	//------------------------------------------------------------------------------------------------
+	//! \param itemCount polymorphic items in the document, each about 250 bytes
+	//! \return false if a rewrite did not give back the original document
+	static bool Run(int itemCount)
+	{
+		string document = CreateDocument(itemCount);
+		PrintFormat("Benchmark type discriminator document with %1 items, %2 KB.", itemCount, document.Length() / 1024);
+
+		string movedIn, movedOut;
+		EDF_DbBenchmarkResult moveIn = Begin(EDF_WebProxyDbDriverTypeDiscriminator, "MoveIn", itemCount);
+		for (int nRound = 0; nRound < ROUNDS; nRound++)
+		{
+			movedIn = EDF_WebProxyDbDriverTypeDiscriminator.MoveIn(document);
+			moveIn.Record(EDF_EDbOperationStatusCode.SUCCESS, 1);
+		}
+
+		Finish(moveIn);
+
+		EDF_DbBenchmarkResult moveOut = Begin(EDF_WebProxyDbDriverTypeDiscriminator, "MoveOut", itemCount);
+		for (int nRound = 0; nRound < ROUNDS; nRound++)
+		{
+			movedOut = EDF_WebProxyDbDriverTypeDiscriminator.MoveOut(movedIn);
+			moveOut.Record(EDF_EDbOperationStatusCode.SUCCESS, 1);
+		}
+
+		Finish(moveOut);
+
+		return movedIn != document && movedOut == document;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Inventory with discriminators in front of the members holding the items, the way the game serializes them.
+	//! Strings contain escaped quotes, braces and discriminator look-alikes that must stay untouched.
+	protected static string CreateDocument(int itemCount)
+	{
+		array<string> chunks();
+		string chunk;
+		for (int nItem = 0; nItem < itemCount; nItem++)
+		{
+			if (nItem > 0)
+				chunk += ",";
+
+			chunk += string.Format("{\"_type\":\"EDF_Test_PayloadItem%1\",\"m_pItem\":{\"m_sName\":\"Item %2\",\"m_sNote\":\"says \\\"_type\\\":\\\"Fake\\\", {[\",", nItem % 4, nItem);
+			chunk += string.Format("\"m_iQuantity\":%1,\"_type\":\"EDF_Test_PayloadAttachment\",\"m_pAttachment\":{\"m_iSlot\":%2,\"m_sPath\":\"C:\\\\mods\\\\\"}}}", nItem % 60, nItem % 4);
+
+			if ((nItem + 1) % ITEMS_PER_CHUNK == 0)
+			{
+				chunks.Insert(chunk);
+				chunk = string.Empty;
+			}
+		}
+
+		string document = "{\"_type\":\"EDF_Test_PayloadInventory\",\"_id\":\"00000000-0000-0049-0000-000000000001\",\"m_aItems\":[";
+		foreach (string fullChunk : chunks)
+		{
+			document += fullChunk;
+		}
+
+		return document + chunk + "]}";
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyPayloadBenchmarks")]
+TestResultBase EDF_Test_WebProxyPayloadBenchmark_TypeDiscriminator_1kItems_RoundTrips()
+{
+	if (!EDF_DbBenchmark.IsEnabled(1000))
+		return new EDF_TestResult(true);
+
+	return new EDF_TestResult(EDF_WebProxyPayloadBenchmark.Run(1000));
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyPayloadBenchmarks")]
+TestResultBase EDF_Test_WebProxyPayloadBenchmark_TypeDiscriminator_10kItems_RoundTrips()
+{
+	if (!EDF_DbBenchmark.IsEnabled(10000))
+		return new EDF_TestResult(true);
+
+	return new EDF_TestResult(EDF_WebProxyPayloadBenchmark.Run(10000));
+};
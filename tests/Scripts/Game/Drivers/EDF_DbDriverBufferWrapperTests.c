@@ -1,4 +1,3 @@
-/*
 class EDF_DbDriverBufferWrapperTests : TestSuite
 {
 	//------------------------------------------------------------------------------------------------
@@ -28,6 +27,32 @@ class EDF_Test_DbDriverBufferWrapperEntity : EDF_DbEntity
 	}
 };
 
+//! Runs the flush tick on demand instead of once per frame
+class EDF_Test_DbDriverBufferWrapper : EDF_DbDriverBufferWrapper
+{
+	//------------------------------------------------------------------------------------------------
+	void RunFlushTick()
+	{
+		FlushTick();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_Test_DbDriverBufferWrapper(notnull EDF_DbDriver driver)
+	{
+	}
+};
+
+class EDF_Test_DbDriverBufferWrapperFindCallback : EDF_DbFindCallbackBase
+{
+	ref array<ref EDF_DbEntity> m_aResults;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		m_aResults = findResults;
+	}
+};
+
 //------------------------------------------------------------------------------------------------
 [Test("EDF_DbDriverBufferWrapperTests")]
 TestResultBase EDF_Test_DbDriverBufferWrapper_AddOrUpdateFindById_NotFlushed_Returned()
@@ -36,7 +61,7 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_AddOrUpdateFindById_NotFlushed_Ret
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 42);
@@ -66,7 +91,7 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_AddOrUpdateInPlaceTwice_Flushed_Re
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 42);
@@ -102,7 +127,7 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_AddOrUpdateFindAllLimited_NotFlush
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity1 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 42);
@@ -141,7 +166,7 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_AddOrUpdateFindMultipleByIdDesc_No
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity1 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 42);
@@ -185,7 +210,7 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_AddRemove_NotFlushed_NotRetured()
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 42);
@@ -213,7 +238,7 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_AddRemove_Flushed_NotRetured()
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 42);
@@ -242,7 +267,7 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_AddFlushRemove_NotFlushed_NotRetur
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 42);
@@ -272,50 +297,110 @@ TestResultBase EDF_Test_DbDriverBufferWrapper_FindAllPaginatedOrdered_HalfFlushe
 	EDF_InMemoryDbDriver driver();
 	EDF_InMemoryDbConnectionInfo connectInfo();
 	connectInfo.m_sDatabaseName = "Testing";
-	driver.initialize(connectInfo);
+	driver.Initialize(connectInfo);
 	EDF_DbDriverBufferWrapper bufferedDriver(driver);
 
 	auto entity1 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000001", 11);
 	auto entity2 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000002", 22);
-	auto entity3 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000003", 33); // Deleted, Not flushed
-	auto entity4 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000004", 44); // Deleted, Not flushed
-	auto entity5 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000005", 55);
-	auto entity6 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000006", 66);
+	auto entity3 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000003", 33); // Not flushed
+	auto entity4 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000004", 44); // Not flushed
+	auto entity5 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000005", 55); // Removed, Not flushed
+	auto entity6 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000006", 66); // Updated to 10, Not flushed
 	auto entity7 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000007", 77);
-	auto entity8 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000008", 88); //Not flushed
-	auto entity9 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000009", 99); //Not flushed
+	auto entity8 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000008", 88); // Not flushed
+	auto entity9 = EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0001-0000-000000000009", 99); // Not flushed
 
-	// Act
 	bufferedDriver.AddOrUpdate(entity1);
 	bufferedDriver.AddOrUpdate(entity2);
-	//bufferedDriver.AddOrUpdate(entity3);
-	//bufferedDriver.AddOrUpdate(entity4);
 	bufferedDriver.AddOrUpdate(entity5);
 	bufferedDriver.AddOrUpdate(entity6);
 	bufferedDriver.AddOrUpdate(entity7);
 	bufferedDriver.Flush(forceBlocking: true);
-	//bufferedDriver.Remove(EDF_Test_DbDriverBufferWrapperEntity, entity3.GetId());
-	//bufferedDriver.Remove(EDF_Test_DbDriverBufferWrapperEntity, entity4.GetId());
+
 	bufferedDriver.AddOrUpdate(entity3);
 	bufferedDriver.AddOrUpdate(entity4);
+	bufferedDriver.Remove(EDF_Test_DbDriverBufferWrapperEntity, entity5.GetId());
+	bufferedDriver.AddOrUpdate(EDF_Test_DbDriverBufferWrapperEntity.Create(entity6.GetId(), 10));
 	bufferedDriver.AddOrUpdate(entity8);
 	bufferedDriver.AddOrUpdate(entity9);
 
+	array<ref TStringArray> orderBy = {{"m_iValue", EDF_EDbEntitySortDirection.ASCENDING}};
+
+	// Act
+	array<ref EDF_DbEntity> page1 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, null, orderBy, offset: 0, limit: 3).GetEntities();
+	array<ref EDF_DbEntity> page2 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, null, orderBy, offset: 3, limit: 3).GetEntities();
+	array<ref EDF_DbEntity> page3 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, null, orderBy, offset: 6, limit: 3).GetEntities();
+
 	// Assert
+	if (page1.Count() != 3 || page2.Count() != 3 || page3.Count() != 2)
+		return new EDF_TestResult(false);
 
-	EDF_DbFindCondition condition = null; //EDF_DbFind.Id().Equals(entity.GetId())
-	array<ref TStringArray> orderBy = {{"m_iValue", EDF_EDbEntitySortDirection.ASCENDING}}; //null;
+	return new EDF_TestResult(
+		page1.Get(0).GetId() == entity6.GetId() &&
+		page1.Get(1).GetId() == entity1.GetId() &&
+		page1.Get(2).GetId() == entity2.GetId() &&
+		page2.Get(0).GetId() == entity3.GetId() &&
+		page2.Get(1).GetId() == entity4.GetId() &&
+		page2.Get(2).GetId() == entity7.GetId() &&
+		page3.Get(0).GetId() == entity8.GetId() &&
+		page3.Get(1).GetId() == entity9.GetId());
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverBufferWrapperTests")]
+TestResultBase EDF_Test_DbDriverBufferWrapper_FindAllAsync_AddedWhileInFlight_MergedWithSendTimeState()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://BufferFindTesting?inner=InMemory&latency=60000");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	driver.AddOrUpdate(EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0033-0000-000000000001", 1));
+	EDF_DbDriverBufferWrapper bufferedDriver(driver);
+	bufferedDriver.AddOrUpdate(EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0033-0000-000000000002", 2));
+	EDF_Test_DbDriverBufferWrapperFindCallback callback();
 
-	array<ref EDF_DbEntity> page1 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 0, limit: 3).GetEntities();
-	array<ref EDF_DbEntity> page2 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 3, limit: 3).GetEntities();
-	array<ref EDF_DbEntity> page3 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 6, limit: 3).GetEntities();
+	// Act
+	bufferedDriver.FindAllAsync(EDF_Test_DbDriverBufferWrapperEntity, callback: callback);
+	bufferedDriver.AddOrUpdate(EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0033-0000-000000000003", 3));
+	driver.CompleteAll();
 
-	//array<ref EDF_DbEntity> page1 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 0, limit: 2).GetEntities();
-	//array<ref EDF_DbEntity> page2 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 2, limit: 2).GetEntities();
-	//array<ref EDF_DbEntity> page3 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 4, limit: 2).GetEntities();
-	//array<ref EDF_DbEntity> page4 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 6, limit: 2).GetEntities();
-	//array<ref EDF_DbEntity> page5 = bufferedDriver.FindAll(EDF_Test_DbDriverBufferWrapperEntity, condition, orderBy, offset: 8, limit: 2).GetEntities();
+	// Assert
+	return new EDF_TestResult(
+		callback.m_aResults &&
+		callback.m_aResults.Count() == 2);
+};
 
-	return new EDF_TestResult(true);
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverBufferWrapperTests")]
+TestResultBase EDF_Test_DbDriverBufferWrapper_Flush_WhileFlushing_SentAfterConfirmation()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://BufferFlushTesting?inner=InMemory&latency=60000");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	EDF_Test_DbDriverBufferWrapper bufferedDriver(driver);
+
+	bufferedDriver.AddOrUpdate(EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0033-0000-000000000004", 4));
+	bufferedDriver.Flush();
+	bufferedDriver.RunFlushTick();
+
+	// Act
+	bufferedDriver.AddOrUpdate(EDF_Test_DbDriverBufferWrapperEntity.Create("TEST0000-0000-0033-0000-000000000005", 5));
+	bufferedDriver.Flush();
+	bufferedDriver.RunFlushTick();
+	int sentBeforeConfirmation = driver.GetPendingCount();
+
+	driver.CompleteAll();
+	bufferedDriver.RunFlushTick();
+	int sentAfterConfirmation = driver.GetPendingCount();
+
+	driver.CompleteAll();
+
+	// Assert
+	return new EDF_TestResult(
+		sentBeforeConfirmation == 1 &&
+		sentAfterConfirmation == 1 &&
+		!bufferedDriver.IsFlushing() &&
+		bufferedDriver.GetPendingCount() == 0 &&
+		driver.Count(EDF_Test_DbDriverBufferWrapperEntity).GetCount() == 2);
 };
-*/
@@ -0,0 +1,152 @@
+class EDF_DbDriverSingleFlightWrapperTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_DbDriverSingleFlightWrapperEntity : EDF_DbEntity
+{
+	int m_iValue;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_Test_DbDriverSingleFlightWrapperEntity Create(string id, int value)
+	{
+		EDF_Test_DbDriverSingleFlightWrapperEntity instance();
+		instance.SetId(id);
+		instance.m_iValue = value;
+		return instance;
+	}
+};
+
+class EDF_Test_DbDriverSingleFlightWrapperCallback : EDF_DbFindCallbackBase
+{
+	ref array<ref EDF_DbEntity> m_aResults;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		m_aResults = findResults;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverSingleFlightWrapperTests")]
+TestResultBase EDF_Test_DbDriverSingleFlightWrapper_FindAllAsync_IdenticalInFlight_SharedWithCopies()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://SingleFlightTesting?inner=InMemory&latency=60000");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	driver.AddOrUpdate(EDF_Test_DbDriverSingleFlightWrapperEntity.Create("TEST0000-0000-0047-0000-000000000001", 1));
+	EDF_DbDriverSingleFlightWrapper singleFlightDriver(driver);
+
+	EDF_Test_DbDriverSingleFlightWrapperCallback first();
+	EDF_Test_DbDriverSingleFlightWrapperCallback second();
+	EDF_Test_DbDriverSingleFlightWrapperCallback other();
+
+	// Act
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, EDF_DbFind.Field("m_iValue").Equals(1), callback: first);
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, EDF_DbFind.Field("m_iValue").Equals(1), callback: second);
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, EDF_DbFind.Field("m_iValue").Equals(2), callback: other);
+	int pending = driver.GetPendingCount();
+	driver.CompleteAll();
+
+	// Assert
+	return new EDF_TestResult(
+		pending == 2 &&
+		first.m_aResults.Count() == 1 &&
+		second.m_aResults.Count() == 1 &&
+		first.m_aResults.Get(0) != second.m_aResults.Get(0) &&
+		second.m_aResults.Get(0).GetId() == "TEST0000-0000-0047-0000-000000000001" &&
+		other.m_aResults.IsEmpty() &&
+		singleFlightDriver.GetInFlightCount(EDF_Test_DbDriverSingleFlightWrapperEntity) == 0);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverSingleFlightWrapperTests")]
+TestResultBase EDF_Test_DbDriverSingleFlightWrapper_FindAllAsync_WriteInBetween_NotShared()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://SingleFlightTesting?inner=InMemory&latency=60000");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	EDF_DbDriverSingleFlightWrapper singleFlightDriver(driver);
+
+	// Act
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, callback: new EDF_Test_DbDriverSingleFlightWrapperCallback());
+	singleFlightDriver.AddOrUpdate(EDF_Test_DbDriverSingleFlightWrapperEntity.Create("TEST0000-0000-0047-0000-000000000002", 2));
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, callback: new EDF_Test_DbDriverSingleFlightWrapperCallback());
+	int pending = driver.GetPendingCount();
+	driver.CompleteAll();
+
+	// Assert
+	return new EDF_TestResult(pending == 2);
+};
+
+//! Keeps find callbacks pending without holding on to the conditions, so only the wrapper keeps them alive
+class EDF_Test_DbDriverSingleFlightWrapperPendingDriver : EDF_DbDriver
+{
+	ref array<ref EDF_DbFindCallbackBase> m_aPending = {};
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		m_aPending.Insert(callback);
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverSingleFlightWrapperTests")]
+TestResultBase EDF_Test_DbDriverSingleFlightWrapper_FindAllAsync_ConditionDroppedByCaller_NotSharedWithUnconditional()
+{
+	// Arrange
+	EDF_Test_DbDriverSingleFlightWrapperPendingDriver driver();
+	EDF_DbDriverSingleFlightWrapper singleFlightDriver(driver);
+
+	EDF_DbFindCondition condition = EDF_DbFind.Field("m_iValue").Equals(1);
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, condition, callback: new EDF_Test_DbDriverSingleFlightWrapperCallback());
+	condition = null;
+
+	// Act
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, callback: new EDF_Test_DbDriverSingleFlightWrapperCallback());
+
+	// Assert
+	return new EDF_TestResult(
+		driver.m_aPending.Count() == 2 &&
+		singleFlightDriver.GetInFlightCount(EDF_Test_DbDriverSingleFlightWrapperEntity) == 2);
+};
+
+class EDF_Test_DbDriverSingleFlightWrapperChunkedCallback : EDF_DbFindCallbackChunked
+{
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbDriverSingleFlightWrapperTests")]
+TestResultBase EDF_Test_DbDriverSingleFlightWrapper_FindAllAsync_ChunkedCallback_PassedToDriver()
+{
+	// Arrange
+	EDF_Test_DbDriverSingleFlightWrapperPendingDriver driver();
+	EDF_DbDriverSingleFlightWrapper singleFlightDriver(driver);
+	EDF_Test_DbDriverSingleFlightWrapperChunkedCallback first();
+	EDF_Test_DbDriverSingleFlightWrapperChunkedCallback second();
+
+	// Act
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, callback: first);
+	singleFlightDriver.FindAllAsync(EDF_Test_DbDriverSingleFlightWrapperEntity, callback: second);
+
+	// Assert
+	return new EDF_TestResult(
+		driver.m_aPending.Count() == 2 &&
+		driver.m_aPending.Get(0) == first &&
+		driver.m_aPending.Get(1) == second &&
+		singleFlightDriver.GetInFlightCount(EDF_Test_DbDriverSingleFlightWrapperEntity) == 0);
+};
@@ -0,0 +1,62 @@
+class EDF_DbFlushSchedulerTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_DbFlushSchedulerEntityA : EDF_DbEntity
+{
+};
+
+class EDF_Test_DbFlushSchedulerEntityB : EDF_DbEntity
+{
+};
+
+class EDF_Test_DbFlushSchedulerEntityC : EDF_DbEntity
+{
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbFlushSchedulerTests")]
+TestResultBase EDF_Test_DbFlushScheduler_SortByPriority_MixedPriorities_HighestFirstStable()
+{
+	// Arrange
+	EDF_DbFlushScheduler scheduler();
+	scheduler.SetPriority(EDF_Test_DbFlushSchedulerEntityC, 10);
+	array<typename> entityTypes = {EDF_Test_DbFlushSchedulerEntityA, EDF_Test_DbFlushSchedulerEntityB, EDF_Test_DbFlushSchedulerEntityC};
+
+	// Act
+	scheduler.SortByPriority(entityTypes);
+
+	// Assert
+	return new EDF_TestResult(
+		entityTypes.Get(0) == EDF_Test_DbFlushSchedulerEntityC &&
+		entityTypes.Get(1) == EDF_Test_DbFlushSchedulerEntityA &&
+		entityTypes.Get(2) == EDF_Test_DbFlushSchedulerEntityB);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbFlushSchedulerTests")]
+TestResultBase EDF_Test_DbFlushScheduler_GetBatchSize_SlowBatches_ShrinksToBudget()
+{
+	// Arrange
+	EDF_DbFlushScheduler scheduler();
+	scheduler.SetFrameBudget(4);
+	scheduler.SetBatchSizeLimits(1, 100);
+
+	// Act
+	int initialBatchSize = scheduler.GetBatchSize(4);
+	scheduler.ReportBatch(10, 20); // 2ms per entity
+
+	// Assert
+	return new EDF_TestResult(initialBatchSize == 10 && scheduler.GetBatchSize(4) == 2);
+};
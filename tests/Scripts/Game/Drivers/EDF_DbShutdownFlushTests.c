@@ -0,0 +1,177 @@
+class EDF_DbShutdownFlushTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+//! Driver holding back a number of writes, each drain call passes on up to one batch of them
+class EDF_Test_DbShutdownFlushDriver : EDF_DbDriver
+{
+	int m_iPending;
+	int m_iDrainCalls;
+	int m_iHardFlushCalls;
+	int m_iHardFlushPending = -1;
+
+	//------------------------------------------------------------------------------------------------
+	override int GetShutdownPendingCount()
+	{
+		return m_iPending;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void DrainShutdown(int maxConcurrency, int batchSize)
+	{
+		m_iDrainCalls++;
+		m_iPending = Math.Max(m_iPending - batchSize, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void HardFlushShutdown()
+	{
+		m_iHardFlushCalls++;
+		m_iHardFlushPending = m_iPending;
+		m_iPending = 0;
+	}
+};
+
+//! Runs the drain ticks by hand and restores the static settings after a test
+class EDF_Test_DbShutdownFlush : EDF_DbShutdownFlush
+{
+	protected static int s_iPreviousDeadlineMs;
+	protected static int s_iPreviousBatchSize;
+
+	int m_iCompleted;
+	int m_iTotal;
+	bool m_bFinished;
+
+	//------------------------------------------------------------------------------------------------
+	static void RunTick()
+	{
+		Tick();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void OnProgress(int completed, int total, bool finished)
+	{
+		m_iCompleted = completed;
+		m_iTotal = total;
+		m_bFinished = finished;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Arrange(notnull EDF_DbDriver driver, int batchSize)
+	{
+		s_iPreviousDeadlineMs = s_iDeadlineMs;
+		s_iPreviousBatchSize = s_iBatchSize;
+		s_iDeadlineMs = 60000;
+		s_iBatchSize = batchSize;
+		EDF_DbDriver.s_bForceBlocking = false;
+
+		Register(driver);
+		s_OnProgress.Insert(OnProgress);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Cleanup(notnull EDF_DbDriver driver)
+	{
+		Finish();
+		s_OnProgress.Remove(OnProgress);
+		Unregister(driver);
+
+		s_iDeadlineMs = s_iPreviousDeadlineMs;
+		s_iBatchSize = s_iPreviousBatchSize;
+		EDF_DbDriver.s_bForceBlocking = false;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbShutdownFlushTests")]
+TestResultBase EDF_Test_DbShutdownFlush_Finish_PendingWrites_HardFlushedAndTotalReported()
+{
+	// Arrange
+	EDF_Test_DbShutdownFlushDriver driver();
+	driver.m_iPending = 5;
+	EDF_Test_DbShutdownFlush flush();
+	flush.Arrange(driver, 100);
+
+	// Act
+	EDF_DbShutdownFlush.Begin();
+	bool wasDraining = EDF_DbShutdownFlush.IsDraining();
+	EDF_DbShutdownFlush.Finish();
+	bool forcedBlocking = EDF_DbDriver.s_bForceBlocking;
+	flush.Cleanup(driver);
+
+	// Assert
+	return new EDF_TestResult(
+		wasDraining &&
+		forcedBlocking &&
+		driver.m_iHardFlushCalls == 1 &&
+		driver.m_iHardFlushPending == 5 &&
+		flush.m_bFinished &&
+		flush.m_iTotal == 5 &&
+		flush.m_iCompleted == 5);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbShutdownFlushTests")]
+TestResultBase EDF_Test_DbShutdownFlush_Tick_DrainedInBatches_NothingLeftForHardFlush()
+{
+	// Arrange
+	EDF_Test_DbShutdownFlushDriver driver();
+	driver.m_iPending = 3;
+	EDF_Test_DbShutdownFlush flush();
+	flush.Arrange(driver, 2);
+	EDF_DbShutdownFlush.Begin();
+
+	// Act
+	EDF_Test_DbShutdownFlush.RunTick();
+	EDF_Test_DbShutdownFlush.RunTick();
+	bool drainingBeforeLastTick = EDF_DbShutdownFlush.IsDraining();
+	EDF_Test_DbShutdownFlush.RunTick();
+	bool drainingAfterLastTick = EDF_DbShutdownFlush.IsDraining();
+	flush.Cleanup(driver);
+
+	// Assert
+	return new EDF_TestResult(
+		drainingBeforeLastTick &&
+		!drainingAfterLastTick &&
+		driver.m_iDrainCalls == 2 &&
+		driver.m_iHardFlushPending == 0 &&
+		flush.m_bFinished &&
+		flush.m_iTotal == 3);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbShutdownFlushTests")]
+TestResultBase EDF_Test_DbShutdownFlush_Tick_DeadlinePassed_RemainingWrittenBlocking()
+{
+	// Arrange
+	EDF_Test_DbShutdownFlushDriver driver();
+	driver.m_iPending = 5;
+	EDF_Test_DbShutdownFlush flush();
+	flush.Arrange(driver, 2);
+	EDF_DbShutdownFlush.Begin();
+
+	// Act
+	EDF_DbShutdownFlush.s_iDeadlineMs = 0; // Passed as soon as it is checked
+	EDF_Test_DbShutdownFlush.RunTick();
+	bool draining = EDF_DbShutdownFlush.IsDraining();
+	bool forcedBlocking = EDF_DbDriver.s_bForceBlocking;
+	flush.Cleanup(driver);
+
+	// Assert
+	return new EDF_TestResult(
+		!draining &&
+		forcedBlocking &&
+		driver.m_iDrainCalls == 0 &&
+		driver.m_iHardFlushPending == 5);
+};
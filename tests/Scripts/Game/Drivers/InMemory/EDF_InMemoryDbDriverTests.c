@@ -83,3 +83,252 @@ TestResultBase EDF_Test_InMemoryDbDriver_Remove_ExistingId_Removed()
 	return new EDF_TestResult(results.Count() == 0);
 }
 
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_Count_FieldCondition_MatchesCounted()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000003", 1.0, "A"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000004", 2.0, "B"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000005", 3.0, "B"));
+
+	// Act
+	EDF_DbCountResult all = driver.Count(EDF_Test_InMemoryDbDriverEntity);
+	EDF_DbCountResult byField = driver.Count(EDF_Test_InMemoryDbDriverEntity, EDF_DbFind.Field("m_sStringValue").Equals("B"));
+	EDF_DbCountResult byId = driver.Count(EDF_Test_InMemoryDbDriverEntity, EDF_DbFind.Id().EqualsAnyOf({"TEST0000-0000-0001-0000-000000000003", "TEST0000-0000-0001-0000-000000000099"}));
+
+	// Assert
+	return new EDF_TestResult(
+		all.IsSuccess() && all.GetCount() == 3 &&
+		byField.IsSuccess() && byField.GetCount() == 2 &&
+		byId.IsSuccess() && byId.GetCount() == 1);
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_Count_OrOfNotEqualIds_SameAsFindAll()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000031", 1.0, "A"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000032", 2.0, "B"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000033", 3.0, "C"));
+
+	// Every entity differs from at least one of the two ids
+	EDF_DbFindCondition condition = EDF_DbFind.Or({
+		EDF_DbFind.Id().Not().Equals("TEST0000-0000-0001-0000-000000000031"),
+		EDF_DbFind.Id().Not().Equals("TEST0000-0000-0001-0000-000000000032")
+	});
+
+	// Act
+	EDF_DbCountResult count = driver.Count(EDF_Test_InMemoryDbDriverEntity, condition);
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_InMemoryDbDriverEntity, condition).GetEntities();
+
+	// Assert
+	return new EDF_TestResult(count.IsSuccess() && count.GetCount() == results.Count() && results.Count() == 3);
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_Exists_MatchAndNoMatch_Correct()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000006", 42.42, "Hello World"));
+
+	// Act
+	EDF_DbExistsResult match = driver.Exists(EDF_Test_InMemoryDbDriverEntity, EDF_DbFind.Field("m_fFloatValue").GreaterThan(40.0));
+	EDF_DbExistsResult noMatch = driver.Exists(EDF_Test_InMemoryDbDriverEntity, EDF_DbFind.Field("m_sStringValue").Equals("Goodbye"));
+
+	// Assert
+	return new EDF_TestResult(
+		match.IsSuccess() && match.Exists() &&
+		noMatch.IsSuccess() && !noMatch.Exists());
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_Aggregate_GroupedSumAvg_Computed()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000007", 1.0, "A"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000008", 2.0, "B"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000009", 4.0, "B"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000010", 100.0, "C"));
+
+	EDF_DbAggregation aggregation = EDF_DbAggregation.Create().GroupBy("m_sStringValue").Count().Sum("m_fFloatValue", "sum").Avg("m_fFloatValue", "avg");
+
+	// Act
+	EDF_DbAggregateResult result = driver.Aggregate(EDF_Test_InMemoryDbDriverEntity, aggregation, EDF_DbFind.Field("m_fFloatValue").LessThan(50.0));
+
+	// Assert
+	if (!result.IsSuccess() || result.GetGroups().Count() != 2)
+		return new EDF_TestResult(false);
+
+	EDF_DbAggregateGroup groupB = result.GetGroup("B");
+	return new EDF_TestResult(
+		groupB &&
+		groupB.Get("count") == 2 &&
+		float.AlmostEqual(groupB.Get("sum"), 6.0) &&
+		float.AlmostEqual(groupB.Get("avg"), 3.0) &&
+		!result.GetGroup("C"));
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_Aggregate_NonNumericSum_DataMalformed()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000034", 1.0, "A"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000035", 2.0, "B"));
+
+	// Act
+	EDF_DbAggregateResult nonNumeric = driver.Aggregate(EDF_Test_InMemoryDbDriverEntity, EDF_DbAggregation.Create().Sum("m_sStringValue"));
+	EDF_DbAggregateResult unknown = driver.Aggregate(EDF_Test_InMemoryDbDriverEntity, EDF_DbAggregation.Create().GroupBy("m_sMissing").Count());
+
+	// Assert
+	return new EDF_TestResult(
+		nonNumeric.GetStatusCode() == EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED &&
+		unknown.GetStatusCode() == EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED);
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_AddOrUpdateManyRemoveMany_Batch_Applied()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	array<ref EDF_DbEntity> entities = {
+		new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000011", 1.0, "A"),
+		new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000012", 2.0, "B"),
+		new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000013", 3.0, "C")
+	};
+
+	// Act
+	EDF_EDbOperationStatusCode addStatusCode = driver.AddOrUpdateMany(entities);
+	EDF_EDbOperationStatusCode removeStatusCode = driver.RemoveMany(EDF_Test_InMemoryDbDriverEntity, {"TEST0000-0000-0001-0000-000000000011", "TEST0000-0000-0001-0000-000000000099"});
+
+	// Assert
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_InMemoryDbDriverEntity).GetEntities();
+
+	return new EDF_TestResult(
+		addStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		removeStatusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND &&
+		results.Count() == 2);
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_RemoveWhere_FieldCondition_OnlyMatchesRemoved()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000014", 1.0, "Expired"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000015", 2.0, "Active"));
+	driver.AddOrUpdate(new EDF_Test_InMemoryDbDriverEntity("TEST0000-0000-0001-0000-000000000016", 3.0, "Expired"));
+
+	// Act
+	EDF_EDbOperationStatusCode statusCode = driver.RemoveWhere(EDF_Test_InMemoryDbDriverEntity, EDF_DbFind.Field("m_sStringValue").Equals("Expired"));
+
+	// Assert
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_InMemoryDbDriverEntity).GetEntities();
+
+	return new EDF_TestResult(
+		statusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		results.Count() == 1 &&
+		results.Get(0).GetId() == "TEST0000-0000-0001-0000-000000000015");
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_Patch_ValidAndInvalidFields_OnlyValidApplied()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	EDF_Test_InMemoryDbDriverEntity entity("TEST0000-0000-0001-0000-000000000017", 1.0, "Before");
+	driver.AddOrUpdate(entity);
+
+	// Act
+	EDF_EDbOperationStatusCode validStatusCode = driver.Patch(EDF_Test_InMemoryDbDriverEntity, entity.GetId(), EDF_DbPatch.Create().Set("m_fFloatValue", 2.5).Set("m_sStringValue", "After"));
+	EDF_EDbOperationStatusCode invalidStatusCode = driver.Patch(EDF_Test_InMemoryDbDriverEntity, entity.GetId(), EDF_DbPatch.Create().Set("m_sStringValue", "Ignored").Set("m_iUnknownField", 1));
+
+	// Assert
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_InMemoryDbDriverEntity, EDF_DbFind.Id().Equals(entity.GetId())).GetEntities();
+	if (results.Count() != 1) return new EDF_TestResult(false);
+
+	EDF_Test_InMemoryDbDriverEntity resultEntity = EDF_Test_InMemoryDbDriverEntity.Cast(results.Get(0));
+
+	return new EDF_TestResult(
+		validStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		invalidStatusCode == EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED &&
+		resultEntity.m_fFloatValue == 2.5 &&
+		resultEntity.m_sStringValue == "After");
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_InMemoryDbDriverTests")]
+TestResultBase EDF_Test_InMemoryDbDriver_IncrementCompareAndSet_ExpectedValues_Applied()
+{
+	// Arrange
+	EDF_InMemoryDbDriver driver();
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "Testing";
+	driver.Initialize(connectInfo);
+
+	EDF_Test_InMemoryDbDriverEntity entity("TEST0000-0000-0001-0000-000000000018", 1.5, "Open");
+	driver.AddOrUpdate(entity);
+
+	// Act
+	EDF_EDbOperationStatusCode incrementStatusCode = driver.Increment(EDF_Test_InMemoryDbDriverEntity, entity.GetId(), "m_fFloatValue", 2.0);
+	EDF_EDbOperationStatusCode mismatchStatusCode = driver.CompareAndSet(EDF_Test_InMemoryDbDriverEntity, entity.GetId(), "m_sStringValue", "Closed", "Locked");
+	EDF_EDbOperationStatusCode matchStatusCode = driver.CompareAndSet(EDF_Test_InMemoryDbDriverEntity, entity.GetId(), "m_sStringValue", "Open", "Closed");
+
+	// Assert
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_InMemoryDbDriverEntity, EDF_DbFind.Id().Equals(entity.GetId())).GetEntities();
+	if (results.Count() != 1) return new EDF_TestResult(false);
+
+	EDF_Test_InMemoryDbDriverEntity resultEntity = EDF_Test_InMemoryDbDriverEntity.Cast(results.Get(0));
+
+	return new EDF_TestResult(
+		incrementStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		mismatchStatusCode == EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET &&
+		matchStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		resultEntity.m_fFloatValue == 3.5 &&
+		resultEntity.m_sStringValue == "Closed");
+}
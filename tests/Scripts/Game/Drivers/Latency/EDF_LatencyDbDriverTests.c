@@ -0,0 +1,301 @@
+class EDF_LatencyDbDriverTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_LatencyDbDriverEntity : EDF_DbEntity
+{
+	int m_iValue;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_Test_LatencyDbDriverEntity Create(string id, int value)
+	{
+		EDF_Test_LatencyDbDriverEntity instance();
+		instance.SetId(id);
+		instance.m_iValue = value;
+		return instance;
+	}
+};
+
+//! Exposes the sampling and runs the held back calls with their faults instead of waiting for the latency
+class EDF_Test_LatencyDbDriver : EDF_LatencyDbDriver
+{
+	//------------------------------------------------------------------------------------------------
+	int Sample()
+	{
+		return SampleLatency();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ExecuteInFlight()
+	{
+		GetGame().GetCallqueue().Remove(Execute);
+
+		array<ref EDF_LatencyDbCall> calls();
+		calls.InsertAll(m_aInFlight);
+		foreach (EDF_LatencyDbCall call : calls)
+		{
+			Execute(call);
+		}
+	}
+};
+
+class EDF_Test_LatencyDbDriverStatusCallback : EDF_DbOperationStatusOnlyCallback
+{
+	bool m_bInvoked;
+	EDF_EDbOperationStatusCode m_eStatusCode;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		m_bInvoked = true;
+		m_eStatusCode = EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		m_bInvoked = true;
+		m_eStatusCode = statusCode;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_AddOrUpdateAsync_ConcurrencyLimit_HeldBackUntilCompleted()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://LatencyTesting?inner=InMemory&latency=60000&concurrency=1");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	// Act
+	driver.AddOrUpdateAsync(EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0001-0000-000000000001", 1));
+	driver.AddOrUpdateAsync(EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0001-0000-000000000002", 2));
+
+	// Assert
+	int pendingBefore = driver.GetPendingCount();
+	int storedBefore = driver.Count(EDF_Test_LatencyDbDriverEntity).GetCount();
+
+	driver.CompleteAll();
+
+	return new EDF_TestResult(
+		pendingBefore == 2 &&
+		storedBefore == 0 &&
+		driver.GetPendingCount() == 0 &&
+		driver.Count(EDF_Test_LatencyDbDriverEntity).GetCount() == 2);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_AddOrUpdateAsync_ChangedWhileHeldBack_CallTimeStateStored()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://LatencySnapshotTesting?inner=InMemory&latency=60000");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	EDF_Test_LatencyDbDriverEntity single = EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0002-0000-000000000001", 1);
+	EDF_Test_LatencyDbDriverEntity many = EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0002-0000-000000000002", 2);
+
+	// Act
+	driver.AddOrUpdateAsync(single);
+	driver.AddOrUpdateManyAsync({many});
+	single.m_iValue = 10;
+	many.m_iValue = 20;
+	driver.CompleteAll();
+
+	// Assert
+	EDF_Test_LatencyDbDriverEntity storedSingle = EDF_Test_LatencyDbDriverEntity.Cast(driver.FindById(EDF_Test_LatencyDbDriverEntity, "TEST0000-0000-0002-0000-000000000001").GetEntity());
+	EDF_Test_LatencyDbDriverEntity storedMany = EDF_Test_LatencyDbDriverEntity.Cast(driver.FindById(EDF_Test_LatencyDbDriverEntity, "TEST0000-0000-0002-0000-000000000002").GetEntity());
+	return new EDF_TestResult(
+		storedSingle &&
+		storedSingle.m_iValue == 1 &&
+		storedMany &&
+		storedMany.m_iValue == 2);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_RemoveManyAndPatchAsync_ArgumentsChangedWhileHeldBack_CallTimeArgumentsUsed()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://LatencyArgumentsTesting?inner=InMemory&latency=60000");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	driver.AddOrUpdate(EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0005-0000-000000000001", 1));
+	driver.AddOrUpdate(EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0005-0000-000000000002", 2));
+
+	array<string> entityIds = {"TEST0000-0000-0005-0000-000000000001"};
+	EDF_DbPatch patch = EDF_DbPatch.Create().Set("m_iValue", 5);
+
+	// Act
+	driver.RemoveManyAsync(EDF_Test_LatencyDbDriverEntity, entityIds);
+	driver.PatchAsync(EDF_Test_LatencyDbDriverEntity, "TEST0000-0000-0005-0000-000000000002", patch);
+	entityIds.Set(0, "TEST0000-0000-0005-0000-000000000002");
+	patch.Increment("m_iValue", 10);
+	driver.CompleteAll();
+
+	// Assert
+	EDF_DbEntity removed = driver.FindById(EDF_Test_LatencyDbDriverEntity, "TEST0000-0000-0005-0000-000000000001").GetEntity();
+	EDF_Test_LatencyDbDriverEntity patched = EDF_Test_LatencyDbDriverEntity.Cast(driver.FindById(EDF_Test_LatencyDbDriverEntity, "TEST0000-0000-0005-0000-000000000002").GetEntity());
+	return new EDF_TestResult(
+		!removed &&
+		patched &&
+		patched.m_iValue == 5);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_HardFlushShutdown_HeldBackCalls_PassedOn()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://LatencyShutdownTesting?inner=InMemory&latency=60000");
+	EDF_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	driver.AddOrUpdateAsync(EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0006-0000-000000000001", 1));
+	int pendingBefore = driver.GetShutdownPendingCount();
+
+	// Act
+	driver.HardFlushShutdown();
+
+	// Assert
+	return new EDF_TestResult(
+		pendingBefore == 1 &&
+		driver.GetShutdownPendingCount() == 0 &&
+		driver.Count(EDF_Test_LatencyDbDriverEntity).GetCount() == 1);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_AddOrUpdateAsync_AllErrors_FailedNotApplied()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://LatencyErrorTesting?inner=InMemory&latency=60000&errors=1");
+	EDF_Test_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	EDF_Test_LatencyDbDriverStatusCallback callback();
+
+	// Act
+	driver.AddOrUpdateAsync(EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0003-0000-000000000001", 1), callback);
+	driver.ExecuteInFlight();
+
+	// Assert
+	return new EDF_TestResult(
+		callback.m_bInvoked &&
+		callback.m_eStatusCode == EDF_EDbOperationStatusCode.FAILURE_UNKNOWN &&
+		driver.GetPendingCount() == 0 &&
+		driver.Count(EDF_Test_LatencyDbDriverEntity).GetCount() == 0);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_AddOrUpdateAsync_AllTimeouts_UnavailableButApplied()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Latency://LatencyTimeoutTesting?inner=InMemory&latency=60000&timeouts=1");
+	EDF_Test_LatencyDbDriver driver();
+	driver.Initialize(connectInfo);
+	EDF_Test_LatencyDbDriverStatusCallback callback();
+
+	// Act
+	driver.AddOrUpdateAsync(EDF_Test_LatencyDbDriverEntity.Create("TEST0000-0000-0004-0000-000000000001", 1), callback);
+	driver.ExecuteInFlight();
+
+	// Assert
+	return new EDF_TestResult(
+		callback.m_bInvoked &&
+		callback.m_eStatusCode == EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE &&
+		driver.Count(EDF_Test_LatencyDbDriverEntity).GetCount() == 1);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_SampleLatency_Distributions_WithinBounds()
+{
+	// Arrange
+	EDF_Test_LatencyDbDriver constant();
+	constant.Initialize(EDF_DbConnectionInfoBase.Parse("Latency://LatencySampleTesting?inner=InMemory&latency=50&jitter=20&distribution=constant&seed=1"));
+	EDF_Test_LatencyDbDriver uniform();
+	uniform.Initialize(EDF_DbConnectionInfoBase.Parse("Latency://LatencySampleTesting?inner=InMemory&latency=50&jitter=20&distribution=uniform&seed=1"));
+	EDF_Test_LatencyDbDriver normal();
+	normal.Initialize(EDF_DbConnectionInfoBase.Parse("Latency://LatencySampleTesting?inner=InMemory&latency=50&jitter=5&distribution=normal&seed=1"));
+	EDF_Test_LatencyDbDriver exponential();
+	exponential.Initialize(EDF_DbConnectionInfoBase.Parse("Latency://LatencySampleTesting?inner=InMemory&latency=50&distribution=exponential&seed=1"));
+	EDF_Test_LatencyDbDriver spikes();
+	spikes.Initialize(EDF_DbConnectionInfoBase.Parse("Latency://LatencySampleTesting?inner=InMemory&latency=50&spikes=1&spikelatency=700&seed=1"));
+
+	// Act
+	int samples = 2000;
+	int constantOff, uniformOutOfRange, spikesOff, exponentialBelowMean;
+	float normalSum, exponentialSum;
+	for (int nSample = 0; nSample < samples; nSample++)
+	{
+		if (constant.Sample() != 50)
+			constantOff++;
+
+		int uniformLatency = uniform.Sample();
+		if (uniformLatency < 30 || uniformLatency > 70)
+			uniformOutOfRange++;
+
+		normalSum += normal.Sample();
+
+		int exponentialLatency = exponential.Sample();
+		exponentialSum += exponentialLatency;
+		if (exponentialLatency < 50)
+			exponentialBelowMean++;
+
+		if (spikes.Sample() != 700)
+			spikesOff++;
+	}
+
+	// Assert
+	float normalMean = normalSum / samples;
+	float exponentialMean = exponentialSum / samples;
+	return new EDF_TestResult(
+		constantOff == 0 &&
+		uniformOutOfRange == 0 &&
+		spikesOff == 0 &&
+		normalMean > 48 && normalMean < 52 &&
+		exponentialMean > 40 && exponentialMean < 60 &&
+		exponentialBelowMean > samples / 2); // Most calls are faster than the mean, about 63%
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_LatencyDbDriverTests")]
+TestResultBase EDF_Test_LatencyDbDriver_SampleLatency_SameSeed_SameSequence()
+{
+	// Arrange
+	string connectionString = "Latency://LatencySeedTesting?inner=InMemory&latency=50&jitter=40&seed=1234";
+	EDF_Test_LatencyDbDriver first();
+	first.Initialize(EDF_DbConnectionInfoBase.Parse(connectionString));
+	EDF_Test_LatencyDbDriver second();
+	second.Initialize(EDF_DbConnectionInfoBase.Parse(connectionString));
+	EDF_Test_LatencyDbDriver otherSeed();
+	otherSeed.Initialize(EDF_DbConnectionInfoBase.Parse("Latency://LatencySeedTesting?inner=InMemory&latency=50&jitter=40&seed=4321"));
+
+	// Act
+	int sameSeedDifferences, otherSeedDifferences;
+	for (int nSample = 0; nSample < 100; nSample++)
+	{
+		int latency = first.Sample();
+		if (latency != second.Sample())
+			sameSeedDifferences++;
+
+		if (latency != otherSeed.Sample())
+			otherSeedDifferences++;
+	}
+
+	// Assert
+	return new EDF_TestResult(sameSeedDifferences == 0 && otherSeedDifferences > 0);
+};
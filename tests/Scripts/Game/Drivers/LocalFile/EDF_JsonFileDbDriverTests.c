@@ -252,3 +252,45 @@ class EDF_Test_JsonFileDbDriver_FindAll_ContentField_AllLoadedAndCached : EDF_Te
 		EDF_JsonFileDbDriverTests.DeleteEntity(driver._GetTypeDirectory(EDF_Test_JsonFileDbDriverEntity), "TEST0000-0000-0001-0000-000000002005");
 	}
 }
+
+[Test("EDF_JsonFileDbDriverTests")]
+class EDF_Test_JsonFileDbDriver_RemoveWhere_AndOfTwoIds_NothingRemoved : EDF_Test_JsonFileDbDriver_TestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Arrange()
+	{
+		EDF_JsonFileDbConnectionInfo connectInfo();
+		connectInfo.m_sDatabaseName = EDF_JsonFileDbDriverTests.DB_NAME;
+		driver.Initialize(connectInfo);
+
+		EDF_JsonFileDbDriverTests.WriteEntity(driver._GetTypeDirectory(EDF_Test_JsonFileDbDriverEntity), new EDF_Test_JsonFileDbDriverEntity("TEST0000-0000-0001-0000-000000003001", 43.1, "Existing 3001"));
+		EDF_JsonFileDbDriverTests.WriteEntity(driver._GetTypeDirectory(EDF_Test_JsonFileDbDriverEntity), new EDF_Test_JsonFileDbDriverEntity("TEST0000-0000-0001-0000-000000003002", 43.2, "Existing 3002"));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void ActAndAsset()
+	{
+		// No entity has both ids
+		EDF_DbFindCondition condition = EDF_DbFind.And({
+			EDF_DbFind.Id().Equals("TEST0000-0000-0001-0000-000000003001"),
+			EDF_DbFind.Id().Equals("TEST0000-0000-0001-0000-000000003002")
+		});
+
+		// Act
+		EDF_EDbOperationStatusCode statusCode = driver.RemoveWhere(EDF_Test_JsonFileDbDriverEntity, condition);
+
+		// Assert
+		int remaining = driver.FindAll(EDF_Test_JsonFileDbDriverEntity).GetEntities().Count();
+		SetResult(new EDF_TestResult(statusCode == EDF_EDbOperationStatusCode.SUCCESS && remaining == 2));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void Cleanup()
+	{
+		EDF_JsonFileDbDriverTests.DeleteEntity(driver._GetTypeDirectory(EDF_Test_JsonFileDbDriverEntity), "TEST0000-0000-0001-0000-000000003001");
+		EDF_JsonFileDbDriverTests.DeleteEntity(driver._GetTypeDirectory(EDF_Test_JsonFileDbDriverEntity), "TEST0000-0000-0001-0000-000000003002");
+	}
+}
@@ -0,0 +1,41 @@
+class EDF_DbMetricsTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbMetricsTests")]
+TestResultBase EDF_Test_DbMetrics_Record_MixedLatencies_PercentileFromHistogram()
+{
+	// Arrange
+	EDF_DbOperationMetrics metrics();
+
+	// Act
+	for (int i = 0; i < 18; i++)
+	{
+		metrics.Record(EDF_EDbOperationStatusCode.SUCCESS, 3);
+	}
+
+	metrics.Record(EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE, 40);
+	metrics.Record(EDF_EDbOperationStatusCode.SUCCESS, 4000);
+
+	// Assert
+	return new EDF_TestResult(
+		metrics.m_iCount == 20 &&
+		metrics.m_iErrors == 1 &&
+		metrics.m_mErrorsByCode.Get(EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE) == 1 &&
+		metrics.GetLatencyPercentile(0.5) == 5 &&
+		metrics.GetLatencyPercentile(0.95) == 50 &&
+		metrics.GetLatencyPercentile(1) == 4000 &&
+		metrics.m_iMaxLatencyMs == 4000);
+};
@@ -0,0 +1,46 @@
+class EDF_NullDbDriverTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_NullDbDriverEntity : EDF_DbEntity
+{
+	int m_iValue;
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_NullDbDriverTests")]
+TestResultBase EDF_Test_NullDbDriver_FindAll_CannedResults_NothingStored()
+{
+	// Arrange
+	EDF_DbConnectionInfoBase connectInfo = EDF_DbConnectionInfoBase.Parse("Null://NullTesting?results=3&count=42");
+	EDF_NullDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	EDF_Test_NullDbDriverEntity entity();
+	entity.SetId("TEST0000-0000-0001-0000-000000000001");
+
+	// Act
+	EDF_EDbOperationStatusCode statusCode = driver.AddOrUpdate(entity);
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_NullDbDriverEntity, EDF_DbFind.Id().Equals(entity.GetId())).GetEntities();
+
+	// Assert
+	if (results.Count() != 3)
+		return new EDF_TestResult(false);
+
+	return new EDF_TestResult(
+		statusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		results.Get(0).GetId() != entity.GetId() &&
+		EDF_Test_NullDbDriverEntity.Cast(results.Get(0)) &&
+		driver.Count(EDF_Test_NullDbDriverEntity).GetCount() == 42);
+};
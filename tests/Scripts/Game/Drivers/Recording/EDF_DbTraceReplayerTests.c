@@ -0,0 +1,138 @@
+class EDF_DbTraceReplayerTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_TraceEntity : EDF_DbEntity
+{
+	int m_iLevel;
+	string m_sName;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_Test_TraceEntity Create(string id, int level, string name)
+	{
+		EDF_Test_TraceEntity instance();
+		instance.SetId(id);
+		instance.m_iLevel = level;
+		instance.m_sName = name;
+		return instance;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbTraceReplayerTests")]
+TestResultBase EDF_Test_DbTraceReplayer_Start_RecordsFromJson_ReplayedAgainstDriver()
+{
+	// Arrange
+	bool metricsEnabled = EDF_DbMetrics.IsEnabled();
+	EDF_DbMetrics.s_bEnabled = false;
+
+	EDF_InMemoryDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "TraceReplay";
+	EDF_InMemoryDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	EDF_DbTraceRecord insert();
+	insert.m_sOperation = "AddOrUpdateMany";
+	insert.m_sEntityType = "EDF_Test_TraceEntity";
+	insert.SetEntities({
+		EDF_Test_TraceEntity.Create("TEST0000-0000-0001-0000-000000000001", 5, "Low"),
+		EDF_Test_TraceEntity.Create("TEST0000-0000-0001-0000-000000000002", 50, "High")});
+
+	EDF_DbTraceRecord remove();
+	remove.m_iTime = 10;
+	remove.m_sOperation = "RemoveWhere";
+	remove.m_sEntityType = "EDF_Test_TraceEntity";
+	remove.m_pCondition = EDF_DbTraceCondition.From(EDF_DbFind.And({
+		EDF_DbFind.Field("m_iLevel").LessThan(10),
+		EDF_DbFind.Field("m_sName").Contains("o")}));
+
+	EDF_DbTraceReplayer replayer(driver);
+	replayer.AddRecord(EDF_DbTraceRecord.FromJson(remove.ToJson()));
+	replayer.AddRecord(EDF_DbTraceRecord.FromJson(insert.ToJson()));
+
+	// Act
+	replayer.Start();
+
+	// Assert
+	bool metricsRestored = !EDF_DbMetrics.s_bEnabled;
+	EDF_DbMetrics.s_bEnabled = metricsEnabled;
+
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_TraceEntity).GetEntities();
+	EDF_Test_TraceEntity remaining;
+	if (results.Count() == 1)
+		remaining = EDF_Test_TraceEntity.Cast(results.Get(0));
+
+	return new EDF_TestResult(
+		replayer.IsFinished() &&
+		metricsRestored &&
+		replayer.GetMetrics().Count() == 1 &&
+		remaining &&
+		remaining.m_sName == "High");
+};
+
+//! Keeps the find callback it receives, so the test can hand over the results in parts
+class EDF_Test_TracePendingDriver : EDF_DbDriver
+{
+	ref EDF_DbFindCallbackBase m_pCallback;
+
+	//------------------------------------------------------------------------------------------------
+	override void FindAllAsync(typename entityType, EDF_DbFindCondition condition = null, array<ref TStringArray> orderBy = null, int limit = -1, int offset = -1, EDF_DbFindCallbackBase callback = null)
+	{
+		m_pCallback = callback;
+	}
+};
+
+class EDF_Test_TraceChunkedCallback : EDF_DbFindCallbackChunked
+{
+	int m_iChunks;
+	int m_iCompleted;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnChunk(array<ref EDF_DbEntity> chunk, Managed context)
+	{
+		m_iChunks++;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnComplete(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		m_iCompleted++;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbTraceReplayerTests")]
+TestResultBase EDF_Test_DbDriverRecordingWrapper_FindAllAsync_ChunkedCallback_ChunksForwarded()
+{
+	// Arrange
+	EDF_Test_TracePendingDriver driver();
+	EDF_DbDriverRecordingWrapper recorder(driver, "$profile:EDF_DbTraceReplayerTests.trace");
+	EDF_Test_TraceChunkedCallback callback();
+	recorder.FindAllAsync(EDF_Test_TraceEntity, callback: callback);
+	auto chunkedCallback = EDF_DbFindCallbackChunked.Cast(driver.m_pCallback);
+
+	// Act
+	if (chunkedCallback)
+	{
+		chunkedCallback.InvokeChunk({EDF_Test_TraceEntity.Create("TEST0000-0000-0001-0000-000000000003", 1, "First")});
+		chunkedCallback.InvokeChunk({EDF_Test_TraceEntity.Create("TEST0000-0000-0001-0000-000000000004", 2, "Second")});
+		chunkedCallback.InvokeComplete(EDF_EDbOperationStatusCode.SUCCESS);
+	}
+
+	// Assert
+	return new EDF_TestResult(
+		chunkedCallback &&
+		callback.m_iChunks == 2 &&
+		callback.m_iCompleted == 1);
+};
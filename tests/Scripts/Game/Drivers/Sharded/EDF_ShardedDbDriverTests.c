@@ -0,0 +1,80 @@
+class EDF_ShardedDbDriverTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_ShardedDbDriverEntity : EDF_DbEntity
+{
+	int m_iValue;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_Test_ShardedDbDriverEntity Create(string id, int value)
+	{
+		EDF_Test_ShardedDbDriverEntity instance();
+		instance.SetId(id);
+		instance.m_iValue = value;
+		return instance;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_ShardedDbDriverTests")]
+TestResultBase EDF_Test_ShardedDbDriver_FindAllPaginatedOrdered_SpreadAcrossShards_CorrectPage()
+{
+	// Arrange
+	EDF_ShardedDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "ShardedTesting";
+	connectInfo.m_aShards = {new EDF_InMemoryDbConnectionInfo(), new EDF_InMemoryDbConnectionInfo(), new EDF_InMemoryDbConnectionInfo()};
+
+	EDF_ShardedDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	for (int nEntity = 1; nEntity <= 9; nEntity++)
+	{
+		driver.AddOrUpdate(EDF_Test_ShardedDbDriverEntity.Create(string.Format("TEST0000-0000-0001-0000-00000000000%1", nEntity), nEntity));
+	}
+
+	// Act
+	array<ref EDF_DbEntity> results = driver.FindAll(EDF_Test_ShardedDbDriverEntity, orderBy: {{"m_iValue", EDF_EDbEntitySortDirection.DESCENDING}}, limit: 3, offset: 2).GetEntities();
+
+	// Assert
+	if (results.Count() != 3)
+		return new EDF_TestResult(false);
+
+	return new EDF_TestResult(
+		EDF_Test_ShardedDbDriverEntity.Cast(results.Get(0)).m_iValue == 7 &&
+		EDF_Test_ShardedDbDriverEntity.Cast(results.Get(1)).m_iValue == 6 &&
+		EDF_Test_ShardedDbDriverEntity.Cast(results.Get(2)).m_iValue == 5 &&
+		driver.Count(EDF_Test_ShardedDbDriverEntity).GetCount() == 9);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_ShardedDbDriverTests")]
+TestResultBase EDF_Test_ShardedDbDriver_GetShardIndex_ByType_SameShardForAllIds()
+{
+	// Arrange
+	EDF_ShardedDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "ShardedTesting";
+	connectInfo.m_aShards = {new EDF_InMemoryDbConnectionInfo(), new EDF_InMemoryDbConnectionInfo(), new EDF_InMemoryDbConnectionInfo()};
+	connectInfo.m_eMode = EDF_EDbShardingMode.ENTITY_TYPE;
+
+	EDF_ShardedDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	// Act
+	int shardA = driver.GetShardIndex(EDF_Test_ShardedDbDriverEntity, "TEST0000-0000-0001-0000-000000000001");
+	int shardB = driver.GetShardIndex(EDF_Test_ShardedDbDriverEntity, "TEST0000-0000-0001-0000-000000000002");
+
+	// Assert
+	return new EDF_TestResult(shardA == shardB && shardA >= 0 && shardA < 3);
+};
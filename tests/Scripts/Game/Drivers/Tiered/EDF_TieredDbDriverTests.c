@@ -0,0 +1,153 @@
+class EDF_TieredDbDriverTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_TieredDbDriverEntity : EDF_DbEntity
+{
+	int m_iValue;
+
+	//------------------------------------------------------------------------------------------------
+	static EDF_Test_TieredDbDriverEntity Create(string id, int value)
+	{
+		EDF_Test_TieredDbDriverEntity instance();
+		instance.SetId(id);
+		instance.m_iValue = value;
+		return instance;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_TieredDbDriverTests")]
+TestResultBase EDF_Test_TieredDbDriver_ReadOptions_ColdOptions_PassedOn()
+{
+	// Arrange
+	EDF_TieredDbConnectionInfo connectInfo();
+
+	// Act
+	connectInfo.ReadOptions("Testing?cold=JsonFile&hotlimit=500&write=behind&pretty=true");
+
+	// Assert
+	EDF_JsonFileDbConnectionInfo coldConnectInfo = EDF_JsonFileDbConnectionInfo.Cast(connectInfo.m_pColdStorage);
+	return new EDF_TestResult(
+		connectInfo.m_sDatabaseName == "Testing" &&
+		connectInfo.m_iMaxHotEntities == 500 &&
+		connectInfo.m_bWriteBehind &&
+		coldConnectInfo &&
+		coldConnectInfo.m_sDatabaseName == "Testing" &&
+		coldConnectInfo.m_bPrettify);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_TieredDbDriverTests")]
+TestResultBase EDF_Test_TieredDbDriver_FindById_OverHotLimit_DemotedStillFound()
+{
+	// Arrange
+	EDF_InMemoryDbConnectionInfo coldConnectInfo();
+	coldConnectInfo.m_sDatabaseName = "TieredTesting";
+	EDF_TieredDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "TieredTesting";
+	connectInfo.m_pColdStorage = coldConnectInfo;
+	connectInfo.m_iMaxHotEntities = 2;
+
+	EDF_TieredDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0001-0000-000000000001", 1));
+	driver.AddOrUpdate(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0001-0000-000000000002", 2));
+	driver.AddOrUpdate(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0001-0000-000000000003", 3));
+	int hotCountAfterWrites = driver.GetHotCount();
+
+	// Act
+	EDF_Test_TieredDbDriverEntity demoted = EDF_Test_TieredDbDriverEntity.Cast(driver.FindById(EDF_Test_TieredDbDriverEntity, "TEST0000-0000-0001-0000-000000000001").GetEntity());
+
+	// Assert
+	return new EDF_TestResult(
+		hotCountAfterWrites == 2 &&
+		driver.GetHotCount() == 2 &&
+		demoted &&
+		demoted.m_iValue == 1);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_TieredDbDriverTests")]
+TestResultBase EDF_Test_TieredDbDriver_FindAll_PendingAsyncWrites_Overlaid()
+{
+	// Arrange
+	EDF_TieredDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "TieredPendingTesting";
+	connectInfo.m_pColdStorage = EDF_DbConnectionInfoBase.Parse("Latency://TieredPendingTesting?inner=InMemory&latency=60000");
+
+	EDF_TieredDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0002-0000-000000000001", 1));
+	driver.AddOrUpdate(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0002-0000-000000000002", 5));
+
+	// Cold tier only has them once the latency passed
+	driver.AddOrUpdateAsync(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0002-0000-000000000001", 10));
+	driver.RemoveAsync(EDF_Test_TieredDbDriverEntity, "TEST0000-0000-0002-0000-000000000002");
+	driver.AddOrUpdateAsync(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0002-0000-000000000003", 3));
+
+	// Act
+	EDF_DbFindResultMultiple<EDF_DbEntity> findResults = driver.FindAll(EDF_Test_TieredDbDriverEntity, EDF_DbFind.Field("m_iValue").GreaterThanOrEquals(3));
+	EDF_DbCountResult countResult = driver.Count(EDF_Test_TieredDbDriverEntity);
+	EDF_DbExistsResult removedResult = driver.Exists(EDF_Test_TieredDbDriverEntity, EDF_DbFind.Id().Equals("TEST0000-0000-0002-0000-000000000002"));
+	EDF_DbFindResultSingle<EDF_DbEntity> removedById = driver.FindById(EDF_Test_TieredDbDriverEntity, "TEST0000-0000-0002-0000-000000000002");
+
+	// Assert
+	int valueSum;
+	foreach (EDF_DbEntity entity : findResults.GetEntities())
+	{
+		valueSum += EDF_Test_TieredDbDriverEntity.Cast(entity).m_iValue;
+	}
+
+	return new EDF_TestResult(
+		findResults.IsSuccess() &&
+		findResults.GetEntities().Count() == 2 &&
+		valueSum == 13 &&
+		countResult.GetCount() == 2 &&
+		!removedResult.Exists() &&
+		removedById.IsSuccess() &&
+		!removedById.GetEntity());
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_TieredDbDriverTests")]
+TestResultBase EDF_Test_TieredDbDriver_Aggregate_PendingAsyncWritesLimited_OverlaidBeforeLimit()
+{
+	// Arrange
+	EDF_TieredDbConnectionInfo connectInfo();
+	connectInfo.m_sDatabaseName = "TieredPendingLimitTesting";
+	connectInfo.m_pColdStorage = EDF_DbConnectionInfoBase.Parse("Latency://TieredPendingLimitTesting?inner=InMemory&latency=60000");
+
+	EDF_TieredDbDriver driver();
+	driver.Initialize(connectInfo);
+
+	driver.AddOrUpdate(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0003-0000-000000000001", 7));
+	driver.AddOrUpdate(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0003-0000-000000000002", 8));
+	driver.RemoveWhereAsync(EDF_Test_TieredDbDriverEntity, EDF_DbFind.Field("m_iValue").GreaterThan(7));
+	driver.AddOrUpdateAsync(EDF_Test_TieredDbDriverEntity.Create("TEST0000-0000-0003-0000-000000000003", 20));
+
+	// Act
+	EDF_DbFindResultMultiple<EDF_DbEntity> topResults = driver.FindAll(EDF_Test_TieredDbDriverEntity, orderBy: {{"m_iValue", EDF_EDbEntitySortDirection.DESCENDING}}, limit: 1);
+	EDF_DbAggregateResult sumResult = driver.Aggregate(EDF_Test_TieredDbDriverEntity, EDF_DbAggregation.Create().Sum("m_iValue", "sum"));
+
+	// Assert
+	return new EDF_TestResult(
+		topResults.GetEntities().Count() == 1 &&
+		EDF_Test_TieredDbDriverEntity.Cast(topResults.GetEntities().Get(0)).m_iValue == 20 &&
+		sumResult.IsSuccess() &&
+		sumResult.GetGroups().Count() == 1 &&
+		float.AlmostEqual(sumResult.GetGroups().Get(0).Get("sum"), 27));
+};
@@ -0,0 +1,60 @@
+class EDF_WebProxyDbDriverIdLookupTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_WebProxyDbDriverFindCallback : EDF_DbFindCallbackBase
+{
+	EDF_EDbOperationStatusCode m_eStatusCode;
+	ref array<ref EDF_DbEntity> m_aResults;
+
+	//------------------------------------------------------------------------------------------------
+	override void Invoke(EDF_EDbOperationStatusCode code, array<ref EDF_DbEntity> findResults)
+	{
+		m_eStatusCode = code;
+		m_aResults = findResults;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverIdLookupTests")]
+TestResultBase EDF_Test_WebProxyDbDriverIdLookupBatch_Complete_OverlappingLookups_ResultsPerLookup()
+{
+	// Arrange
+	EDF_Test_WebProxyDbDriverEntityA entity1();
+	entity1.SetId("00000000-0000-0046-0000-000000000001");
+	EDF_Test_WebProxyDbDriverEntityA entity2();
+	entity2.SetId("00000000-0000-0046-0000-000000000002");
+
+	EDF_WebProxyDbDriverIdLookupBatch batch(EDF_Test_WebProxyDbDriverEntityA);
+	EDF_Test_WebProxyDbDriverFindCallback single();
+	EDF_Test_WebProxyDbDriverFindCallback multiple();
+	batch.Add({entity1.GetId()}, single);
+	batch.Add({entity2.GetId(), "00000000-0000-0046-0000-000000000003", entity1.GetId()}, multiple);
+
+	// Act
+	array<string> sentIds = batch.GetEntityIds();
+	batch.Complete(EDF_EDbOperationStatusCode.SUCCESS, {entity1, entity2});
+
+	// Assert
+	return new EDF_TestResult(
+		sentIds.Count() == 3 &&
+		single.m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		single.m_aResults.Count() == 1 &&
+		single.m_aResults.Get(0) == entity1 &&
+		multiple.m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		multiple.m_aResults.Count() == 2 &&
+		multiple.m_aResults.Get(0) == entity2 &&
+		multiple.m_aResults.Get(1) != entity1 &&
+		multiple.m_aResults.Get(1).GetId() == entity1.GetId());
+};
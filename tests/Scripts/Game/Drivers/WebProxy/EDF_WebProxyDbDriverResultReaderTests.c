@@ -0,0 +1,59 @@
+class EDF_WebProxyDbDriverResultReaderTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverResultReaderTests")]
+TestResultBase EDF_Test_WebProxyDbDriverResultReader_Read_BudgetOfTwo_ReadInChunks()
+{
+	// Arrange
+	string data = "[\n";
+	data += "{\"m_sId\": \"00000000-0000-0048-0000-000000000001\", \"m_fFloatValue\": 1}\n";
+	data += "{\"m_sId\": \"00000000-0000-0048-0000-000000000002\", \"m_fFloatValue\": 2}\n";
+	data += "{\"m_sId\": \"00000000-0000-0048-0000-000000000003\", \"m_fFloatValue\": 3}\n";
+	data += "]\n";
+	EDF_WebProxyDbDriverResultReader reader(data, EDF_Test_WebProxyDbDriverEntityA);
+
+	// Act
+	array<ref EDF_DbEntity> firstChunk();
+	bool firstRead = reader.Read(firstChunk, 2);
+	bool finishedAfterFirst = reader.IsFinished();
+
+	array<ref EDF_DbEntity> secondChunk();
+	bool secondRead = reader.Read(secondChunk, 2);
+
+	// Assert
+	return new EDF_TestResult(
+		firstRead && secondRead &&
+		!finishedAfterFirst && reader.IsFinished() &&
+		firstChunk.Count() == 2 &&
+		secondChunk.Count() == 1 &&
+		EDF_Test_WebProxyDbDriverEntityA.Cast(secondChunk.Get(0)).m_fFloatValue == 3 &&
+		secondChunk.Get(0).GetId() == "00000000-0000-0048-0000-000000000003");
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverResultReaderTests")]
+TestResultBase EDF_Test_WebProxyDbDriverResultReader_Read_NoEntities_FinishedEmpty()
+{
+	// Arrange
+	EDF_WebProxyDbDriverResultReader reader("[\n]", EDF_Test_WebProxyDbDriverEntityA);
+
+	// Act
+	array<ref EDF_DbEntity> results();
+	bool read = reader.Read(results);
+
+	// Assert
+	return new EDF_TestResult(read && reader.IsFinished() && results.IsEmpty());
+};
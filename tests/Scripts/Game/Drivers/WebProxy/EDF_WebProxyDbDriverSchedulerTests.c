@@ -0,0 +1,36 @@
+class EDF_WebProxyDbDriverSchedulerTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverSchedulerTests")]
+TestResultBase EDF_Test_WebProxyDbDriverPriorityQueue_Dequeue_MultipleTypes_TypesTakeTurnsInOrder()
+{
+	// Arrange
+	EDF_WebProxyDbDriverPriorityQueue queue();
+	queue.Enqueue(new EDF_WebProxyDbDriverRequest(EDF_EDbRequestPriority.BACKGROUND, EDF_Test_WebProxyDbDriverEntityA, "PUT", "A1", string.Empty, null));
+	queue.Enqueue(new EDF_WebProxyDbDriverRequest(EDF_EDbRequestPriority.BACKGROUND, EDF_Test_WebProxyDbDriverEntityA, "PUT", "A2", string.Empty, null));
+	queue.Enqueue(new EDF_WebProxyDbDriverRequest(EDF_EDbRequestPriority.BACKGROUND, EDF_Test_WebProxyDbDriverEntityA, "PUT", "A3", string.Empty, null));
+	queue.Enqueue(new EDF_WebProxyDbDriverRequest(EDF_EDbRequestPriority.BACKGROUND, EDF_Test_WebProxyDbDriverEntityB, "PUT", "B1", string.Empty, null));
+
+	// Act
+	string order;
+	while (queue.Count() > 0)
+	{
+		order += queue.Dequeue().m_sUrl;
+	}
+
+	// Assert
+	return new EDF_TestResult(order == "A1B1A2A3" && !queue.Dequeue());
+};
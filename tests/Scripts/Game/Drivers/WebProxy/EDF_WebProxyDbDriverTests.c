@@ -32,6 +32,21 @@ class EDF_Test_WebProxyDbDriver_TestBase : TestBase
 		m_pDriver = new EDF_WebProxyDbDriver();
 		m_pDriver.Initialize(connectInfo);
 	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Occupy the only request slot with a write of another type, so the async requests made afterwards wait in the scheduler
+	protected void OccupyOnlySlot(string blockerId)
+	{
+		EDF_WebProxyConnectionInfoBase connectInfo();
+		connectInfo.m_sDatabaseName = "WebProxyDbDriverTests";
+		connectInfo.m_sProxyHost = "localhost";
+		connectInfo.m_iProxyPort = 8008;
+		connectInfo.m_iMaxInFlight = 1;
+
+		m_pDriver = new EDF_WebProxyDbDriver();
+		m_pDriver.Initialize(connectInfo);
+		m_pDriver.AddOrUpdateAsync(EDF_Test_WebProxyDbDriverEntityB.Create(blockerId));
+	}
 }
 
 class EDF_Test_WebProxyDbDriverEntityA : EDF_DbEntity
@@ -1183,3 +1198,117 @@ class EDF_Test_WebProxyDbDriver_FindAllAsync_ObjectArrayTypenameCheck_Matches :
 		PrintFormat("%1 OnResult: %2", ClassName(), matches == 1);
 	}
 }
+
+[Test("EDF_WebProxyDbDriverTests")]
+class EDF_Test_WebProxyDbDriver_FindAll_WaitingAsyncWrite_Returned : EDF_Test_WebProxyDbDriver_TestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Act()
+	{
+		// Arrange
+		OccupyOnlySlot("00000000-0000-0019-0000-000000000001");
+		m_pDriver.AddOrUpdateAsync(EDF_Test_WebProxyDbDriverEntityA.Create("00000000-0000-0019-0000-000000000002", 19.5, "FindAllSync"));
+
+		// Act
+		EDF_DbFindResultMultiple<EDF_DbEntity> result = m_pDriver.FindAll(EDF_Test_WebProxyDbDriverEntityA, EDF_DbFind.Id().Equals("00000000-0000-0019-0000-000000000002"));
+
+		// Assert
+		SetResult(new EDF_TestResult(
+			result.IsSuccess() &&
+			result.GetEntities().Count() == 1 &&
+			EDF_Test_WebProxyDbDriverEntityA.Cast(result.GetEntities().Get(0)).m_sStringValue == "FindAllSync" &&
+			m_pDriver.GetScheduler().GetQueuedCount() == 0));
+	}
+}
+
+[Test("EDF_WebProxyDbDriverTests")]
+class EDF_Test_WebProxyDbDriver_Count_WaitingAsyncWrites_Counted : EDF_Test_WebProxyDbDriver_TestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Act()
+	{
+		// Arrange
+		OccupyOnlySlot("00000000-0000-0020-0000-000000000001");
+		m_pDriver.AddOrUpdateAsync(EDF_Test_WebProxyDbDriverEntityA.Create("00000000-0000-0020-0000-000000000002", 1, "CountSync"));
+		m_pDriver.AddOrUpdateAsync(EDF_Test_WebProxyDbDriverEntityA.Create("00000000-0000-0020-0000-000000000003", 2, "CountSync"));
+
+		// Act
+		EDF_DbCountResult result = m_pDriver.Count(EDF_Test_WebProxyDbDriverEntityA, EDF_DbFind.Field("m_sStringValue").Equals("CountSync"));
+
+		// Assert
+		SetResult(new EDF_TestResult(result.IsSuccess() && result.GetCount() == 2));
+	}
+}
+
+[Test("EDF_WebProxyDbDriverTests")]
+class EDF_Test_WebProxyDbDriver_Exists_WaitingAsyncRemove_NotFound : EDF_Test_WebProxyDbDriver_TestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Act()
+	{
+		// Arrange
+		m_pDriver.AddOrUpdate(EDF_Test_WebProxyDbDriverEntityA.Create("00000000-0000-0021-0000-000000000002", 1, "ExistsSync"));
+		OccupyOnlySlot("00000000-0000-0021-0000-000000000001");
+		m_pDriver.RemoveAsync(EDF_Test_WebProxyDbDriverEntityA, "00000000-0000-0021-0000-000000000002");
+
+		// Act
+		EDF_DbExistsResult result = m_pDriver.Exists(EDF_Test_WebProxyDbDriverEntityA, EDF_DbFind.Id().Equals("00000000-0000-0021-0000-000000000002"));
+
+		// Assert
+		SetResult(new EDF_TestResult(result.IsSuccess() && !result.Exists()));
+	}
+}
+
+[Test("EDF_WebProxyDbDriverTests")]
+class EDF_Test_WebProxyDbDriver_Aggregate_WaitingAsyncWrites_Aggregated : EDF_Test_WebProxyDbDriver_TestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Act()
+	{
+		// Arrange
+		OccupyOnlySlot("00000000-0000-0022-0000-000000000001");
+		m_pDriver.AddOrUpdateAsync(EDF_Test_WebProxyDbDriverEntityA.Create("00000000-0000-0022-0000-000000000002", 1.5, "AggregateSync"));
+		m_pDriver.AddOrUpdateAsync(EDF_Test_WebProxyDbDriverEntityA.Create("00000000-0000-0022-0000-000000000003", 2.5, "AggregateSync"));
+		EDF_DbAggregation aggregation = EDF_DbAggregation.Create().GroupBy("m_sStringValue").Count().Sum("m_fFloatValue", "sum");
+
+		// Act
+		EDF_DbAggregateResult result = m_pDriver.Aggregate(EDF_Test_WebProxyDbDriverEntityA, aggregation, EDF_DbFind.Field("m_sStringValue").Equals("AggregateSync"));
+
+		// Assert
+		if (!result.IsSuccess())
+		{
+			SetResult(new EDF_TestResult(false));
+			return;
+		}
+
+		EDF_DbAggregateGroup group = result.GetGroup("AggregateSync");
+		SetResult(new EDF_TestResult(group && group.Get("count") == 2 && float.AlmostEqual(group.Get("sum"), 4.0)));
+	}
+}
+
+[Test("EDF_WebProxyDbDriverTests")]
+class EDF_Test_WebProxyDbDriver_Patch_ConditionOnWaitingAsyncWrite_MatchedOnce : EDF_Test_WebProxyDbDriver_TestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Act()
+	{
+		// Arrange
+		OccupyOnlySlot("00000000-0000-0023-0000-000000000001");
+		m_pDriver.AddOrUpdateAsync(EDF_Test_WebProxyDbDriverEntityA.Create("00000000-0000-0023-0000-000000000002", 1, "PatchSync"));
+		EDF_DbFindCondition condition = EDF_DbFind.Field("m_sStringValue").Equals("PatchSync");
+
+		// Act
+		EDF_EDbOperationStatusCode matchedStatusCode = m_pDriver.Patch(EDF_Test_WebProxyDbDriverEntityA, "00000000-0000-0023-0000-000000000002", EDF_DbPatch.Create().Set("m_sStringValue", "Patched"), condition);
+		EDF_EDbOperationStatusCode notMatchedStatusCode = m_pDriver.Patch(EDF_Test_WebProxyDbDriverEntityA, "00000000-0000-0023-0000-000000000002", EDF_DbPatch.Create().Set("m_sStringValue", "Ignored"), condition);
+
+		// Assert
+		SetResult(new EDF_TestResult(
+			matchedStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+			notMatchedStatusCode == EDF_EDbOperationStatusCode.FAILURE_CONDITION_NOT_MET));
+	}
+}
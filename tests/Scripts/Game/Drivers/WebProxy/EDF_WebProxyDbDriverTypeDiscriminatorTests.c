@@ -0,0 +1,51 @@
+class EDF_WebProxyDbDriverTypeDiscriminatorTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverTypeDiscriminatorTests")]
+TestResultBase EDF_Test_WebProxyDbDriverTypeDiscriminator_MoveIn_NestedAndEscaped_OnlyMembersMoved()
+{
+	// Arrange
+	string data = "{\"_type\":\"Root\",\"_id\":\"x\",\"m_aItems\":[{\"_type\":\"A\",\"m_pItem\":{\"m_sNote\":\"say \\\"_type\\\":\\\"Fake\\\", {[\",";
+	data += "\"_type\":\"B\",\"m_pAttachment\":{\"m_iSlot\":1},\"m_sPath\":\"C:\\\\\"}},{\"_type\":\"C\",\"m_pEmpty\":{}}]}";
+
+	string expected = "{\"_type\":\"Root\",\"_id\":\"x\",\"m_aItems\":[{\"m_pItem\":{\"_type\":\"A\",\"m_sNote\":\"say \\\"_type\\\":\\\"Fake\\\", {[\",";
+	expected += "\"m_pAttachment\":{\"_type\":\"B\",\"m_iSlot\":1},\"m_sPath\":\"C:\\\\\"}},{\"m_pEmpty\":{\"_type\":\"C\"}}]}";
+
+	// Act
+	string movedIn = EDF_WebProxyDbDriver.MoveTypeDiscriminatorIn(data);
+
+	// Assert
+	return new EDF_TestResult(movedIn == expected);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverTypeDiscriminatorTests")]
+TestResultBase EDF_Test_WebProxyDbDriverTypeDiscriminator_MoveOut_MovedIn_RoundTrips()
+{
+	// Arrange
+	string data = "{\"_type\":\"Root\",\"_id\":\"x\",\"m_sText\":\"\\\"_type\\\":\\\"Fake\\\",\",\"_type\":\"D\",\"m_pLast\":{\"v\":{}}}";
+
+	// Act
+	string movedIn = EDF_WebProxyDbDriver.MoveTypeDiscriminatorIn(data);
+	string movedOut = EDF_WebProxyDbDriver.MoveTypeDiscriminatorOut(movedIn);
+	string lastMemberOut = EDF_WebProxyDbDriver.MoveTypeDiscriminatorOut("{\"a\":{\"x\":1,\"_type\":\"T\"}}");
+
+	// Assert
+	return new EDF_TestResult(
+		movedIn == "{\"_type\":\"Root\",\"_id\":\"x\",\"m_sText\":\"\\\"_type\\\":\\\"Fake\\\",\",\"m_pLast\":{\"_type\":\"D\",\"v\":{}}}" &&
+		movedOut == data &&
+		lastMemberOut == "{\"_type\":\"T\",\"a\":{\"x\":1}}");
+};
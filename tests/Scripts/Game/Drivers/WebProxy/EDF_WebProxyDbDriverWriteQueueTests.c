@@ -0,0 +1,162 @@
+class EDF_WebProxyDbDriverWriteQueueTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+};
+
+class EDF_Test_WebProxyDbDriverStatusCallback : EDF_DbOperationStatusOnlyCallback
+{
+	bool m_bInvoked;
+	EDF_EDbOperationStatusCode m_eStatusCode;
+
+	//------------------------------------------------------------------------------------------------
+	override void OnSuccess(Managed context)
+	{
+		m_bInvoked = true;
+		m_eStatusCode = EDF_EDbOperationStatusCode.SUCCESS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnFailure(EDF_EDbOperationStatusCode statusCode, Managed context)
+	{
+		m_bInvoked = true;
+		m_eStatusCode = statusCode;
+	}
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverWriteQueueTests")]
+TestResultBase EDF_Test_WebProxyDbDriverWriteBatchCallback_OnResponse_OneFailed_StatusPerWrite()
+{
+	// Arrange
+	EDF_WebProxyDbDriverWriteQueue queue(EDF_Test_WebProxyDbDriverEntityA);
+	EDF_Test_WebProxyDbDriverStatusCallback replacedSave();
+	EDF_Test_WebProxyDbDriverStatusCallback save();
+	EDF_Test_WebProxyDbDriverStatusCallback removal();
+	queue.Enqueue("00000000-0000-0045-0000-000000000001", "{\"m_fFloatValue\":1}", replacedSave);
+	queue.Enqueue("00000000-0000-0045-0000-000000000001", "{\"m_fFloatValue\":2}", save);
+	queue.Enqueue("00000000-0000-0045-0000-000000000002", string.Empty, removal);
+
+	array<ref EDF_WebProxyDbDriverQueuedWrite> batch = queue.TakeBatch(10);
+	string body = EDF_WebProxyDbDriverBulkWriteRequest.Build(batch);
+	EDF_WebProxyDbDriverWriteBatchCallback batchCallback(null, queue, batch);
+
+	// Act
+	batchCallback.OnResponse("{\"failed\": [{\"id\": \"00000000-0000-0045-0000-000000000002\", \"status\": \"notfound\"}]}");
+
+	// Assert
+	return new EDF_TestResult(
+		batch.Count() == 2 &&
+		body.Contains("\"entity\":{\"m_fFloatValue\":2}") &&
+		!body.Contains("\"m_fFloatValue\":1") &&
+		replacedSave.m_bInvoked && replacedSave.m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		save.m_bInvoked && save.m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		removal.m_bInvoked && removal.m_eStatusCode == EDF_EDbOperationStatusCode.FAILURE_ID_NOT_FOUND &&
+		queue.GetPendingCount() == 0);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverWriteQueueTests")]
+TestResultBase EDF_Test_WebProxyDbDriverWriteQueue_TakeBatch_IncludeInFlight_TakenAndReleasedPerBatch()
+{
+	// Arrange
+	EDF_WebProxyDbDriverWriteQueue queue(EDF_Test_WebProxyDbDriverEntityA);
+	queue.Enqueue("00000000-0000-0045-0000-000000000011", "{\"m_fFloatValue\":1}", null);
+	array<ref EDF_WebProxyDbDriverQueuedWrite> first = queue.TakeBatch(10);
+	queue.Enqueue("00000000-0000-0045-0000-000000000011", "{\"m_fFloatValue\":2}", null);
+
+	// Act
+	array<ref EDF_WebProxyDbDriverQueuedWrite> skipped = queue.TakeBatch(10);
+	array<ref EDF_WebProxyDbDriverQueuedWrite> second = queue.TakeBatch(10, true);
+	queue.Complete(first, EDF_EDbOperationStatusCode.SUCCESS);
+	int pendingAfterFirst = queue.GetPendingCount();
+	queue.Complete(second, EDF_EDbOperationStatusCode.SUCCESS);
+
+	// Assert
+	return new EDF_TestResult(
+		skipped.IsEmpty() &&
+		second.Count() == 1 &&
+		second.Get(0).m_sData == "{\"m_fFloatValue\":2}" &&
+		pendingAfterFirst == 1 &&
+		queue.GetPendingCount() == 0);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverWriteQueueTests")]
+TestResultBase EDF_Test_WebProxyDbDriverWriteQueue_TakeBatch_IdInFlight_SkippedUntilCompleted()
+{
+	// Arrange
+	EDF_WebProxyDbDriverWriteQueue queue(EDF_Test_WebProxyDbDriverEntityA);
+	EDF_Test_WebProxyDbDriverStatusCallback firstSave();
+	EDF_Test_WebProxyDbDriverStatusCallback secondSave();
+	EDF_Test_WebProxyDbDriverStatusCallback otherSave();
+	queue.Enqueue("00000000-0000-0035-0000-000000000001", "{\"m_fFloatValue\":1}", firstSave);
+	array<ref EDF_WebProxyDbDriverQueuedWrite> first = queue.TakeBatch(10);
+	queue.Enqueue("00000000-0000-0035-0000-000000000001", "{\"m_fFloatValue\":2}", secondSave);
+	queue.Enqueue("00000000-0000-0035-0000-000000000002", "{\"m_fFloatValue\":3}", otherSave);
+
+	// Act
+	array<ref EDF_WebProxyDbDriverQueuedWrite> whileInFlight = queue.TakeBatch(10);
+	queue.Complete(first, EDF_EDbOperationStatusCode.SUCCESS);
+	bool secondInvokedEarly = secondSave.m_bInvoked;
+	array<ref EDF_WebProxyDbDriverQueuedWrite> afterCompleted = queue.TakeBatch(10);
+	queue.Complete(whileInFlight, EDF_EDbOperationStatusCode.SUCCESS);
+	queue.Complete(afterCompleted, EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE);
+
+	// Assert
+	return new EDF_TestResult(
+		whileInFlight.Count() == 1 &&
+		whileInFlight.Get(0).m_sEntityId == "00000000-0000-0035-0000-000000000002" &&
+		afterCompleted.Count() == 1 &&
+		afterCompleted.Get(0).m_sData == "{\"m_fFloatValue\":2}" &&
+		firstSave.m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		!secondInvokedEarly &&
+		secondSave.m_eStatusCode == EDF_EDbOperationStatusCode.FAILURE_DB_UNAVAILABLE &&
+		otherSave.m_eStatusCode == EDF_EDbOperationStatusCode.SUCCESS &&
+		queue.GetPendingCount() == 0 &&
+		queue.m_iInFlightBatches == 0);
+};
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_WebProxyDbDriverWriteQueueTests")]
+TestResultBase EDF_Test_WebProxyDbDriverWriteQueue_Block_WhileIdInFlight_PendingUntilTaken()
+{
+	// Arrange
+	EDF_WebProxyDbDriverWriteQueue queue(EDF_Test_WebProxyDbDriverEntityA);
+	queue.Enqueue("00000000-0000-0045-0000-000000000021", "{\"m_fFloatValue\":1}", null);
+	array<ref EDF_WebProxyDbDriverQueuedWrite> first = queue.TakeBatch(10);
+	queue.Enqueue("00000000-0000-0045-0000-000000000021", string.Empty, null);
+	EDF_WebProxyDbDriverRequest read(EDF_EDbRequestPriority.INTERACTIVE, EDF_Test_WebProxyDbDriverEntityA, "POST", "first", string.Empty, null);
+	EDF_WebProxyDbDriverRequest write(EDF_EDbRequestPriority.BACKGROUND, EDF_Test_WebProxyDbDriverEntityA, "PUT", "second", string.Empty, null);
+
+	// Act
+	array<ref EDF_WebProxyDbDriverQueuedWrite> whileInFlight = queue.TakeBatch(10);
+	queue.Block(read);
+	queue.Block(write);
+	int pendingBlocked = queue.GetPendingCount();
+	queue.Complete(first, EDF_EDbOperationStatusCode.SUCCESS);
+	array<ref EDF_WebProxyDbDriverQueuedWrite> afterCompleted = queue.TakeBatch(10);
+	array<ref EDF_WebProxyDbDriverRequest> blocked();
+	queue.TakeBlockedRequests(blocked);
+	queue.Complete(afterCompleted, EDF_EDbOperationStatusCode.SUCCESS);
+
+	// Assert
+	return new EDF_TestResult(
+		whileInFlight.IsEmpty() &&
+		pendingBlocked == 4 &&
+		afterCompleted.Count() == 1 &&
+		blocked.Count() == 2 &&
+		blocked.Get(0) == read &&
+		blocked.Get(1) == write &&
+		!queue.HasBlockedRequests() &&
+		queue.GetPendingCount() == 0);
+};
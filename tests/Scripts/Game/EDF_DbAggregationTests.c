@@ -0,0 +1,79 @@
+class EDF_DbAggregationTests : TestSuite
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Setup)]
+	void Setup()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.TearDown)]
+	void TearDown()
+	{
+	}
+}
+
+class EDF_Test_DbAggregationNestedBase
+{
+}
+
+class EDF_Test_DbAggregationNestedDerived : EDF_Test_DbAggregationNestedBase
+{
+	int m_iExtra;
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_Test_DbAggregationNestedDerived(int extra = 0)
+	{
+		m_iExtra = extra;
+	}
+}
+
+class EDF_Test_DbAggregationEntity : EDF_DbEntity
+{
+	ref EDF_Test_DbAggregationNestedBase m_pNested;
+
+	//------------------------------------------------------------------------------------------------
+	void EDF_Test_DbAggregationEntity(EDF_Test_DbAggregationNestedBase nested = null)
+	{
+		m_pNested = nested;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbAggregationTests")]
+TestResultBase EDF_Test_DbAggregator_SubclassOnlyNestedField_ReadFromRuntimeType()
+{
+	// Arrange
+	EDF_DbAggregation aggregation = EDF_DbAggregation.Create().Count().Sum("m_pNested.m_iExtra", "sum");
+	EDF_DbAggregator aggregator(aggregation);
+
+	// Act
+	EDF_EDbOperationStatusCode statusCode = aggregator.Validate(EDF_Test_DbAggregationEntity);
+	aggregator.Accumulate(new EDF_Test_DbAggregationEntity(new EDF_Test_DbAggregationNestedDerived(5)));
+	aggregator.Accumulate(new EDF_Test_DbAggregationEntity(new EDF_Test_DbAggregationNestedBase()));
+	aggregator.Accumulate(new EDF_Test_DbAggregationEntity());
+	array<ref EDF_DbAggregateGroup> results = aggregator.GetResults();
+
+	// Assert
+	if (statusCode != EDF_EDbOperationStatusCode.SUCCESS || results.Count() != 1)
+		return new EDF_TestResult(false);
+
+	EDF_DbAggregateGroup group = results.Get(0);
+	return new EDF_TestResult(
+		group.Get("count") == 3 &&
+		float.AlmostEqual(group.Get("sum"), 5.0));
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbAggregationTests")]
+TestResultBase EDF_Test_DbAggregator_UnknownRootField_DataMalformed()
+{
+	// Arrange
+	EDF_DbAggregator aggregator(EDF_DbAggregation.Create().Sum("m_iMissing"));
+
+	// Act
+	EDF_EDbOperationStatusCode statusCode = aggregator.Validate(EDF_Test_DbAggregationEntity);
+
+	// Assert
+	return new EDF_TestResult(statusCode == EDF_EDbOperationStatusCode.FAILURE_DATA_MALFORMED);
+}
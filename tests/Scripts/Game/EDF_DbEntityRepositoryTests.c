@@ -84,3 +84,31 @@ TestResultBase EDF_Test_DbEntityRepository_Remove_ByInstance_Removed()
 
 	return result;
 };
+
+//------------------------------------------------------------------------------------------------
+[Test("EDF_DbRepositoryTests")]
+TestResultBase EDF_Test_DbEntityRepository_FindByIds_MixedIds_InputOrder()
+{
+	// Arrange
+	EDF_DbRepository<EDF_Test_DbEntityRepositoryEntity> repository = EDF_DbEntityHelper<EDF_Test_DbEntityRepositoryEntity>.GetRepository(EDF_DbRepositoryTests.m_pDbContext);
+
+	repository.AddOrUpdate(new EDF_Test_DbEntityRepositoryEntity("TEST0000-0000-0001-0000-000000000003", 1003));
+	repository.AddOrUpdate(new EDF_Test_DbEntityRepositoryEntity("TEST0000-0000-0001-0000-000000000004", 1004));
+
+	// Act
+	array<ref EDF_Test_DbEntityRepositoryEntity> results = repository.Find({
+		"TEST0000-0000-0001-0000-000000000004",
+		"TEST0000-0000-0001-0000-000000000099",
+		"TEST0000-0000-0001-0000-000000000003"}).GetEntities();
+
+	// Assert
+	EDF_TestResult result(
+		results.Count() == 2 &&
+		results.Get(0).m_iIntValue == 1004 &&
+		results.Get(1).m_iIntValue == 1003);
+
+	// Cleanup
+	repository.RemoveMany({"TEST0000-0000-0001-0000-000000000003", "TEST0000-0000-0001-0000-000000000004"});
+
+	return result;
+};
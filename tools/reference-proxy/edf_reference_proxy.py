@@ -0,0 +1,565 @@
+#!/usr/bin/env python3
+"""Local stand-in for the web proxy of EDF_WebProxyDbDriver (Mongo://...).
+
+Speaks the proxy protocol documented in docs/drivers/proxy-mongodb.md and keeps
+the entities in memory, or in one json lines file per entity type with --data.
+Meant for running the proxy driver tests and benchmarks offline, not for
+production use. Only the python standard library is required.
+
+    python3 tools/reference-proxy/edf_reference_proxy.py --port 8008 [--data ./proxy-data]
+"""
+
+import argparse
+import json
+import os
+import re
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import unquote, urlsplit
+
+# EDF_EDbFindOperator
+EQUAL, NOT_EQUAL, LESS_THAN, LESS_THAN_OR_EQUAL, GREATER_THAN, GREATER_THAN_OR_EQUAL, CONTAINS, NOT_CONTAINS, CONTAINS_ALL, NOT_CONTAINS_ALL = range(10)
+
+# EDF_EDbAggregateOperator
+AGG_COUNT, AGG_SUM, AGG_MIN, AGG_MAX, AGG_AVG = range(5)
+
+NEGATED = {NOT_EQUAL: EQUAL, NOT_CONTAINS: CONTAINS, NOT_CONTAINS_ALL: CONTAINS_ALL}
+MODIFIERS = (":any", ":all", ":length", ":count", ":keys", ":values")
+
+
+class BadRequest(Exception):
+    pass
+
+
+class NotFound(Exception):
+    pass
+
+
+# ---------------------------------------------------------------------------------------------------
+# Storage
+
+
+class Store:
+    """Collections by (database, entity type) with entities by id in insertion order."""
+
+    def __init__(self, data_dir=None):
+        self.data_dir = data_dir
+        self.collections = {}
+        self.dirty = set()
+        self.lock = threading.RLock()
+
+    def collection(self, database, entity_type):
+        key = (database, entity_type)
+        collection = self.collections.get(key)
+        if collection is None:
+            collection = self.load(database, entity_type)
+            self.collections[key] = collection
+
+        return collection
+
+    def changed(self, database, entity_type):
+        if self.data_dir:
+            self.dirty.add((database, entity_type))
+
+    def path(self, database, entity_type):
+        return os.path.join(self.data_dir, database, entity_type + ".jsonl")
+
+    def load(self, database, entity_type):
+        collection = {}
+        if not self.data_dir:
+            return collection
+
+        path = self.path(database, entity_type)
+        if os.path.exists(path):
+            with open(path, encoding="utf-8") as handle:
+                for line in handle:
+                    line = line.strip()
+                    if line:
+                        entity = json.loads(line)
+                        collection[entity["m_sId"]] = entity
+
+        return collection
+
+    def save(self):
+        """Write the collections changed since the last save."""
+        with self.lock:
+            dirty, self.dirty = self.dirty, set()
+            snapshots = {key: list(self.collections[key].values()) for key in dirty}
+
+        for (database, entity_type), entities in snapshots.items():
+            path = self.path(database, entity_type)
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            with open(path + ".tmp", "w", encoding="utf-8") as handle:
+                for entity in entities:
+                    handle.write(dump(entity) + "\n")
+
+            os.replace(path + ".tmp", path)
+
+
+def dump(value):
+    return json.dumps(value, ensure_ascii=False, separators=(",", ":"))
+
+
+# ---------------------------------------------------------------------------------------------------
+# Conditions, see EDF_DbFindCondition and EDF_DbFindConditionEvaluator
+
+
+def parse_segment(segment):
+    modifiers = set()
+    while True:
+        for modifier in MODIFIERS:
+            if segment.endswith(modifier):
+                modifiers.add(modifier)
+                segment = segment[: -len(modifier)]
+                break
+        else:
+            return segment, modifiers
+
+
+def collection_items(value, modifiers):
+    if isinstance(value, list):
+        return value
+
+    if isinstance(value, dict):
+        if ":keys" in modifiers:
+            return list(value.keys())
+
+        return list(value.values())
+
+    return None
+
+
+def matches(condition, entity):
+    condition_type = condition.get("_type", "")
+    if condition_type == "DbFindAnd":
+        return all(matches(child, entity) for child in condition.get("conditions", []))
+
+    if condition_type == "DbFindOr":
+        return any(matches(child, entity) for child in condition.get("conditions", []))
+
+    segments = [parse_segment(segment) for segment in condition["fieldPath"].split(".")]
+    return evaluate_path(entity, segments, 0, condition)
+
+
+def evaluate_path(node, segments, index, condition):
+    name, modifiers = segments[index]
+    value = node.get(name) if isinstance(node, dict) else None
+
+    if index == len(segments) - 1:
+        return evaluate_field(value, modifiers, condition)
+
+    items = collection_items(value, modifiers)
+    if items is None:
+        return evaluate_path(value, segments, index + 1, condition) if isinstance(value, dict) else False
+
+    # collection.N access operator
+    next_name, next_modifiers = segments[index + 1]
+    if re.fullmatch(r"\d+(,\d+)*", next_name):
+        indices = [int(number) for number in next_name.split(",")]
+        items = [items[number] for number in indices if number < len(items)]
+        modifiers = modifiers | next_modifiers
+        index += 1
+        if index == len(segments) - 1:
+            return any(compare_value(item, condition) for item in items)
+
+    results = (evaluate_path(item, segments, index + 1, condition) for item in items)
+    if ":all" in modifiers:
+        return bool(items) and all(results)
+
+    return any(results)
+
+
+def is_null_or_default(value):
+    return value in (None, 0, 0.0, False, "", [], {}) or value == [0, 0, 0]
+
+
+def evaluate_field(value, modifiers, condition):
+    if condition.get("_type") == "DbFindCheckFieldNullOrDefault":
+        return is_null_or_default(value) == bool(condition.get("shouldBeNullOrDefault"))
+
+    if ":length" in modifiers and isinstance(value, str):
+        return compare_value(len(value), condition)
+
+    # Vectors are stored as [x, y, z] but compared as one value
+    value_type = value_type_of(condition)
+    items = collection_items(value, modifiers)
+    if items is None or value_type == "vector":
+        return compare_value(value, condition)
+
+    if ":count" in modifiers:
+        return compare_value(len(items), condition)
+
+    if ":length" in modifiers:
+        items = [len(item) for item in items if isinstance(item, str)]
+
+    operator = condition.get("comparisonOperator", EQUAL)
+    values = condition.get("comparisonValues", [])
+
+    # Whole array compared against arrays
+    if value_type.startswith("array<"):
+        equal = any(items == expected for expected in values)
+        return not equal if operator in NEGATED else equal
+
+    if operator in (CONTAINS_ALL, NOT_CONTAINS_ALL):
+        contained = all(any(equals(item, expected, condition) for item in items) for expected in values)
+        return contained if operator == CONTAINS_ALL else not contained
+
+    if operator in NEGATED:
+        return not any(compare_value(item, dict(condition, comparisonOperator=NEGATED[operator])) for item in items)
+
+    results = [compare_value(item, condition) for item in items]
+    if ":all" in modifiers:
+        return bool(results) and all(results)
+
+    return any(results)
+
+
+def value_type_of(condition):
+    # "DbFindCompareFieldValues<int>" -> "int"
+    condition_type = condition.get("_type", "")
+    start = condition_type.find("<")
+    return condition_type[start + 1:-1] if start != -1 else ""
+
+
+def equals(value, expected, condition):
+    if isinstance(value, str) and isinstance(expected, str):
+        if condition.get("stringsInvariant"):
+            value, expected = value.lower(), expected.lower()
+
+        if condition.get("stringsPartialMatches"):
+            return expected in value
+
+    return value == expected
+
+
+def compare_value(value, condition):
+    operator = condition.get("comparisonOperator", EQUAL)
+    values = condition.get("comparisonValues", [])
+
+    if operator in (EQUAL, CONTAINS, CONTAINS_ALL):
+        if operator == CONTAINS and isinstance(value, str):
+            condition = dict(condition, stringsPartialMatches=True)
+
+        return any(equals(value, expected, condition) for expected in values)
+
+    if operator in NEGATED:
+        return not compare_value(value, dict(condition, comparisonOperator=NEGATED[operator]))
+
+    if value is None:
+        return False
+
+    try:
+        if operator == LESS_THAN:
+            return any(value < expected for expected in values)
+
+        if operator == LESS_THAN_OR_EQUAL:
+            return any(value <= expected for expected in values)
+
+        if operator == GREATER_THAN:
+            return any(value > expected for expected in values)
+
+        if operator == GREATER_THAN_OR_EQUAL:
+            return any(value >= expected for expected in values)
+    except TypeError:
+        return False
+
+    raise BadRequest("Unknown comparison operator %s" % operator)
+
+
+def filtered(collection, condition):
+    if not condition:
+        return list(collection.values())
+
+    return [entity for entity in collection.values() if matches(condition, entity)]
+
+
+def bulk_write(collection, ops):
+    # Ops with an entity are saved, ops without one removed. Returns the ops that failed.
+    failed = []
+    for op in ops:
+        if "entity" in op:
+            collection[op["id"]] = op["entity"]
+        elif collection.pop(op["id"], None) is None:
+            failed.append({"id": op["id"], "status": "notfound"})
+
+    return failed
+
+
+# ---------------------------------------------------------------------------------------------------
+# Field paths of orderBy, aggregations and patches
+
+
+def read_path(entity, path):
+    value = entity
+    for segment in path.split("."):
+        if isinstance(value, dict):
+            value = value.get(segment)
+        elif isinstance(value, list) and segment.isdigit() and int(segment) < len(value):
+            value = value[int(segment)]
+        else:
+            return None
+
+    return value
+
+
+def write_path(entity, path, update):
+    segments = path.split(".")
+    holder = entity
+    for segment in segments[:-1]:
+        holder = holder.setdefault(segment, {})
+        if not isinstance(holder, dict):
+            raise BadRequest("Can not patch into non object field of %s" % path)
+
+    holder[segments[-1]] = update(holder.get(segments[-1]))
+
+
+def sort_key(value):
+    # None first, then numbers, then strings, then everything else
+    if value is None:
+        return (0, 0)
+
+    if isinstance(value, bool):
+        return (1, int(value))
+
+    if isinstance(value, (int, float)):
+        return (1, value)
+
+    if isinstance(value, str):
+        return (2, value)
+
+    return (3, dump(value))
+
+
+def ordered(entities, order_by):
+    for path, direction in reversed(order_by or []):
+        entities.sort(key=lambda entity: sort_key(read_path(entity, path)), reverse=direction.upper().startswith("DESC"))
+
+    return entities
+
+
+def format_key(value):
+    if value is None:
+        return ""
+
+    if isinstance(value, bool):
+        return "1" if value else "0"
+
+    if isinstance(value, float) and value.is_integer():
+        return str(int(value))
+
+    if isinstance(value, (int, float, str)):
+        return str(value)
+
+    return dump(value)
+
+
+def aggregate(entities, aggregation):
+    group_by = aggregation.get("groupBy")
+    fields = aggregation.get("fields", [])
+
+    groups = {}
+    for entity in entities:
+        key = format_key(read_path(entity, group_by)) if group_by else ""
+        groups.setdefault(key, []).append(entity)
+
+    results = []
+    for key, members in groups.items():
+        values = {}
+        for field in fields:
+            operator = field.get("operator", AGG_COUNT)
+            if operator == AGG_COUNT:
+                values[field["alias"]] = len(members)
+                continue
+
+            numbers = [read_path(entity, field.get("fieldPath", "")) for entity in members]
+            numbers = [number for number in numbers if isinstance(number, (int, float)) and not isinstance(number, bool)]
+            if operator == AGG_SUM:
+                values[field["alias"]] = sum(numbers)
+            elif not numbers:
+                values[field["alias"]] = 0
+            elif operator == AGG_MIN:
+                values[field["alias"]] = min(numbers)
+            elif operator == AGG_MAX:
+                values[field["alias"]] = max(numbers)
+            else:
+                values[field["alias"]] = sum(numbers) / len(numbers)
+
+        results.append({"key": key, "values": values})
+
+    return {"groups": results}
+
+
+# ---------------------------------------------------------------------------------------------------
+# Requests
+
+
+class ProxyHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    store = None
+    quiet = False
+
+    def do_GET(self):
+        self.handle_request("GET")
+
+    def do_PUT(self):
+        self.handle_request("PUT")
+
+    def do_POST(self):
+        self.handle_request("POST")
+
+    def do_DELETE(self):
+        self.handle_request("DELETE")
+
+    def handle_request(self, verb):
+        # /<database>/<type>[/<id>|/_bulk|/_delete|/_count|/_aggregate][?additional=params]
+        parts = [unquote(part) for part in urlsplit(self.path).path.split("/") if part]
+        length = int(self.headers.get("Content-Length") or 0)
+        body = self.rfile.read(length) if length else b""
+
+        try:
+            if len(parts) not in (2, 3):
+                raise NotFound()
+
+            data = json.loads(body) if body.strip() else {}
+            with self.store.lock:
+                response = self.dispatch(verb, parts[0], parts[1], parts[2] if len(parts) == 3 else None, data)
+
+            self.respond(200, response)
+        except NotFound:
+            self.respond(404, "")
+        except (BadRequest, ValueError, KeyError, TypeError) as error:
+            self.respond(400, str(error))
+
+    def dispatch(self, verb, database, entity_type, target, data):
+        collection = self.store.collection(database, entity_type)
+
+        if target is None:
+            if verb == "PUT":
+                # Same as a _bulk request with only saves
+                bulk_write(collection, [{"id": entity["m_sId"], "entity": entity} for entity in data.get("entities", [])])
+                self.store.changed(database, entity_type)
+                return ""
+
+            if verb == "POST":
+                entities = ordered(filtered(collection, data.get("condition")), data.get("orderBy"))
+                offset = max(data.get("offset", 0), 0)
+                limit = data.get("limit", -1)
+                entities = entities[offset:] if limit < 0 else entities[offset:offset + limit]
+
+                # Opening line, one entity per line, closing line
+                return "[\n" + "".join(dump(entity) + "\n" for entity in entities) + "]"
+
+        elif target == "_bulk" and verb == "POST":
+            failed = bulk_write(collection, data.get("ops", []))
+            self.store.changed(database, entity_type)
+            return dump({"failed": failed})
+
+        elif target == "_delete" and verb == "POST":
+            for entity in filtered(collection, data.get("condition")):
+                del collection[entity["m_sId"]]
+
+            self.store.changed(database, entity_type)
+            return ""
+
+        elif target == "_count" and verb == "POST":
+            count = len(filtered(collection, data.get("condition")))
+            limit = data.get("limit", -1)
+            return dump({"count": count if limit < 0 else min(count, limit)})
+
+        elif target == "_aggregate" and verb == "POST":
+            return dump(aggregate(filtered(collection, data.get("condition")), data.get("aggregation", {})))
+
+        elif verb == "GET":
+            entity = collection.get(target)
+            if entity is None:
+                raise NotFound()
+
+            return dump(entity)
+
+        elif verb == "PUT":
+            collection[target] = data
+            self.store.changed(database, entity_type)
+            return ""
+
+        elif verb == "DELETE":
+            if collection.pop(target, None) is None:
+                raise NotFound()
+
+            self.store.changed(database, entity_type)
+            return ""
+
+        elif verb == "POST":
+            return self.patch(database, entity_type, collection, target, data)
+
+        raise NotFound()
+
+    def patch(self, database, entity_type, collection, entity_id, data):
+        condition = data.get("condition")
+        entity = collection.get(entity_id)
+        if entity is None:
+            if condition:
+                return dump({"matched": False})
+
+            raise NotFound()
+
+        if condition and not matches(condition, entity):
+            return dump({"matched": False})
+
+        for path, value in data.get("$set", {}).items():
+            write_path(entity, path, lambda _, value=value: value)
+
+        for path, delta in data.get("$inc", {}).items():
+            write_path(entity, path, lambda current, delta=delta: (current or 0) + delta)
+
+        self.store.changed(database, entity_type)
+        return dump({"matched": True}) if condition else ""
+
+    def respond(self, status, text):
+        payload = text.encode("utf-8")
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json; charset=utf-8")
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+    def log_message(self, format, *args):
+        if not self.quiet:
+            super().log_message(format, *args)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="localhost", help="interface to listen on (default: localhost)")
+    parser.add_argument("--port", type=int, default=8008, help="port to listen on (default: 8008, the driver default)")
+    parser.add_argument("--data", help="directory to keep the entities in, in memory only if not set")
+    parser.add_argument("--save-interval", type=float, default=1.0, help="seconds between writes of changed collections (default: 1)")
+    parser.add_argument("--quiet", action="store_true", help="do not log every request, e.g. while benchmarking")
+    args = parser.parse_args()
+
+    ProxyHandler.store = Store(args.data)
+    ProxyHandler.quiet = args.quiet
+    server = ThreadingHTTPServer((args.host, args.port), ProxyHandler)
+    server.daemon_threads = True
+
+    if args.data:
+        def save_periodically():
+            while True:
+                time.sleep(args.save_interval)
+                ProxyHandler.store.save()
+
+        threading.Thread(target=save_periodically, daemon=True).start()
+
+    print("EDF reference proxy listening on http://%s:%d/ (%s)" % (args.host, args.port, args.data or "in memory"))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+        if args.data:
+            ProxyHandler.store.save()
+
+
+if __name__ == "__main__":
+    main()